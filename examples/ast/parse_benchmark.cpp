@@ -0,0 +1,96 @@
+//   Copyright (c) 2017 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+#include <hpx/hpx_main.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+// Generate a PhySL source consisting of the given number of function
+// definitions, each of them being a variation of the lra example.
+std::string generate_source(std::size_t count)
+{
+    std::stringstream strm;
+    strm << "block(\n";
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        strm << R"(
+    // function )" << i << R"(
+    define(f)" << i << R"(, x, y, alpha, iterations,
+        block(
+            define(weights, constant(0.0, shape(x, 1))),
+            define(transx, transpose(x)),
+            define(pred, constant(0.0, shape(x, 0))),
+            define(step, 0),
+            while(
+                step < iterations && !(alpha <= 1.0e-10),
+                block(
+                    store(pred, 1.0 / (1.0 + exp(-dot(x, weights)))),
+                    store(weights, weights - alpha * dot(transx, pred - y)),
+                    store(step, step + 1)
+                )
+            ),
+            '(weights, "f)" << i << R"(", )" << i << R"()
+        )
+    ),)";
+    }
+    strm << "\n    0\n)\n";
+    return strm.str();
+}
+
+template <typename F>
+double time_parser(F && parse, std::string const& source, std::size_t repeat)
+{
+    hpx::util::high_resolution_timer t;
+    for (std::size_t i = 0; i != repeat; ++i)
+    {
+        parse(source);
+    }
+    return t.elapsed() / repeat;
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t count = (argc > 1) ? std::atoi(argv[1]) : 10000;
+    std::size_t repeat = (argc > 2) ? std::atoi(argv[2]) : 5;
+
+    std::string source = generate_source(count);
+
+    // make sure both parsers agree before timing them
+    if (!(phylanx::ast::generate_asts(source) ==
+            phylanx::ast::generate_asts_spirit(source)))
+    {
+        std::cerr << "Error: the parsers generated different ASTs\n";
+        return -1;
+    }
+
+    double spirit = time_parser(&phylanx::ast::generate_asts_spirit,
+        source, repeat);
+    double recursive_descent = time_parser(
+        [](std::string const& s) { return phylanx::ast::generate_asts(s); },
+        source, repeat);
+    double arena = time_parser(
+        [](std::string const& s)
+        {
+            phylanx::util::arena arena;
+            return phylanx::ast::generate_asts(s, arena);
+        },
+        source, repeat);
+
+    std::cout << "source size:       " << source.size() << " bytes\n"
+              << "spirit:            " << spirit << " s\n"
+              << "recursive descent: " << recursive_descent << " s\n"
+              << "with arena:        " << arena << " s\n"
+              << "speedup:           " << spirit / recursive_descent
+              << " (" << spirit / arena << " with arena)" << std::endl;
+
+    return 0;
+}
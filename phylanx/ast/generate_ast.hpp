@@ -8,8 +8,10 @@
 
 #include <phylanx/config.hpp>
 #include <phylanx/ast/node.hpp>
+#include <phylanx/util/arena.hpp>
 
 #include <string>
+#include <vector>
 
 namespace phylanx { namespace ast
 {
@@ -19,6 +21,28 @@ namespace phylanx { namespace ast
     /// Parse the given string and convert it into a list of AST instances
     PHYLANX_EXPORT std::vector<ast::expression> generate_asts(
         std::string const& input);
+
+    /// Parse the given string and convert it into an instance of an AST,
+    /// the nodes of which are allocated from the given arena
+    PHYLANX_EXPORT ast::expression generate_ast(
+        std::string const& input, util::arena& arena);
+
+    /// Parse the given string and convert it into a list of AST instances,
+    /// the nodes of which are allocated from the given arena
+    PHYLANX_EXPORT std::vector<ast::expression> generate_asts(
+        std::string const& input, util::arena& arena);
+
+    /// Parse the given string using the Boost.Spirit based grammar (see
+    /// parser/expression_def.hpp). This generates the same AST as
+    /// \a generate_ast, which uses a hand-written parser instead.
+    PHYLANX_EXPORT ast::expression generate_ast_spirit(
+        std::string const& input);
+
+    /// Parse the given string using the Boost.Spirit based grammar (see
+    /// parser/expression_def.hpp). This generates the same ASTs as
+    /// \a generate_asts, which uses a hand-written parser instead.
+    PHYLANX_EXPORT std::vector<ast::expression> generate_asts_spirit(
+        std::string const& input);
 }}
 
 #endif
@@ -0,0 +1,29 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_AST_PARSER_RECURSIVE_DESCENT_DEC_20_2017_1033AM)
+#define PHYLANX_AST_PARSER_RECURSIVE_DESCENT_DEC_20_2017_1033AM
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/node.hpp>
+
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace ast { namespace parser
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Hand-written recursive descent parser for the language described by
+    // the (Boost.Spirit based) expression grammar in expression_def.hpp. It
+    // accepts the same input and generates the same AST, but doesn't
+    // involve any backtracking over attributes. Both functions throw
+    // hpx::bad_parameter if the input can't be parsed.
+    PHYLANX_EXPORT ast::expression parse_expression(std::string const& input);
+
+    PHYLANX_EXPORT std::vector<ast::expression> parse_expressions(
+        std::string const& input);
+}}}
+
+#endif
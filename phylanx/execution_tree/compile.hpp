@@ -9,19 +9,42 @@
 #include <phylanx/config.hpp>
 #include <phylanx/ast/node.hpp>
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/compiler/bytecode.hpp>
 #include <phylanx/execution_tree/compiler/compiler.hpp>
+#include <phylanx/execution_tree/compiler/type_inference.hpp>
 
 #include <hpx/include/naming.hpp>
 
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace phylanx { namespace execution_tree
 {
+    // All compile functions below create the primitives of the generated
+    // execution tree as components on the given default locality. Passing
+    // hpx::invalid_id as the default locality instead creates all primitives
+    // as plain local objects, which are invoked through direct (virtual)
+    // function calls without any AGAS or action overhead. Such trees can't
+    // be sent to other localities.
+
     ///////////////////////////////////////////////////////////////////////////
     /// Retrieve the full list of known patterns to be used with any of the
     /// \a generate_tree functions below.
     PHYLANX_EXPORT pattern_list const& get_all_known_patterns();
 
+    /// Retrieve the parsed list of all known patterns, including the ones
+    /// added using \a register_patterns. The list is generated only once and
+    /// is shared by all compilations.
+    PHYLANX_EXPORT std::shared_ptr<compiler::expression_pattern_list const>
+        get_all_known_expression_patterns();
+
+    /// Make the given patterns known to all subsequent compilations. The
+    /// added patterns are tried after all of the built-in ones, their names
+    /// must be unique.
+    PHYLANX_EXPORT void register_patterns(
+        std::vector<match_pattern_type> const& patterns);
+
     /// Compile a given expression into a function, which when invoked will
     /// evaluate the expression corresponding to the expression.
     PHYLANX_EXPORT compiler::function compile(ast::expression const& expr,
@@ -62,6 +85,72 @@ namespace phylanx { namespace execution_tree
     PHYLANX_EXPORT compiler::function compile(std::string const& expr,
         compiler::function_list& snippets, compiler::environment& env,
         hpx::id_type const& default_locality = hpx::find_here());
+
+    /// A compiled expression along with the function definitions (snippets)
+    /// it refers to.
+    struct compiled_expression
+    {
+        compiler::function_list snippets;
+        compiler::function f;
+    };
+
+    /// Return an instance of the given expression which is compiled using
+    /// the default environment and which has not been evaluated yet (i.e.
+    /// all of its variables are in their initial state). Instances are
+    /// drawn from a process-wide cache keyed by the expression: the
+    /// expression is compiled only once into an image of its execution
+    /// tree (see \a compile_to_image), each request restores a new
+    /// instance on the given default locality from that image.
+    PHYLANX_EXPORT std::shared_ptr<compiled_expression> compile_cached(
+        std::string const& expr,
+        hpx::id_type const& default_locality = hpx::find_here());
+
+    /// Set the maximal number of expressions held by the cache used by
+    /// \a compile_cached (128 by default), the least recently used ones
+    /// are removed first.
+    PHYLANX_EXPORT void set_compile_cache_capacity(std::size_t capacity);
+
+    /// Remove all entries from the cache used by \a compile_cached.
+    PHYLANX_EXPORT void clear_compile_cache();
+
+    /// Compile the given expression using the default environment and
+    /// store the generated execution tree (all primitives, their operands
+    /// and their wiring) in a binary image. The image can be restored using
+    /// \a load_compiled without parsing or compiling the expression again.
+    /// Images can be restored only by the same build of Phylanx.
+    PHYLANX_EXPORT std::vector<char> compile_to_image(std::string const& expr);
+
+    /// Compile the given expressions using the default environment and
+    /// store the generated execution tree in a binary image.
+    PHYLANX_EXPORT std::vector<char> compile_to_image(
+        std::vector<ast::expression> const& exprs);
+
+    /// Restore an execution tree from an image created by
+    /// \a compile_to_image. All primitives are created on the given default
+    /// locality (or as plain local objects if it is hpx::invalid_id).
+    PHYLANX_EXPORT std::shared_ptr<compiled_expression> load_compiled(
+        std::vector<char> const& image,
+        hpx::id_type const& default_locality = hpx::find_here());
+
+    /// Infer the kind and shape of the values of all subexpressions of the
+    /// given expression using all known patterns. The types of variables
+    /// which are not defined by the expression itself can be supplied.
+    PHYLANX_EXPORT compiler::type_map infer_types(std::string const& expr,
+        compiler::type_map const& variables = compiler::type_map{});
+
+    /// Lower a given expression into a bytecode program, which when run
+    /// will evaluate the expression. Control flow and scalar arithmetic are
+    /// executed by the bytecode interpreter, everything else is delegated
+    /// to execution trees.
+    PHYLANX_EXPORT compiler::bytecode_program compile_bytecode(
+        ast::expression const& expr, compiler::function_list& snippets,
+        hpx::id_type const& default_locality = hpx::find_here());
+
+    /// Lower a given expression into a bytecode program, which when run
+    /// will evaluate the expression.
+    PHYLANX_EXPORT compiler::bytecode_program compile_bytecode(
+        std::string const& expr, compiler::function_list& snippets,
+        hpx::id_type const& default_locality = hpx::find_here());
 }}
 
 #endif
@@ -0,0 +1,129 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_EXECUTION_TREE_BYTECODE_DEC_09_2017_0314PM)
+#define PHYLANX_EXECUTION_TREE_BYTECODE_DEC_09_2017_0314PM
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/execution_tree/compiler/actors.hpp>
+#include <phylanx/execution_tree/compiler/compiler.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+
+#include <hpx/include/naming.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace compiler
+{
+    namespace bytecode
+    {
+        ///////////////////////////////////////////////////////////////////////
+        enum class opcode : std::uint8_t
+        {
+            load_constant,      // slots[dest] = constants[lhs]
+            move,               // slots[dest] = slots[lhs]
+
+            // slots[dest] = slots[lhs] <op> slots[rhs]
+            add,
+            sub,
+            mul,
+            div,
+            less,
+            less_equal,
+            greater,
+            greater_equal,
+            equal,
+            not_equal,
+            logical_and,
+            logical_or,
+
+            // slots[dest] = <op> slots[lhs]
+            negate,
+            logical_not,
+
+            jump,               // continue execution at lhs
+            jump_if_false,      // continue execution at rhs if !slots[lhs]
+
+            // slots[dest] = evaluate the execution tree fallbacks[aux]
+            call_tree
+        };
+
+        // All arithmetic and logical operations are executed directly as
+        // long as their operands are scalars, otherwise they are delegated
+        // to the primitive referenced by aux.
+        struct instruction
+        {
+            opcode op;
+            std::uint32_t dest;
+            std::uint32_t lhs;
+            std::uint32_t rhs;
+            std::uint32_t aux;
+        };
+
+        // A register of the interpreter. Scalar values are kept unboxed,
+        // everything else is held as a primitive_argument_type.
+        struct value
+        {
+            enum kind_type : std::uint8_t
+            {
+                object,
+                scalar,         // ir::node_data<double> holding a scalar
+                integer,        // std::int64_t
+                boolean         // bool
+            };
+
+            value()
+              : kind(object)
+              , data(0.0)
+            {}
+
+            PHYLANX_EXPORT explicit value(primitive_argument_type && val);
+
+            PHYLANX_EXPORT primitive_argument_type to_argument() const;
+
+            kind_type kind;
+            double data;
+            primitive_argument_type obj;
+        };
+
+        // A part of the expression which is evaluated using the execution
+        // tree, the given slots are passed as its arguments.
+        struct fallback
+        {
+            function f;
+            std::vector<std::uint32_t> slots;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A flat, register based representation of a compiled expression
+    struct bytecode_program
+    {
+        /// Execute the instruction sequence, return the value of the lowered
+        /// expression.
+        PHYLANX_EXPORT primitive_argument_type run() const;
+
+        std::vector<bytecode::instruction> code;
+        std::vector<bytecode::value> constants;
+        std::vector<bytecode::fallback> fallbacks;
+        std::size_t num_slots = 0;
+        std::uint32_t result = 0;
+    };
+
+    /// Lower the given AST into a bytecode program. Blocks, variables,
+    /// conditionals, loops and scalar arithmetic are translated into
+    /// instructions, all other expressions are compiled into execution trees
+    /// which are invoked from the instruction sequence. Variables defined by
+    /// the lowered expression are local to the generated program.
+    PHYLANX_EXPORT bytecode_program lower(ast::expression const& expr,
+        function_list& snippets, environment& env,
+        expression_pattern_list const& patterns,
+        hpx::id_type const& default_locality);
+}}}
+
+#endif
@@ -7,7 +7,12 @@
 #define PHYLANX_EXECUTION_TREE_COMPILER_HPP
 
 #include <phylanx/config.hpp>
+#include <phylanx/ast/detail/is_identifier.hpp>
+#include <phylanx/ast/detail/is_placeholder.hpp>
+#include <phylanx/ast/detail/is_placeholder_ellipses.hpp>
+#include <phylanx/ast/node.hpp>
 #include <phylanx/execution_tree/compiler/actors.hpp>
+#include <phylanx/execution_tree/compiler/symbol_table.hpp>
 #include <phylanx/execution_tree/primitives/access_argument.hpp>
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
 #include <phylanx/execution_tree/primitives/define_variable.hpp>
@@ -22,8 +27,10 @@
 #include <cstddef>
 #include <functional>
 #include <map>
+#include <memory>
 #include <vector>
 #include <string>
+#include <unordered_map>
 #include <utility>
 
 namespace phylanx { namespace execution_tree { namespace compiler
@@ -47,10 +54,63 @@ namespace phylanx { namespace execution_tree { namespace compiler
         pattern_list const& patterns_list,
         hpx::id_type const& default_locality = hpx::find_here());
 
+    /// Create default compilation environment based on the given list of
+    /// (already parsed) patterns and using the given default locality.
+    PHYLANX_EXPORT environment default_environment(
+        expression_pattern_list const& patterns,
+        hpx::id_type const& default_locality = hpx::find_here());
+
     /// Create default compilation environment using the given default locality.
     PHYLANX_EXPORT environment default_environment(
         hpx::id_type const& default_locality = hpx::find_here());
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Collect the expressions matched by the placeholders of a pattern
+    struct on_placeholder_match
+    {
+        std::multimap<std::string, ast::expression>& placeholders;
+
+        template <typename Ast1, typename Ast2, typename... Ts>
+        bool operator()(
+            Ast1 const& ast1, Ast2 const& ast2, Ts const&... ts) const
+        {
+            using value_type = typename std::multimap<std::string,
+                ast::expression>::value_type;
+
+            if (ast::detail::is_placeholder(ast1))
+            {
+                if (ast::detail::is_placeholder_ellipses(ast1))
+                {
+                    placeholders.insert(value_type(
+                        ast::detail::identifier_name(ast1).substr(1),
+                        ast::expression(ast2)));
+                }
+                else
+                {
+                    placeholders.insert(
+                        value_type(ast::detail::identifier_name(ast1),
+                            ast::expression(ast2)));
+                }
+            }
+            else if (ast::detail::is_placeholder(ast2))
+            {
+                if (ast::detail::is_placeholder_ellipses(ast1))
+                {
+                    placeholders.insert(value_type(
+                        ast::detail::identifier_name(ast2).substr(1),
+                        ast::expression(ast1)));
+                }
+                else
+                {
+                    placeholders.insert(
+                        value_type(ast::detail::identifier_name(ast2),
+                            ast::expression(ast1)));
+                }
+            }
+            return true;
+        }
+    };
+
     ///////////////////////////////////////////////////////////////////////////
     // compiled functions
     template <typename Derived>
@@ -139,13 +199,14 @@ namespace phylanx { namespace execution_tree { namespace compiler
 
         function operator()(argument_type && arg) const
         {
-            return function{hpx::new_<primitives::define_variable>(
-                locality_, std::move(arg)), "primitive_variable"};
+            return function{create_primitive<primitives::define_variable>(
+                locality_, std::move(arg), std::string(), locality_),
+                "primitive_variable"};
         }
         function operator()(argument_type && arg, std::string const& name) const
         {
-            return function{hpx::new_<primitives::define_variable>(
-                                locality_, std::move(arg), name),
+            return function{create_primitive<primitives::define_variable>(
+                                locality_, std::move(arg), name, locality_),
                 "primitive_variable: " + name};
         }
 
@@ -179,7 +240,8 @@ namespace phylanx { namespace execution_tree { namespace compiler
         function operator()(std::string const& name) const
         {
             return function{
-                hpx::new_<primitives::define_function>(locality_, name),
+                create_primitive<primitives::define_function>(
+                    locality_, name, locality_),
                 "primitive_function: " + name};
         }
 
@@ -194,7 +256,7 @@ namespace phylanx { namespace execution_tree { namespace compiler
             hpx::id_type const& locality = hpx::find_here()) const
         {
             return function{
-                    hpx::new_<primitives::access_argument>(locality, n),
+                    create_primitive<primitives::access_argument>(locality, n),
                     "argument"
                 };
         }
@@ -230,7 +292,7 @@ namespace phylanx { namespace execution_tree { namespace compiler
             }
 
             return function{
-                    hpx::new_<primitives::wrapped_function>(
+                    create_primitive<primitives::wrapped_function>(
                         this->locality_, f_.get().arg_, std::move(fargs)),
                     "external_function"
                 };
@@ -242,34 +304,62 @@ namespace phylanx { namespace execution_tree { namespace compiler
             function(function_list)
         > compiled_function;
 
+    ///////////////////////////////////////////////////////////////////////////
+    /// Consulted by the compiler for each definition (define()) compiled in
+    /// an environment the cache is attached to (or in one of its nested
+    /// scopes). Allows to reuse the primitives compiled for an earlier
+    /// version of a program (see incremental_compiler).
+    class definition_cache
+    {
+    public:
+        virtual ~definition_cache() = default;
+
+        /// Return the (already compiled) function to bind the given
+        /// definition to, or nullptr if the definition has to be compiled.
+        /// The returned function has to outlive the compiled expression.
+        virtual function const* find(std::string const& name,
+            ast::expression const& expr, environment const& scope) = 0;
+
+        /// Invoked once the given definition was compiled into f.
+        virtual void add(std::string const& name,
+            ast::expression const& expr, environment const& scope,
+            function const& f) = 0;
+    };
+
+    // Names are interned into a symbol table shared by an environment and
+    // all of its nested scopes, each scope maps symbols to definitions.
     class environment
     {
-        using iterator = std::map<std::string, compiled_function>::iterator;
-        using value_type = std::map<std::string, compiled_function>::value_type;
+        using symbol = symbol_table::symbol;
+        using value_type =
+            std::unordered_map<symbol, compiled_function>::value_type;
 
     public:
         environment(environment* outer = nullptr)
           : outer_(outer)
-        {}
-
-        template <typename F>
-        compiled_function* define(std::string const& name, F && f)
         {
-            if (definitions_.find(name) != definitions_.end())
+            if (outer_ != nullptr)
             {
-                HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                    "phylanx::execution_tree::environment::define",
-                    "given name was already defined: " + name);
+                symbols_ = outer_->symbols_;
+            }
+            else
+            {
+                owned_symbols_ = std::make_shared<symbol_table>();
+                symbols_ = owned_symbols_.get();
             }
+        }
 
-            auto result = definitions_.emplace(
-                value_type(name, compiled_function(std::forward<F>(f))));
+        template <typename F>
+        compiled_function* define(std::string const& name, F && f)
+        {
+            auto result = definitions_.emplace(value_type(
+                symbols_->intern(name), compiled_function(std::forward<F>(f))));
 
             if (!result.second)
             {
                 HPX_THROW_EXCEPTION(hpx::bad_parameter,
                     "phylanx::execution_tree::environment::define",
-                    "couldn't insert name into symbol table: " + name);
+                    "given name was already defined: " + name);
             }
 
             return &result.first->second;
@@ -277,20 +367,50 @@ namespace phylanx { namespace execution_tree { namespace compiler
 
         compiled_function* find(std::string const& name)
         {
-            iterator it = definitions_.find(name);
-            if (it != definitions_.end())
+            // a name which was never interned can't have been defined
+            symbol s = symbols_->find(name);
+            if (s == symbol_table::npos)
             {
-                return &it->second;
+                return nullptr;
             }
-            else if (outer_ != nullptr)
+            return find(s);
+        }
+
+        compiled_function* find(symbol s)
+        {
+            for (environment* env = this; env != nullptr; env = env->outer_)
             {
-                return outer_->find(name);
+                auto it = env->definitions_.find(s);
+                if (it != env->definitions_.end())
+                {
+                    return &it->second;
+                }
             }
             return nullptr;
         }
 
         environment* parent() const { return outer_; }
 
+        void set_definition_cache(definition_cache* cache)
+        {
+            cache_ = cache;
+        }
+
+        definition_cache* get_definition_cache() const
+        {
+            for (environment const* env = this; env != nullptr;
+                 env = env->outer_)
+            {
+                if (env->cache_ != nullptr)
+                {
+                    return env->cache_;
+                }
+            }
+            return nullptr;
+        }
+
+        symbol_table& symbols() const { return *symbols_; }
+
         std::size_t size() const
         {
             std::size_t count = definitions_.size();
@@ -301,7 +421,10 @@ namespace phylanx { namespace execution_tree { namespace compiler
 
     private:
         environment* outer_;
-        std::map<std::string, compiled_function> definitions_;
+        std::shared_ptr<symbol_table> owned_symbols_;
+        symbol_table* symbols_;
+        std::unordered_map<symbol, compiled_function> definitions_;
+        definition_cache* cache_ = nullptr;
     };
 
     ///////////////////////////////////////////////////////////////////////////
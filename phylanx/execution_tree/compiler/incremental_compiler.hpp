@@ -0,0 +1,106 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_EXECUTION_TREE_COMPILER_INCREMENTAL_COMPILER_HPP)
+#define PHYLANX_EXECUTION_TREE_COMPILER_INCREMENTAL_COMPILER_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/execution_tree/compiler/actors.hpp>
+#include <phylanx/execution_tree/compiler/compiler.hpp>
+
+#include <hpx/include/naming.hpp>
+#include <hpx/runtime/find_here.hpp>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace compiler
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// Compiles successive versions of a program (a list of top-level
+    /// statements, or the statements of a single block). Each definition
+    /// (define()) is remembered along with the canonical form of its AST.
+    /// When the next version of the program is compiled, a definition
+    /// which did not change and which does not refer to any definition
+    /// that was compiled again reuses its existing primitives. The program
+    /// as a whole is compiled as usual otherwise (see compile()), which
+    /// applies type inference, the removal of unused definitions, etc.
+    class incremental_compiler
+    {
+    public:
+        PHYLANX_EXPORT explicit incremental_compiler(
+            hpx::id_type const& default_locality = hpx::find_here());
+
+        incremental_compiler(incremental_compiler const&) = delete;
+        incremental_compiler& operator=(incremental_compiler const&) = delete;
+
+        /// Compile the given version of the program. Return a function
+        /// which when invoked evaluates the last statement. The previous
+        /// version is retained if compilation fails.
+        PHYLANX_EXPORT function compile(
+            std::vector<ast::expression> const& exprs);
+
+        PHYLANX_EXPORT function compile(std::string const& exprs);
+
+        /// The environment holding the definitions of the current version
+        /// of the program, which can be used to compile other expressions
+        /// referring to those.
+        environment& env()
+        {
+            return *env_;
+        }
+
+        /// The number of definitions which were compiled (or reused) by the
+        /// last invocation of compile.
+        std::size_t num_compiled() const
+        {
+            return num_compiled_;
+        }
+        std::size_t num_reused() const
+        {
+            return num_reused_;
+        }
+
+    private:
+        struct definition
+        {
+            std::string source;             // ast::to_string(define(...))
+            std::set<std::string> references;
+
+            // the snippets of the version of the program the definition
+            // was compiled for own the compiled function (or variable),
+            // function bodies refer to the snippets by reference
+            std::shared_ptr<function_list> snippets;
+            function const* f;
+        };
+
+        class program_definitions;
+
+        bool is_unchanged(definition const& def,
+            std::map<std::string, std::shared_ptr<definition>> const& current,
+            std::set<std::string> const& recompiled) const;
+
+        std::shared_ptr<expression_pattern_list const> patterns_;
+        hpx::id_type default_locality_;
+
+        // built-in functions, shared by all versions of the program
+        environment builtins_;
+
+        // definitions and compiled statements of the current version
+        std::unique_ptr<environment> env_;
+        std::map<std::string, std::shared_ptr<definition>> definitions_;
+        std::shared_ptr<function_list> snippets_;
+
+        std::size_t num_compiled_;
+        std::size_t num_reused_;
+    };
+}}}
+
+#endif
@@ -0,0 +1,61 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_EXECUTION_TREE_PATTERN_INDEX_DEC_19_2017_0211PM)
+#define PHYLANX_EXECUTION_TREE_PATTERN_INDEX_DEC_19_2017_0211PM
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/execution_tree/compiler/compiler.hpp>
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace compiler
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// Index of a list of patterns keyed on the top-level shape of each
+    /// pattern (the function name, the unary operator, or the binary
+    /// operators). It is used to select the patterns which may match a given
+    /// expression without invoking ast::match_ast for all of them.
+    class pattern_index
+    {
+    public:
+        /// The index refers to the given list of patterns, which has to
+        /// outlive the index.
+        PHYLANX_EXPORT explicit pattern_index(
+            expression_pattern_list const& patterns);
+
+        /// Return the patterns which may match the given expression, in the
+        /// order they appear in the list of patterns. All other patterns
+        /// are guaranteed not to match.
+        PHYLANX_EXPORT std::vector<expression_pattern const*> candidates(
+            ast::expression const& expr) const;
+
+        /// Return the first pattern of the given name (or nullptr)
+        PHYLANX_EXPORT expression_pattern const* find(
+            std::string const& name) const;
+
+    private:
+        std::vector<expression_pattern const*> merge(
+            std::vector<std::vector<std::size_t> const*> const& buckets) const;
+
+        expression_pattern_list const& patterns_;
+
+        std::unordered_map<std::string, std::vector<std::size_t>> calls_;
+        std::map<ast::optoken, std::vector<std::size_t>> unary_;
+        std::map<ast::optoken, std::vector<std::size_t>> binary_;
+
+        // patterns of any other shape (e.g. a sole placeholder)
+        std::vector<std::size_t> generic_;
+
+        std::unordered_map<std::string, std::size_t> names_;
+    };
+}}}
+
+#endif
@@ -0,0 +1,63 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_EXECUTION_TREE_COMPILER_SYMBOL_TABLE_HPP)
+#define PHYLANX_EXECUTION_TREE_COMPILER_SYMBOL_TABLE_HPP
+
+#include <phylanx/config.hpp>
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace compiler
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Maps names to small integers (symbols). All scopes of a compilation
+    // environment share one symbol table, which allows to look up names by
+    // comparing integers only.
+    class symbol_table
+    {
+    public:
+        using symbol = std::size_t;
+
+        static constexpr symbol const npos = symbol(-1);
+
+        // return the symbol for the given name, add it if necessary
+        symbol intern(std::string const& name)
+        {
+            auto result = symbols_.emplace(name, names_.size());
+            if (result.second)
+            {
+                names_.push_back(&result.first->first);
+            }
+            return result.first->second;
+        }
+
+        // return the symbol for the given name or npos if it is not known
+        symbol find(std::string const& name) const
+        {
+            auto it = symbols_.find(name);
+            return it != symbols_.end() ? it->second : symbol(npos);
+        }
+
+        std::string const& name(symbol s) const
+        {
+            return *names_[s];
+        }
+
+        std::size_t size() const
+        {
+            return names_.size();
+        }
+
+    private:
+        std::unordered_map<std::string, symbol> symbols_;
+        std::vector<std::string const*> names_;
+    };
+}}}
+
+#endif
@@ -0,0 +1,104 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_EXECUTION_TREE_COMPILER_TYPE_INFERENCE_HPP)
+#define PHYLANX_EXECUTION_TREE_COMPILER_TYPE_INFERENCE_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/execution_tree/compiler/compiler.hpp>
+#include <phylanx/execution_tree/compiler/pattern_index.hpp>
+
+#include <array>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace compiler
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// The statically known properties of the value of an expression.
+    struct inferred_type
+    {
+        enum kind_type
+        {
+            unknown = 0,
+            nil = 1,
+            boolean = 2,
+            integer = 3,
+            string = 4,
+            numeric = 5,        // ir::node_data<double>
+            float32 = 6,        // ir::node_data<float>
+            list = 7,
+            function = 8
+        };
+
+        inferred_type() = default;
+
+        explicit inferred_type(kind_type k, int r = -1,
+                std::size_t rows = 0, std::size_t columns = 0)
+          : kind(k), rank(r), dimensions{{rows, columns}}
+        {}
+
+        // scalar values of the given kind
+        static inferred_type scalar(kind_type k)
+        {
+            return inferred_type(k, 0, 1, 1);
+        }
+
+        bool has_rank() const
+        {
+            return rank >= 0;
+        }
+
+        kind_type kind = unknown;
+
+        // number of dimensions (0, 1, or 2), -1 if not known
+        int rank = -1;
+
+        // the extents of the value in the same form as returned by
+        // ir::node_data<>::dimensions(), an extent of zero is not known
+        std::array<std::size_t, 2> dimensions = {{0, 0}};
+    };
+
+    inline bool operator==(inferred_type const& lhs, inferred_type const& rhs)
+    {
+        return lhs.kind == rhs.kind && lhs.rank == rhs.rank &&
+            lhs.dimensions == rhs.dimensions;
+    }
+
+    inline bool operator!=(inferred_type const& lhs, inferred_type const& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    /// Return the properties common to both of the given types.
+    PHYLANX_EXPORT inferred_type join(
+        inferred_type const& lhs, inferred_type const& rhs);
+
+    PHYLANX_EXPORT std::string to_string(inferred_type const& type);
+
+    /// The inferred types of expressions (keyed by ast::to_string(expr)) or
+    /// of variables (keyed by their name).
+    using type_map = std::map<std::string, inferred_type>;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Infer the kind and shape of the values of the given expression and
+    /// of all of its subexpressions from the literals it contains and from
+    /// the given types of (otherwise unknown) variables. Throws
+    /// hpx::bad_parameter if the shapes of the operands of a primitive are
+    /// known not to fit. Expressions which occur more than once with
+    /// different types are reported with the properties common to all
+    /// of their occurrences.
+    PHYLANX_EXPORT type_map infer_types(ast::expression const& expr,
+        pattern_index const& index, type_map const& variables = type_map{});
+
+    PHYLANX_EXPORT type_map infer_types(
+        std::vector<ast::expression> const& exprs, pattern_index const& index,
+        type_map const& variables = type_map{});
+}}}
+
+#endif
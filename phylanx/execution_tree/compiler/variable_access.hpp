@@ -0,0 +1,65 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_EXECUTION_TREE_VARIABLE_ACCESS_DEC_13_2017_1142AM)
+#define PHYLANX_EXECUTION_TREE_VARIABLE_ACCESS_DEC_13_2017_1142AM
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/execution_tree/compiler/compiler.hpp>
+
+#include <cstddef>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace compiler
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// The set of variables an expression reads from and writes to (using
+    /// store() or define()). Expressions which might have effects that can't
+    /// be attributed to a known set of variables (I/O, invoking user defined
+    /// functions) are marked as having side effects.
+    struct variable_access
+    {
+        std::set<std::string> reads;
+        std::set<std::string> writes;
+        bool has_side_effects = false;
+
+        // the expression invokes user defined functions, which might modify
+        // arbitrary variables
+        bool invokes_functions = false;
+
+        /// Return whether the two expressions must not be reordered (or
+        /// executed concurrently).
+        PHYLANX_EXPORT bool depends_on(variable_access const& rhs) const;
+    };
+
+    /// Return whether invoking the built-in function of the given name has
+    /// side effects (or returns different values for the same arguments).
+    PHYLANX_EXPORT bool has_side_effects(std::string const& name);
+
+    /// Collect the variables accessed by the given expression. All function
+    /// calls which don't refer to one of the given patterns are assumed to
+    /// invoke user defined functions.
+    PHYLANX_EXPORT variable_access analyze_variable_access(
+        ast::expression const& expr, expression_pattern_list const& patterns);
+
+    /// For each of the given statements (executed in sequence), return the
+    /// indices of the preceding statements it depends on.
+    PHYLANX_EXPORT std::vector<std::vector<std::size_t>>
+    statement_dependencies(std::vector<ast::expression> const& statements,
+        expression_pattern_list const& patterns);
+
+    /// Remove all definitions (define()) of variables and functions from the
+    /// given statements which are not referenced by any other statement.
+    /// Definitions of variables whose initialization has side effects are
+    /// retained, as is the last statement.
+    PHYLANX_EXPORT std::vector<ast::expression> remove_unused_definitions(
+        std::vector<ast::expression> statements,
+        expression_pattern_list const& patterns);
+}}}
+
+#endif
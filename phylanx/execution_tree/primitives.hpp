@@ -9,17 +9,20 @@
 #include <phylanx/execution_tree/primitives/access_argument.hpp>
 #include <phylanx/execution_tree/primitives/add_operation.hpp>
 #include <phylanx/execution_tree/primitives/and_operation.hpp>
+#include <phylanx/execution_tree/primitives/batched_operations.hpp>
 #include <phylanx/execution_tree/primitives/block_operation.hpp>
 #include <phylanx/execution_tree/primitives/column_slicing.hpp>
 #include <phylanx/execution_tree/primitives/console_output.hpp>
 #include <phylanx/execution_tree/primitives/constant.hpp>
 #include <phylanx/execution_tree/primitives/cross_operation.hpp>
+#include <phylanx/execution_tree/primitives/dataflow_block_operation.hpp>
 #include <phylanx/execution_tree/primitives/define_function.hpp>
 #include <phylanx/execution_tree/primitives/define_variable.hpp>
 
 #include <phylanx/execution_tree/primitives/determinant.hpp>
 #include <phylanx/execution_tree/primitives/div_operation.hpp>
 #include <phylanx/execution_tree/primitives/dot_operation.hpp>
+#include <phylanx/execution_tree/primitives/einsum_operation.hpp>
 #include <phylanx/execution_tree/primitives/equal.hpp>
 #include <phylanx/execution_tree/primitives/exponential_operation.hpp>
 #include <phylanx/execution_tree/primitives/extract_shape.hpp>
@@ -27,20 +30,29 @@
 #include <phylanx/execution_tree/primitives/file_read_csv.hpp>
 #include <phylanx/execution_tree/primitives/file_write.hpp>
 #include <phylanx/execution_tree/primitives/file_write_csv.hpp>
+#include <phylanx/execution_tree/primitives/float32_operation.hpp>
 #include <phylanx/execution_tree/primitives/for_operation.hpp>
 #include <phylanx/execution_tree/primitives/greater.hpp>
 #include <phylanx/execution_tree/primitives/greater_equal.hpp>
 #include <phylanx/execution_tree/primitives/if_conditional.hpp>
 #include <phylanx/execution_tree/primitives/inverse_operation.hpp>
+#include <phylanx/execution_tree/primitives/kron_operation.hpp>
 #include <phylanx/execution_tree/primitives/less.hpp>
 #include <phylanx/execution_tree/primitives/less_equal.hpp>
+#include <phylanx/execution_tree/primitives/let_operation.hpp>
 #include <phylanx/execution_tree/primitives/mul_operation.hpp>
+#include <phylanx/execution_tree/primitives/multi_dot_operation.hpp>
 #include <phylanx/execution_tree/primitives/not_equal.hpp>
 #include <phylanx/execution_tree/primitives/or_operation.hpp>
+#include <phylanx/execution_tree/primitives/outer_operation.hpp>
 #include <phylanx/execution_tree/primitives/parallel_block_operation.hpp>
+#include <phylanx/execution_tree/primitives/parallel_map.hpp>
 #include <phylanx/execution_tree/primitives/power_operation.hpp>
 #include <phylanx/execution_tree/primitives/random.hpp>
+#include <phylanx/execution_tree/primitives/randomized_svd.hpp>
+#include <phylanx/execution_tree/primitives/ranked_operation.hpp>
 #include <phylanx/execution_tree/primitives/row_slicing.hpp>
+#include <phylanx/execution_tree/primitives/scheduled_operation.hpp>
 #include <phylanx/execution_tree/primitives/slicing_operation.hpp>
 #include <phylanx/execution_tree/primitives/square_root_operation.hpp>
 #include <phylanx/execution_tree/primitives/store_operation.hpp>
@@ -13,12 +13,20 @@
 #include <phylanx/util/serialization/optional.hpp>
 
 #include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
 #include <hpx/include/util.hpp>
+#include <hpx/util/invoke_fused.hpp>
+#include <hpx/util/tuple.hpp>
 
+#include <cstddef>
+#include <exception>
 #include <initializer_list>
 #include <iosfwd>
 #include <map>
+#include <memory>
 #include <string>
+#include <type_traits>
+#include <typeinfo>
 #include <utility>
 #include <vector>
 
@@ -60,6 +68,14 @@ namespace phylanx { namespace execution_tree
         {
         }
 
+        // Refer to a primitive which was created as a plain local object.
+        // All operations on it are direct (virtual) function calls, no
+        // component or action is involved.
+        explicit primitive(std::shared_ptr<primitives::base_primitive> p)
+          : local_(std::move(p))
+        {
+        }
+
         hpx::future<primitive_argument_type> eval() const;
         hpx::future<primitive_argument_type> eval(
             std::vector<primitive_argument_type> const& args) const;
@@ -74,6 +90,18 @@ namespace phylanx { namespace execution_tree
         hpx::future<bool> bind(std::vector<primitive_argument_type> const&);
         bool bind(hpx::launch::sync_policy,
             std::vector<primitive_argument_type> const&);
+
+        bool is_local() const
+        {
+            return static_cast<bool>(local_);
+        }
+        std::shared_ptr<primitives::base_primitive> const& local() const
+        {
+            return local_;
+        }
+
+    private:
+        std::shared_ptr<primitives::base_primitive> local_;
     };
 
     ///////////////////////////////////////////////////////////////////////////
@@ -87,6 +115,7 @@ namespace phylanx { namespace execution_tree
           , primitive
           , std::vector<ast::expression>
           , phylanx::util::recursive_wrapper<std::vector<primitive_argument_type>>
+          , phylanx::ir::node_data<float>
         >;
 
     struct primitive_argument_type;
@@ -251,6 +280,18 @@ namespace phylanx { namespace execution_tree
     PHYLANX_EXPORT ir::node_data<double> extract_numeric_value(
         primitive_result_type && val);
 
+    // Return whether the given primitive_argument_type holds numeric data
+    // stored in single precision.
+    PHYLANX_EXPORT bool is_float32_value(primitive_argument_type const& val);
+
+    // Extract a ir::node_data<float> type from a given primitive_argument_type,
+    // throw if it doesn't hold a numeric value type. Data stored in double
+    // precision is narrowed.
+    PHYLANX_EXPORT ir::node_data<float> extract_float32_value(
+        primitive_argument_type const& val);
+    PHYLANX_EXPORT ir::node_data<float> extract_float32_value(
+        primitive_result_type && val);
+
     // Extract a std::int64_t type from a given primitive_argument_type,
     // throw if it doesn't hold one.
     PHYLANX_EXPORT std::int64_t extract_integer_value(
@@ -352,13 +393,277 @@ namespace phylanx { namespace execution_tree
 
     using pattern_list = std::vector<std::vector<match_pattern_type>>;
 
+    namespace detail
+    {
+        template <typename Primitive, typename ... Ts>
+        primitive create_primitive_impl(
+            hpx::id_type const& locality, Ts &&... ts)
+        {
+            if (!locality)
+            {
+                return primitive(std::shared_ptr<primitives::base_primitive>(
+                    std::make_shared<Primitive>(std::forward<Ts>(ts)...)));
+            }
+            return primitive(
+                hpx::new_<Primitive>(locality, std::forward<Ts>(ts)...));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Support for storing compiled execution trees in images (see
+        // compile_to_image). While a tree recorder is active on the current
+        // HPX thread, create_primitive remembers how each primitive was
+        // created.
+        class tree_recorder;
+        class tree_image_writer;
+        class tree_image_reader;
+
+        struct primitive_recipe
+        {
+            virtual ~primitive_recipe() = default;
+
+            // identifies the primitive type and its constructor arguments,
+            // nullptr if the primitive can't be stored in an image
+            virtual char const* key() const = 0;
+
+            virtual void save(tree_image_writer& writer) const = 0;
+
+            // collect the primitives referred to by the constructor arguments
+            virtual void references(std::vector<primitive>& result) const = 0;
+        };
+
+        PHYLANX_EXPORT tree_recorder* current_tree_recorder();
+        PHYLANX_EXPORT void record_primitive(tree_recorder& recorder,
+            primitive const& p, std::unique_ptr<primitive_recipe> && recipe);
+
+        // remember the body assigned to a define_function primitive
+        PHYLANX_EXPORT void record_function_body(
+            primitive const& p, primitive_argument_type const& body);
+
+        using primitive_loader = primitive (*)(tree_image_reader&);
+        PHYLANX_EXPORT bool register_primitive_loader(
+            char const* key, primitive_loader loader);
+
+        // constructor arguments which can be stored in an image
+        PHYLANX_EXPORT void save_argument(
+            tree_image_writer& writer, primitive_argument_type const& arg);
+        PHYLANX_EXPORT void save_argument(tree_image_writer& writer,
+            std::vector<primitive_argument_type> const& args);
+        PHYLANX_EXPORT void save_argument(
+            tree_image_writer& writer, std::string const& arg);
+        PHYLANX_EXPORT void save_argument(
+            tree_image_writer& writer, std::size_t arg);
+        PHYLANX_EXPORT void save_argument(
+            tree_image_writer& writer, hpx::id_type const& arg);
+        PHYLANX_EXPORT void save_argument(tree_image_writer& writer,
+            std::vector<std::vector<std::size_t>> const& arg);
+
+        PHYLANX_EXPORT void load_argument(
+            tree_image_reader& reader, primitive_argument_type& arg);
+        PHYLANX_EXPORT void load_argument(tree_image_reader& reader,
+            std::vector<primitive_argument_type>& args);
+        PHYLANX_EXPORT void load_argument(
+            tree_image_reader& reader, std::string& arg);
+        PHYLANX_EXPORT void load_argument(
+            tree_image_reader& reader, std::size_t& arg);
+        PHYLANX_EXPORT void load_argument(
+            tree_image_reader& reader, hpx::id_type& arg);
+        PHYLANX_EXPORT void load_argument(tree_image_reader& reader,
+            std::vector<std::vector<std::size_t>>& arg);
+
+        PHYLANX_EXPORT hpx::id_type const& image_locality(
+            tree_image_reader& reader);
+
+        PHYLANX_EXPORT void collect_references(
+            primitive_argument_type const& arg, std::vector<primitive>& result);
+        PHYLANX_EXPORT void collect_references(
+            std::vector<primitive_argument_type> const& args,
+            std::vector<primitive>& result);
+
+        template <typename T>
+        void collect_references(T const&, std::vector<primitive>&)
+        {
+        }
+
+        template <typename T>
+        struct is_image_argument
+          : std::integral_constant<bool,
+                std::is_same<T, primitive_argument_type>::value ||
+                std::is_same<T, std::vector<primitive_argument_type>>::value ||
+                std::is_same<T, std::string>::value ||
+                std::is_same<T, std::size_t>::value ||
+                std::is_same<T, hpx::id_type>::value ||
+                std::is_same<T,
+                    std::vector<std::vector<std::size_t>>>::value>
+        {};
+
+        template <typename ... Ts>
+        struct all_image_arguments;
+
+        template <>
+        struct all_image_arguments<> : std::true_type {};
+
+        template <typename T, typename ... Ts>
+        struct all_image_arguments<T, Ts...>
+          : std::integral_constant<bool,
+                is_image_argument<T>::value &&
+                all_image_arguments<Ts...>::value>
+        {};
+
+        // Remembers the constructor arguments of a primitive of the given
+        // type, the same type recreates the primitive from an image.
+        template <typename Primitive, typename ... Ts>
+        class typed_primitive_recipe : public primitive_recipe
+        {
+            struct saver
+            {
+                template <typename ... Us>
+                void operator()(Us const&... us) const
+                {
+                    int const sequencer[] = {
+                        0, (save_argument(writer_, us), 0)...
+                    };
+                    (void) sequencer;
+                }
+
+                tree_image_writer& writer_;
+            };
+
+            struct collector
+            {
+                template <typename ... Us>
+                void operator()(Us const&... us) const
+                {
+                    int const sequencer[] = {
+                        0, (collect_references(us, result_), 0)...
+                    };
+                    (void) sequencer;
+                }
+
+                std::vector<primitive>& result_;
+            };
+
+            struct creator
+            {
+                template <typename ... Us>
+                primitive operator()(Us &&... us) const
+                {
+                    return create_primitive_impl<Primitive>(
+                        locality_, std::forward<Us>(us)...);
+                }
+
+                hpx::id_type const& locality_;
+            };
+
+            template <typename T>
+            static T load(tree_image_reader& reader)
+            {
+                T arg;
+                load_argument(reader, arg);
+                return arg;
+            }
+
+        public:
+            explicit typed_primitive_recipe(Ts const&... ts)
+              : args_(ts...)
+            {
+                (void) registered_;
+            }
+
+            char const* key() const override
+            {
+                return typeid(typed_primitive_recipe).name();
+            }
+
+            void save(tree_image_writer& writer) const override
+            {
+                hpx::util::invoke_fused(saver{writer}, args_);
+            }
+
+            void references(std::vector<primitive>& result) const override
+            {
+                hpx::util::invoke_fused(collector{result}, args_);
+            }
+
+            static primitive load_primitive(tree_image_reader& reader)
+            {
+                // the elements of a braced-init-list are evaluated in order
+                hpx::util::tuple<Ts...> args{load<Ts>(reader)...};
+                return hpx::util::invoke_fused(
+                    creator{image_locality(reader)}, std::move(args));
+            }
+
+        private:
+            static bool const registered_;
+            hpx::util::tuple<Ts...> args_;
+        };
+
+        template <typename Primitive, typename ... Ts>
+        bool const typed_primitive_recipe<Primitive, Ts...>::registered_ =
+            register_primitive_loader(
+                typeid(typed_primitive_recipe<Primitive, Ts...>).name(),
+                &typed_primitive_recipe<Primitive, Ts...>::load_primitive);
+
+        // primitives created with other arguments can't be stored
+        struct unsupported_primitive_recipe : primitive_recipe
+        {
+            template <typename ... Ts>
+            explicit unsupported_primitive_recipe(Ts const&...)
+            {
+            }
+
+            char const* key() const override
+            {
+                return nullptr;
+            }
+            void save(tree_image_writer&) const override {}
+            void references(std::vector<primitive>&) const override {}
+        };
+
+        template <typename Primitive, typename ... Ts>
+        primitive create_recorded_primitive(tree_recorder& recorder,
+            hpx::id_type const& locality, Ts &&... ts)
+        {
+            using recipe_type = typename std::conditional<
+                    all_image_arguments<
+                        typename std::decay<Ts>::type...>::value,
+                    typed_primitive_recipe<
+                        Primitive, typename std::decay<Ts>::type...>,
+                    unsupported_primitive_recipe
+                >::type;
+
+            // copy the arguments before they are moved into the primitive
+            std::unique_ptr<primitive_recipe> recipe(new recipe_type(ts...));
+
+            primitive p = create_primitive_impl<Primitive>(
+                locality, std::forward<Ts>(ts)...);
+            record_primitive(recorder, p, std::move(recipe));
+            return p;
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
+    // Create an instance of the given primitive as a component on the given
+    // locality. If the given locality is invalid (hpx::invalid_id) the
+    // primitive is instead created as a plain local object, which bypasses
+    // AGAS and action dispatch for all subsequent invocations.
+    template <typename Primitive, typename ... Ts>
+    primitive create_primitive(hpx::id_type const& locality, Ts &&... ts)
+    {
+        if (detail::tree_recorder* recorder = detail::current_tree_recorder())
+        {
+            return detail::create_recorded_primitive<Primitive>(
+                *recorder, locality, std::forward<Ts>(ts)...);
+        }
+        return detail::create_primitive_impl<Primitive>(
+            locality, std::forward<Ts>(ts)...);
+    }
+
     // Generic creation helper for creating an instance of the given primitive.
     template <typename Primitive>
     primitive create(hpx::id_type locality,
         std::vector<primitive_argument_type>&& operands)
     {
-        return primitive(hpx::new_<Primitive>(locality, std::move(operands)));
+        return create_primitive<Primitive>(locality, std::move(operands));
     }
 }}
 
@@ -384,6 +689,140 @@ namespace phylanx { namespace execution_tree { namespace primitives
             return out;
         }
 
+        // Invoke the given function with the values of all given futures.
+        // The function is executed right away if all of the futures are
+        // ready, hpx::dataflow is used only if some of them are still pending.
+        template <typename F, typename T>
+        hpx::future<primitive_result_type> invoke_when_ready(
+            F && f, std::vector<hpx::future<T>> && futures)
+        {
+            for (auto const& fut : futures)
+            {
+                if (!fut.is_ready())
+                {
+                    return hpx::dataflow(
+                        hpx::util::unwrapping(std::forward<F>(f)),
+                        std::move(futures));
+                }
+            }
+
+            try
+            {
+                std::vector<T> values;
+                values.reserve(futures.size());
+                for (auto& fut : futures)
+                {
+                    values.push_back(fut.get());
+                }
+                return hpx::make_ready_future(
+                    primitive_result_type(f(std::move(values))));
+            }
+            catch (...)
+            {
+                return hpx::make_exceptional_future<primitive_result_type>(
+                    std::current_exception());
+            }
+        }
+
+        // Invoke the given function (one of the *_operand_sync functions) on
+        // all operands, while returning a vector holding the respective
+        // results. Operands which have to be evaluated by a primitive are
+        // evaluated concurrently if there is more than one of those: all but
+        // the last of them are evaluated on new HPX threads.
+        template <typename F>
+        auto map_operands_concurrently(
+            std::vector<primitive_argument_type> const& in, F && f,
+            std::vector<primitive_argument_type> const& args)
+        ->  std::vector<decltype(hpx::util::invoke(
+                f, std::declval<primitive_argument_type const&>(), args))>
+        {
+            using value_type = decltype(hpx::util::invoke(
+                f, std::declval<primitive_argument_type const&>(), args));
+
+            std::size_t last = in.size();
+            std::size_t num_primitives = 0;
+            for (std::size_t i = 0; i != in.size(); ++i)
+            {
+                if (util::get_if<primitive>(&in[i]) != nullptr)
+                {
+                    last = i;
+                    ++num_primitives;
+                }
+            }
+
+            if (num_primitives < 2)
+            {
+                return map_operands(in, f, args);
+            }
+
+            std::vector<hpx::future<value_type>> futures;
+            futures.reserve(in.size());
+            for (std::size_t i = 0; i != in.size(); ++i)
+            {
+                if (i != last && util::get_if<primitive>(&in[i]) != nullptr)
+                {
+                    futures.push_back(hpx::async(
+                        [&, i]() -> value_type
+                        {
+                            return hpx::util::invoke(f, in[i], args);
+                        }));
+                }
+                else
+                {
+                    futures.push_back(hpx::future<value_type>());
+                }
+            }
+
+            // the threads refer to the operands and the arguments, those
+            // have to be finished before any exception is propagated
+            std::exception_ptr ex;
+            std::vector<value_type> out;
+            out.reserve(in.size());
+            try
+            {
+                for (std::size_t i = 0; i != in.size(); ++i)
+                {
+                    if (!futures[i].valid())
+                    {
+                        out.push_back(hpx::util::invoke(f, in[i], args));
+                    }
+                }
+            }
+            catch (...)
+            {
+                ex = std::current_exception();
+            }
+
+            for (auto& fut : futures)
+            {
+                if (fut.valid())
+                {
+                    fut.wait();
+                }
+            }
+
+            if (ex)
+            {
+                std::rethrow_exception(ex);
+            }
+
+            std::vector<value_type> result;
+            result.reserve(in.size());
+            auto it = out.begin();
+            for (auto& fut : futures)
+            {
+                if (fut.valid())
+                {
+                    result.push_back(fut.get());
+                }
+                else
+                {
+                    result.push_back(std::move(*it++));
+                }
+            }
+            return result;
+        }
+
         ///////////////////////////////////////////////////////////////////////
         // check if one of the optionals in the list of operands is empty
         inline bool verify_argument_values(
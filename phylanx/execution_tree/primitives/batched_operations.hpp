@@ -0,0 +1,75 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_BATCHED_OPERATIONS_DEC_04_2017_1021AM)
+#define PHYLANX_PRIMITIVES_BATCHED_OPERATIONS_DEC_04_2017_1021AM
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/include/components.hpp>
+
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    // The batched primitives operate on a stack of independent (small)
+    // problems, represented as a list of matrices (or vectors). All problems
+    // of one batch are handled by a single primitive evaluation, which avoids
+    // creating one component and one future per problem. A non-list operand
+    // is broadcast to all elements of the batch.
+
+    // batched_dot(A, B): computes dot(A[i], B[i]) for all i
+    class HPX_COMPONENT_EXPORT batched_dot
+      : public base_primitive
+      , public hpx::components::component_base<batched_dot>
+    {
+    public:
+        static std::vector<match_pattern_type> const match_data;
+
+        batched_dot() = default;
+
+        batched_dot(std::vector<primitive_argument_type>&& operands);
+
+        hpx::future<primitive_result_type> eval(
+            std::vector<primitive_argument_type> const& args) const override;
+    };
+
+    // batched_inverse(A): computes inverse(A[i]) for all i
+    class HPX_COMPONENT_EXPORT batched_inverse
+      : public base_primitive
+      , public hpx::components::component_base<batched_inverse>
+    {
+    public:
+        static std::vector<match_pattern_type> const match_data;
+
+        batched_inverse() = default;
+
+        batched_inverse(std::vector<primitive_argument_type>&& operands);
+
+        hpx::future<primitive_result_type> eval(
+            std::vector<primitive_argument_type> const& args) const override;
+    };
+
+    // batched_solve(A, b): solves A[i] * x[i] = b[i] for all i
+    class HPX_COMPONENT_EXPORT batched_solve
+      : public base_primitive
+      , public hpx::components::component_base<batched_solve>
+    {
+    public:
+        static std::vector<match_pattern_type> const match_data;
+
+        batched_solve() = default;
+
+        batched_solve(std::vector<primitive_argument_type>&& operands);
+
+        hpx::future<primitive_result_type> eval(
+            std::vector<primitive_argument_type> const& args) const override;
+    };
+}}}
+
+#endif
@@ -0,0 +1,47 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_DATAFLOW_BLOCK_OPERATION_DEC_13_2017_0218PM)
+#define PHYLANX_PRIMITIVES_DATAFLOW_BLOCK_OPERATION_DEC_13_2017_0218PM
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+
+#include <hpx/include/components.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    // The dataflow_block_operation is created by the compiler for block()
+    // statements which contain independent sub-statements. Each statement is
+    // evaluated as soon as all statements it depends on (as given by the
+    // dependency lists) have been evaluated, the value of the last statement
+    // is returned.
+    class HPX_COMPONENT_EXPORT dataflow_block_operation
+      : public base_primitive
+      , public hpx::components::component_base<dataflow_block_operation>
+    {
+    public:
+        dataflow_block_operation() = default;
+
+        dataflow_block_operation(
+            std::vector<primitive_argument_type>&& operands,
+            std::vector<std::vector<std::size_t>>&& dependencies);
+
+        hpx::future<primitive_result_type> eval(
+            std::vector<primitive_argument_type> const& args) const override;
+        primitive_result_type eval_direct(
+            std::vector<primitive_argument_type> const& args) const override;
+
+    private:
+        std::vector<std::vector<std::size_t>> dependencies_;
+    };
+}}}
+
+#endif
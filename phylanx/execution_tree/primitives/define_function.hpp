@@ -31,6 +31,10 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         define_function(std::string name);
 
+        // The function instance is created on the given locality, an
+        // invalid locality creates it as a plain local object.
+        define_function(std::string name, hpx::id_type locality);
+
         // Create a new instance of the variable and initialize it with the
         // value as returned by evaluating the given body.
         primitive_result_type eval_direct(
@@ -47,6 +51,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
         primitive_argument_type body_;
         mutable primitive_argument_type target_;
         std::string name_;
+        hpx::id_type locality_;
     };
 }}}
 
@@ -29,6 +29,8 @@ namespace phylanx { namespace execution_tree { namespace primitives {
 
         hpx::future<primitive_result_type> eval(
             std::vector<primitive_argument_type> const& args) const override;
+        primitive_result_type eval_direct(
+            std::vector<primitive_argument_type> const& args) const override;
     };
 }}}
 
@@ -0,0 +1,40 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_EINSUM_OPERATION_DEC_05_2017_0322PM)
+#define PHYLANX_PRIMITIVES_EINSUM_OPERATION_DEC_05_2017_0322PM
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/include/components.hpp>
+
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    // einsum(subscripts, a[, b]): evaluates the tensor contraction described
+    // by the given subscripts string (e.g. 'ij,jk->ik'). Only the common
+    // contractions of up to two operands are supported, each of those is
+    // mapped directly onto the corresponding (GEMM/GEMV/dot) kernel.
+    class HPX_COMPONENT_EXPORT einsum_operation
+      : public base_primitive
+      , public hpx::components::component_base<einsum_operation>
+    {
+    public:
+        static std::vector<match_pattern_type> const match_data;
+
+        einsum_operation() = default;
+
+        einsum_operation(std::vector<primitive_argument_type>&& operands);
+
+        hpx::future<primitive_result_type> eval(
+            std::vector<primitive_argument_type> const& args) const override;
+    };
+}}}
+
+#endif
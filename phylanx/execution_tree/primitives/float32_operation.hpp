@@ -0,0 +1,39 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_FLOAT32_OPERATION_DEC_07_2017_1032AM)
+#define PHYLANX_PRIMITIVES_FLOAT32_OPERATION_DEC_07_2017_1032AM
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/include/components.hpp>
+
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    // float32(a): convert a value to single precision storage. Primitives
+    // which do not know about single precision data widen it back to double
+    // on access, dot() computes on it directly while accumulating in double.
+    class HPX_COMPONENT_EXPORT float32_operation
+      : public base_primitive
+      , public hpx::components::component_base<float32_operation>
+    {
+    public:
+        static std::vector<match_pattern_type> const match_data;
+
+        float32_operation() = default;
+
+        float32_operation(std::vector<primitive_argument_type>&& operands);
+
+        hpx::future<primitive_result_type> eval(
+            std::vector<primitive_argument_type> const& args) const override;
+    };
+}}}
+
+#endif
@@ -0,0 +1,63 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_LET_OPERATION_DEC_14_2017_1021AM)
+#define PHYLANX_PRIMITIVES_LET_OPERATION_DEC_14_2017_1021AM
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+
+#include <hpx/include/components.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    // The let_operation is created by the compiler for statements which
+    // contain common subexpressions. Its operands are the common
+    // subexpressions followed by the statement itself. The common
+    // subexpressions are evaluated first (once), their values are appended
+    // to the arguments passed on to the statement. The statement refers to
+    // those using access_temporary.
+    class HPX_COMPONENT_EXPORT let_operation
+      : public base_primitive
+      , public hpx::components::component_base<let_operation>
+    {
+    public:
+        let_operation() = default;
+
+        let_operation(std::vector<primitive_argument_type>&& operands);
+
+        hpx::future<primitive_result_type> eval(
+            std::vector<primitive_argument_type> const& args) const override;
+        primitive_result_type eval_direct(
+            std::vector<primitive_argument_type> const& args) const override;
+    };
+
+    // Access one of the values appended to the arguments by an enclosing
+    // let_operation, the offset is counted from the end of the arguments.
+    class HPX_COMPONENT_EXPORT access_temporary
+      : public base_primitive
+      , public hpx::components::component_base<access_temporary>
+    {
+    public:
+        access_temporary() = default;
+
+        access_temporary(std::size_t offset)
+          : offset_(offset)
+        {}
+
+        primitive_result_type eval_direct(
+            std::vector<primitive_argument_type> const& params) const override;
+
+    private:
+        std::size_t offset_;
+    };
+}}}
+
+#endif
@@ -0,0 +1,43 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_MULTI_DOT_OPERATION_DEC_08_2017_1112AM)
+#define PHYLANX_PRIMITIVES_MULTI_DOT_OPERATION_DEC_08_2017_1112AM
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/include/components.hpp>
+
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    // multi_dot(a, b, c, ...): the product of a chain of matrices. Once the
+    // shapes of all operands are known, the multiplications are reordered
+    // such that the number of floating point operations is minimized. The
+    // first and the last operand may be vectors.
+    //
+    // The compiler rewrites nested invocations of dot() into a single
+    // multi_dot(), e.g. dot(dot(A, B), v) becomes multi_dot(A, B, v).
+    class HPX_COMPONENT_EXPORT multi_dot_operation
+      : public base_primitive
+      , public hpx::components::component_base<multi_dot_operation>
+    {
+    public:
+        static std::vector<match_pattern_type> const match_data;
+
+        multi_dot_operation() = default;
+
+        multi_dot_operation(std::vector<primitive_argument_type>&& operands);
+
+        hpx::future<primitive_result_type> eval(
+            std::vector<primitive_argument_type> const& args) const override;
+    };
+}}}
+
+#endif
@@ -0,0 +1,65 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_PARALLEL_MAP_DEC_12_2017_0314PM)
+#define PHYLANX_PRIMITIVES_PARALLEL_MAP_DEC_12_2017_0314PM
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/include/components.hpp>
+
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    // The parallel primitives below evaluate a function for each element of
+    // an iteration space. The iteration space is partitioned into chunks
+    // which are scheduled onto the HPX thread pool (where idle cores steal
+    // chunks from busy ones). The individual evaluations must not depend on
+    // each other. Both primitives return the list of all results.
+
+    // parallel_for(i, start, stop, body): evaluates 'body' for all values of
+    // 'i' in [start, stop). The compiler binds the loop variable 'i' as the
+    // argument of 'body' following the arguments of the enclosing function,
+    // the primitive itself is therefore created with the operands 'start',
+    // 'stop', 'body', and (optionally) the index of the loop variable in the
+    // argument list (defaults to zero). The arguments of the enclosing
+    // function are passed along to 'body'.
+    class HPX_COMPONENT_EXPORT parallel_for_operation
+      : public base_primitive
+      , public hpx::components::component_base<parallel_for_operation>
+    {
+    public:
+        static std::vector<match_pattern_type> const match_data;
+
+        parallel_for_operation() = default;
+
+        parallel_for_operation(std::vector<primitive_argument_type>&& operands);
+
+        hpx::future<primitive_result_type> eval(
+            std::vector<primitive_argument_type> const& args) const override;
+    };
+
+    // map(f, list): invokes the function 'f' for each element of 'list'
+    class HPX_COMPONENT_EXPORT map_operation
+      : public base_primitive
+      , public hpx::components::component_base<map_operation>
+    {
+    public:
+        static std::vector<match_pattern_type> const match_data;
+
+        map_operation() = default;
+
+        map_operation(std::vector<primitive_argument_type>&& operands);
+
+        hpx::future<primitive_result_type> eval(
+            std::vector<primitive_argument_type> const& args) const override;
+    };
+}}}
+
+#endif
@@ -13,8 +13,12 @@
 
 #include <hpx/include/components.hpp>
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
+#include <blaze/Math.h>
+
 namespace phylanx { namespace execution_tree { namespace primitives
 {
     class HPX_COMPONENT_EXPORT random
@@ -31,6 +35,20 @@ namespace phylanx { namespace execution_tree { namespace primitives
         hpx::future<primitive_result_type> eval(
             std::vector<primitive_argument_type> const& args) const override;
     };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The random number generator shared by random() and the randomized
+    // algorithms (e.g. randomized_svd()). The values are drawn uniformly from
+    // [min, max). Setting the seed makes the results of all of those
+    // reproducible.
+    PHYLANX_EXPORT void set_random_seed(std::uint32_t seed);
+
+    PHYLANX_EXPORT double random_scalar(double min = 0.0, double max = 1.0);
+    PHYLANX_EXPORT blaze::DynamicVector<double> random_vector(
+        std::size_t size, double min = 0.0, double max = 1.0);
+    PHYLANX_EXPORT blaze::DynamicMatrix<double> random_matrix(
+        std::size_t rows, std::size_t columns, double min = 0.0,
+        double max = 1.0);
 }}}
 
 #endif
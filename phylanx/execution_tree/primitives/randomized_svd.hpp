@@ -0,0 +1,41 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_RANDOMIZED_SVD_DEC_07_2017_0245PM)
+#define PHYLANX_PRIMITIVES_RANDOMIZED_SVD_DEC_07_2017_0245PM
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/include/components.hpp>
+
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    // randomized_svd(A, k, oversample = 10, power_iters = 2): compute an
+    // approximation of the top k singular triplets of the matrix A using a
+    // randomized range finder. The result is a list [U, s, Vt] where U is
+    // (rows(A) x k), s holds the k singular values in descending order, and
+    // Vt is (k x columns(A)).
+    class HPX_COMPONENT_EXPORT randomized_svd
+      : public base_primitive
+      , public hpx::components::component_base<randomized_svd>
+    {
+    public:
+        static std::vector<match_pattern_type> const match_data;
+
+        randomized_svd() = default;
+
+        randomized_svd(std::vector<primitive_argument_type>&& operands);
+
+        hpx::future<primitive_result_type> eval(
+            std::vector<primitive_argument_type> const& args) const override;
+    };
+}}}
+
+#endif
@@ -0,0 +1,59 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_RANKED_OPERATION_HPP)
+#define PHYLANX_PRIMITIVES_RANKED_OPERATION_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/include/components.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    namespace detail
+    {
+        struct ranked_kernel_entry;
+    }
+
+    /// A binary operation (add, sub, mul, div, or dot) which is specialized
+    /// for the number of dimensions of its two operands. The compiler
+    /// creates instances of this primitive in place of the generic ones
+    /// whenever the ranks of both operands are known from the type
+    /// inference. The kernel is selected once on construction and is
+    /// invoked directly on every evaluation instead of dispatching on the
+    /// number of dimensions of the operands.
+    class HPX_COMPONENT_EXPORT ranked_operation
+      : public base_primitive
+      , public hpx::components::component_base<ranked_operation>
+    {
+    public:
+        ranked_operation() = default;
+
+        ranked_operation(std::vector<primitive_argument_type>&& operands,
+            std::string const& name, std::size_t lhs_rank,
+            std::size_t rhs_rank);
+
+        /// Return whether there is a kernel implementing the operation of
+        /// the given name for operands of the given ranks.
+        static bool is_supported(std::string const& name,
+            std::size_t lhs_rank, std::size_t rhs_rank);
+
+        hpx::future<primitive_result_type> eval(
+            std::vector<primitive_argument_type> const& params) const override;
+        primitive_result_type eval_direct(
+            std::vector<primitive_argument_type> const& params) const override;
+
+    private:
+        detail::ranked_kernel_entry const* kernel_ = nullptr;
+    };
+}}}
+
+#endif
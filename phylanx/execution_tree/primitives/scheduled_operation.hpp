@@ -0,0 +1,58 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_SCHEDULED_OPERATION_DEC_18_2017_0947AM)
+#define PHYLANX_PRIMITIVES_SCHEDULED_OPERATION_DEC_18_2017_0947AM
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/include/components.hpp>
+#include <hpx/include/threads.hpp>
+
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    // schedule(expr, priority, pool, stacksize): evaluates 'expr' on a new
+    // HPX thread which is created using the given scheduling hints. All
+    // hints are optional string literals, an empty string selects the
+    // default:
+    //
+    //  - priority:  "low", "normal", "high", or "boost"
+    //  - pool:      the name of the thread pool to run on (pools bound to
+    //               a particular NUMA domain are set up using the HPX
+    //               resource partitioner)
+    //  - stacksize: "small", "medium", "large", or "huge"
+    //
+    class HPX_COMPONENT_EXPORT scheduled_operation
+      : public base_primitive
+      , public hpx::components::component_base<scheduled_operation>
+    {
+    public:
+        static std::vector<match_pattern_type> const match_data;
+
+        scheduled_operation() = default;
+
+        scheduled_operation(std::vector<primitive_argument_type>&& operands);
+
+        hpx::future<primitive_result_type> eval(
+            std::vector<primitive_argument_type> const& args) const override;
+        primitive_result_type eval_direct(
+            std::vector<primitive_argument_type> const& args) const override;
+
+    private:
+        hpx::threads::thread_priority priority_ =
+            hpx::threads::thread_priority_default;
+        std::string pool_ = "default";
+        hpx::threads::thread_stacksize stacksize_ =
+            hpx::threads::thread_stacksize_default;
+    };
+}}}
+
+#endif
@@ -8,7 +8,12 @@
 
 #include <phylanx/config.hpp>
 #include <phylanx/execution_tree/compiler/actors.hpp>
+#include <phylanx/execution_tree/compiler/bytecode.hpp>
 #include <phylanx/execution_tree/compiler/compiler.hpp>
+#include <phylanx/execution_tree/compiler/incremental_compiler.hpp>
+#include <phylanx/execution_tree/compiler/pattern_index.hpp>
+#include <phylanx/execution_tree/compiler/type_inference.hpp>
+#include <phylanx/execution_tree/compiler/variable_access.hpp>
 #include <phylanx/execution_tree/compile.hpp>
 
 #endif
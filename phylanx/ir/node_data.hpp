@@ -118,6 +118,32 @@ namespace phylanx { namespace ir
         {
         }
 
+        /// Create node data from a node data holding a different element
+        /// type (converting all elements)
+        template <typename U>
+        explicit node_data(node_data<U> const& d)
+        {
+            switch (d.num_dimensions())
+            {
+            case 0:
+                data_ = storage0d_type(d.scalar());
+                break;
+
+            case 1:
+                data_ = storage1d_type(d.vector());
+                break;
+
+            case 2:
+                data_ = storage2d_type(d.matrix());
+                break;
+
+            default:
+                HPX_THROW_EXCEPTION(hpx::invalid_status,
+                    "phylanx::ir::node_data<T>::node_data<U>()",
+                    "node_data object holds unsupported data type");
+            }
+        }
+
         node_data& operator=(storage0d_type val)
         {
             data_ = val;
@@ -489,6 +515,8 @@ namespace phylanx { namespace ir
 
     PHYLANX_EXPORT std::ostream& operator<<(
         std::ostream& out, node_data<double> const& nd);
+    PHYLANX_EXPORT std::ostream& operator<<(
+        std::ostream& out, node_data<float> const& nd);
 }}
 
 #endif
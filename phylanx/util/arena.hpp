@@ -0,0 +1,155 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_ARENA_HPP)
+#define PHYLANX_UTIL_ARENA_HPP
+
+#include <phylanx/config.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace phylanx { namespace util
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // The shared state of an arena. It is kept alive by the owning arena
+        // and by every object allocated from it, the memory blocks are
+        // released all at once after the last of those went away.
+        class arena_data
+        {
+        public:
+            // every allocation is preceded by a pointer to its arena
+            static constexpr std::size_t header_size =
+                alignof(std::max_align_t);
+
+            PHYLANX_EXPORT explicit arena_data(std::size_t block_size);
+
+            arena_data(arena_data const&) = delete;
+            arena_data& operator=(arena_data const&) = delete;
+
+            // bump-allocate memory for an object of the given size, this may
+            // be called only by the thread which installed the arena
+            void* allocate(std::size_t size)
+            {
+                std::size_t total = header_size +
+                    (size + header_size - 1) / header_size * header_size;
+
+                if (total > static_cast<std::size_t>(end_ - current_))
+                {
+                    new_block(total);
+                }
+
+                char* p = current_;
+                current_ += total;
+
+                add_ref();
+                *reinterpret_cast<arena_data**>(p) = this;
+                return p + header_size;
+            }
+
+            // release memory returned from allocate, may be called on any
+            // thread
+            static void deallocate(void* p)
+            {
+                char* header = static_cast<char*>(p) - header_size;
+                (*reinterpret_cast<arena_data**>(header))->release();
+            }
+
+            void add_ref()
+            {
+                count_.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            void release()
+            {
+                if (count_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    delete this;
+                }
+            }
+
+            std::size_t num_blocks() const
+            {
+                return blocks_.size();
+            }
+
+        private:
+            PHYLANX_EXPORT void new_block(std::size_t size);
+
+            std::atomic<std::size_t> count_;
+            std::size_t block_size_;
+            std::vector<std::unique_ptr<char[]>> blocks_;
+            char* current_;
+            char* end_;
+        };
+
+        // the arena used for allocations on the current (OS-)thread, if any
+        PHYLANX_EXPORT arena_data*& current_arena();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A bump allocator for recursive_wrapper instances (i.e. for the nodes
+    /// of an AST). All objects allocated while an \a arena_scope referring
+    /// to the arena is active are placed into a few contiguous memory
+    /// blocks, which are freed at once after the arena and all of those
+    /// objects have been destroyed (the objects may outlive the arena).
+    class arena
+    {
+    public:
+        explicit arena(std::size_t block_size = 64 * 1024)
+          : data_(new detail::arena_data(block_size))
+        {
+        }
+
+        ~arena()
+        {
+            data_->release();
+        }
+
+        arena(arena const&) = delete;
+        arena& operator=(arena const&) = delete;
+
+        /// Return the number of memory blocks allocated so far
+        std::size_t num_blocks() const
+        {
+            return data_->num_blocks();
+        }
+
+    private:
+        friend class arena_scope;
+
+        detail::arena_data* data_;
+    };
+
+    /// Make the given arena the one used for allocations on the current
+    /// (OS-)thread for the lifetime of this object. The scope must not
+    /// span any operation which may suspend the current HPX thread.
+    class arena_scope
+    {
+    public:
+        explicit arena_scope(arena& a)
+          : previous_(detail::current_arena())
+        {
+            detail::current_arena() = a.data_;
+        }
+
+        ~arena_scope()
+        {
+            detail::current_arena() = previous_;
+        }
+
+        arena_scope(arena_scope const&) = delete;
+        arena_scope& operator=(arena_scope const&) = delete;
+
+    private:
+        detail::arena_data* previous_;
+    };
+}}
+
+#endif
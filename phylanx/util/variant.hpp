@@ -8,8 +8,13 @@
 #define PHYLANX_UTIL_VARIANT_HPP
 
 #include <phylanx/config.hpp>
+#include <phylanx/util/arena.hpp>
 #include <phylanx/util/detail/variant.hpp>
 
+#include <cstdint>
+#include <new>
+#include <utility>
+
 namespace phylanx { namespace util
 {
     using mpark::variant;
@@ -29,37 +34,80 @@ namespace phylanx { namespace util
         using type = T;
 
     private:    // representation
+        // objects allocated from an arena are marked by setting the lowest
+        // bit of the pointer
         T* p_;
 
+        template <typename... Ts>
+        static T* allocate(Ts&&... ts)
+        {
+            static_assert(alignof(T) > 1,
+                "recursive_wrapper<T> requires T to be aligned to at least "
+                "two bytes");
+
+            detail::arena_data* arena = detail::current_arena();
+            if (arena == nullptr)
+            {
+                return new T(std::forward<Ts>(ts)...);
+            }
+
+            void* p = arena->allocate(sizeof(T));
+            try
+            {
+                T* t = new (p) T(std::forward<Ts>(ts)...);
+                return reinterpret_cast<T*>(
+                    reinterpret_cast<std::uintptr_t>(t) | 1);
+            }
+            catch (...)
+            {
+                detail::arena_data::deallocate(p);
+                throw;
+            }
+        }
+
+        static void deallocate(T* p)
+        {
+            std::uintptr_t value = reinterpret_cast<std::uintptr_t>(p);
+            if ((value & 1) == 0)
+            {
+                delete p;
+                return;
+            }
+
+            T* t = reinterpret_cast<T*>(value & ~std::uintptr_t(1));
+            t->~T();
+            detail::arena_data::deallocate(t);
+        }
+
     public:
         ~recursive_wrapper()
         {
-            delete p_;
+            deallocate(p_);
         }
 
         recursive_wrapper()
-          : p_(new T)
+          : p_(allocate())
         {
         }
 
         recursive_wrapper(recursive_wrapper const& operand)
-          : p_(new T(operand.get()))
+          : p_(allocate(operand.get()))
         {
         }
 
         recursive_wrapper(T const& operand)
-          : p_(new T(operand))
+          : p_(allocate(operand))
         {
         }
 
         recursive_wrapper(recursive_wrapper && operand)
-          : p_(new T)
+          : p_(allocate())
         {
             swap(operand);
         }
 
         recursive_wrapper(T && operand)
-          : p_(new T(std::move(operand)))
+          : p_(allocate(std::move(operand)))
         {
         }
 
@@ -111,11 +159,13 @@ namespace phylanx { namespace util
 
         T* get_pointer()
         {
-            return p_;
+            return reinterpret_cast<T*>(
+                reinterpret_cast<std::uintptr_t>(p_) & ~std::uintptr_t(1));
         }
         T const* get_pointer() const
         {
-            return p_;
+            return reinterpret_cast<T const*>(
+                reinterpret_cast<std::uintptr_t>(p_) & ~std::uintptr_t(1));
         }
     };
 
@@ -7,7 +7,9 @@
 #include <phylanx/ast/generate_ast.hpp>
 #include <phylanx/ast/node.hpp>
 #include <phylanx/ast/parser/expression.hpp>
+#include <phylanx/ast/parser/recursive_descent.hpp>
 #include <phylanx/ast/parser/skipper.hpp>
+#include <phylanx/util/arena.hpp>
 
 #include <hpx/throw_exception.hpp>
 
@@ -15,10 +17,35 @@
 
 #include <sstream>
 #include <string>
+#include <vector>
 
 namespace phylanx { namespace ast
 {
     ast::expression generate_ast(std::string const& input)
+    {
+        return ast::parser::parse_expression(input);
+    }
+
+    std::vector<ast::expression> generate_asts(std::string const& input)
+    {
+        return ast::parser::parse_expressions(input);
+    }
+
+    ast::expression generate_ast(std::string const& input, util::arena& arena)
+    {
+        util::arena_scope scope(arena);
+        return ast::parser::parse_expression(input);
+    }
+
+    std::vector<ast::expression> generate_asts(
+        std::string const& input, util::arena& arena)
+    {
+        util::arena_scope scope(arena);
+        return ast::parser::parse_expressions(input);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    ast::expression generate_ast_spirit(std::string const& input)
     {
         using iterator = std::string::const_iterator;
 
@@ -50,7 +77,8 @@ namespace phylanx { namespace ast
         return ast;
     }
 
-    std::vector<ast::expression> generate_asts(std::string const& input)
+    std::vector<ast::expression> generate_asts_spirit(
+        std::string const& input)
     {
         using iterator = std::string::const_iterator;
 
@@ -0,0 +1,759 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/ast/parser/error_handler.hpp>
+#include <phylanx/ast/parser/recursive_descent.hpp>
+
+#include <hpx/throw_exception.hpp>
+
+#include <boost/spirit/include/qi.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace ast { namespace parser
+{
+    namespace detail
+    {
+        using iterator = std::string::const_iterator;
+
+        // thrown if the input doesn't match after an expectation point
+        // (corresponds to '>' in the Spirit grammar)
+        struct expectation_failure
+        {
+            iterator pos;
+            char const* what;
+        };
+
+        inline bool is_space(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r' ||
+                c == '\v' || c == '\f';
+        }
+
+        inline bool is_digit(char c)
+        {
+            return c >= '0' && c <= '9';
+        }
+
+        inline bool is_identifier_start(char c)
+        {
+            return std::isalpha(static_cast<unsigned char>(c)) || c == '_';
+        }
+
+        inline bool is_identifier_char(char c)
+        {
+            return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // The functions below mirror the rules of the Spirit grammar, each
+        // of them returns false (without consuming any input) if the rule
+        // doesn't match.
+        class recursive_descent
+        {
+        public:
+            recursive_descent(std::string const& input)
+              : first_(input.begin())
+              , it_(input.begin())
+              , last_(input.end())
+            {}
+
+            iterator first() const { return first_; }
+            iterator last() const { return last_; }
+            iterator pos() const { return it_; }
+
+            // expr = unary_expr >> *(binary_op > unary_expr)
+            bool expr(ast::expression& result)
+            {
+                ast::operand first;
+                if (!unary_expr(first))
+                {
+                    return false;
+                }
+
+                result.first = std::move(first);
+                result.rest.clear();
+
+                while (true)
+                {
+                    iterator save = it_;
+                    skip();
+
+                    ast::optoken op;
+                    if (!binary_op(op))
+                    {
+                        it_ = save;
+                        break;
+                    }
+
+                    ast::operand operand;
+                    if (!unary_expr(operand))
+                    {
+                        throw expectation_failure{it_, "<unary_expr>"};
+                    }
+                    result.rest.emplace_back(op, std::move(operand));
+                }
+                return true;
+            }
+
+            // skip whitespace and comments
+            void skip()
+            {
+                while (it_ != last_)
+                {
+                    if (is_space(*it_))
+                    {
+                        ++it_;
+                        continue;
+                    }
+
+                    if (*it_ != '/' || last_ - it_ < 2)
+                    {
+                        return;
+                    }
+
+                    if (it_[1] == '*')
+                    {
+                        // C-style comment, must be terminated
+                        iterator it = it_ + 2;
+                        while (last_ - it >= 2 &&
+                            !(it[0] == '*' && it[1] == '/'))
+                        {
+                            ++it;
+                        }
+                        if (last_ - it < 2)
+                        {
+                            return;
+                        }
+                        it_ = it + 2;
+                    }
+                    else if (it_[1] == '/')
+                    {
+                        // C++-style comment, must be terminated by an eol
+                        iterator it = it_ + 2;
+                        while (it != last_ && *it != '\r' && *it != '\n')
+                        {
+                            ++it;
+                        }
+                        if (it == last_)
+                        {
+                            return;
+                        }
+                        if (*it == '\r' && it + 1 != last_ && it[1] == '\n')
+                        {
+                            ++it;
+                        }
+                        it_ = it + 1;
+                    }
+                    else
+                    {
+                        return;
+                    }
+                }
+            }
+
+        private:
+            // unary_expr = primary_expr | (unary_op > unary_expr)
+            bool unary_expr(ast::operand& result)
+            {
+                iterator save = it_;
+                skip();
+
+                if (primary_expr(result))
+                {
+                    return true;
+                }
+
+                ast::optoken op;
+                switch (it_ != last_ ? *it_ : '\0')
+                {
+                case '+': op = ast::optoken::op_positive; break;
+                case '-': op = ast::optoken::op_negative; break;
+                case '!': op = ast::optoken::op_not; break;
+                default:
+                    it_ = save;
+                    return false;
+                }
+                ++it_;
+
+                ast::operand operand;
+                if (!unary_expr(operand))
+                {
+                    throw expectation_failure{it_, "<unary_expr>"};
+                }
+
+                result = ast::operand(ast::unary_expr(op, std::move(operand)));
+                return true;
+            }
+
+            // primary_expr = strict_double | function_call | list |
+            //     identifier | bool_ | ulong_long | string | '(' > expr > ')'
+            bool primary_expr(ast::operand& result)
+            {
+                if (it_ == last_)
+                {
+                    return false;
+                }
+
+                double d = 0.0;
+                if (strict_double(d))
+                {
+                    result = ast::operand(ast::primary_expr(d));
+                    return true;
+                }
+
+                std::string name;
+                if (identifier(name))
+                {
+                    iterator save = it_;
+                    skip();
+
+                    if (it_ != last_ && *it_ == '(')
+                    {
+                        ++it_;
+
+                        ast::function_call fc(ast::identifier(std::move(name)));
+                        argument_list(fc.args);
+                        expect(')', "')'");
+
+                        result = ast::operand(ast::primary_expr(std::move(fc)));
+                        return true;
+                    }
+
+                    it_ = save;
+                    result = ast::operand(
+                        ast::primary_expr(ast::identifier(std::move(name))));
+                    return true;
+                }
+
+                if (*it_ == '\'')
+                {
+                    iterator save = it_;
+                    ++it_;
+                    skip();
+
+                    if (it_ != last_ && *it_ == '(')
+                    {
+                        ++it_;
+
+                        std::vector<ast::expression> elements;
+                        argument_list(elements);
+                        expect(')', "')'");
+
+                        result = ast::operand(
+                            ast::primary_expr(std::move(elements)));
+                        return true;
+                    }
+                    it_ = save;
+                }
+
+                bool b = false;
+                if (boolean(b))
+                {
+                    result = ast::operand(ast::primary_expr(b));
+                    return true;
+                }
+
+                std::uint64_t n = 0;
+                if (ulong_long(n))
+                {
+                    result = ast::operand(ast::primary_expr(n));
+                    return true;
+                }
+
+                std::string s;
+                if (string_literal(s))
+                {
+                    result = ast::operand(ast::primary_expr(std::move(s)));
+                    return true;
+                }
+
+                if (*it_ == '(')
+                {
+                    ++it_;
+
+                    ast::expression e;
+                    if (!expr(e))
+                    {
+                        skip();
+                        throw expectation_failure{it_, "<expr>"};
+                    }
+                    expect(')', "')'");
+
+                    result = ast::operand(ast::primary_expr(std::move(e)));
+                    return true;
+                }
+
+                return false;
+            }
+
+            // argument_list = -(expr % ',')
+            void argument_list(std::vector<ast::expression>& args)
+            {
+                ast::expression arg;
+                if (!expr(arg))
+                {
+                    return;
+                }
+                args.push_back(std::move(arg));
+
+                while (true)
+                {
+                    iterator save = it_;
+                    skip();
+
+                    if (it_ == last_ || *it_ != ',')
+                    {
+                        it_ = save;
+                        return;
+                    }
+                    ++it_;
+
+                    if (!expr(arg))
+                    {
+                        it_ = save;
+                        return;
+                    }
+                    args.push_back(std::move(arg));
+                }
+            }
+
+            void expect(char c, char const* what)
+            {
+                skip();
+                if (it_ == last_ || *it_ != c)
+                {
+                    throw expectation_failure{it_, what};
+                }
+                ++it_;
+            }
+
+            // identifier = !lexeme[keywords >> !(alnum | '_')] >>
+            //     raw[lexeme[(alpha | '_') >> *(alnum | '_')]]
+            bool identifier(std::string& name)
+            {
+                if (it_ == last_ || !is_identifier_start(*it_))
+                {
+                    return false;
+                }
+
+                iterator it = it_ + 1;
+                while (it != last_ && is_identifier_char(*it))
+                {
+                    ++it;
+                }
+
+                if (is_keyword(it_, it))
+                {
+                    return false;
+                }
+
+                name.assign(it_, it);
+                it_ = it;
+                return true;
+            }
+
+            static bool is_keyword(iterator first, iterator last)
+            {
+                std::size_t size = last - first;
+                return (size == 4 && std::equal(first, last, "true")) ||
+                    (size == 5 && std::equal(first, last, "false"));
+            }
+
+            bool boolean(bool& b)
+            {
+                iterator it = it_;
+                if (match(it, "true"))
+                {
+                    b = true;
+                }
+                else if (match(it, "false"))
+                {
+                    b = false;
+                }
+                else
+                {
+                    return false;
+                }
+                it_ = it;
+                return true;
+            }
+
+            // unsigned integer, fails on overflow
+            bool ulong_long(std::uint64_t& n)
+            {
+                iterator it = it_;
+                std::uint64_t value = 0;
+                while (it != last_ && is_digit(*it))
+                {
+                    std::uint64_t digit = *it - '0';
+                    if (value > (std::numeric_limits<std::uint64_t>::max() -
+                            digit) / 10)
+                    {
+                        return false;
+                    }
+                    value = value * 10 + digit;
+                    ++it;
+                }
+
+                if (it == it_)
+                {
+                    return false;
+                }
+
+                n = value;
+                it_ = it;
+                return true;
+            }
+
+            // string = '"' > raw[lexeme[+(char_ - '"')]] > '"'
+            bool string_literal(std::string& s)
+            {
+                if (*it_ != '"')
+                {
+                    return false;
+                }
+                ++it_;
+
+                // lexeme[] performs a pre-skip
+                skip();
+
+                iterator begin = it_;
+                while (it_ != last_ && *it_ != '"')
+                {
+                    ++it_;
+                }
+                if (it_ == begin)
+                {
+                    throw expectation_failure{it_, "<raw>"};
+                }
+                s.assign(begin, it_);
+
+                expect('"', "'\"'");
+                return true;
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            // Real number requiring a dot or an exponent, including nan and
+            // inf (this mirrors qi::strict_real_policies<double>).
+            bool strict_double(double& d)
+            {
+                iterator it = it_;
+                bool neg = false;
+                if (it != last_ && (*it == '+' || *it == '-'))
+                {
+                    neg = (*it == '-');
+                    ++it;
+                }
+
+                iterator number = it;
+                bool got_a_number = digits(it) != 0;
+                if (!got_a_number)
+                {
+                    if (nan_or_inf(it, d))
+                    {
+                        d = neg ? -d : d;
+                        it_ = it;
+                        return true;
+                    }
+                }
+
+                bool e_hit = false;
+                iterator e_pos;
+                if (it != last_ && *it == '.')
+                {
+                    ++it;
+                    if (digits(it) == 0 && !got_a_number)
+                    {
+                        return false;
+                    }
+                    e_pos = it;
+                    e_hit = exponent_prefix(it);
+                }
+                else
+                {
+                    if (!got_a_number)
+                    {
+                        return false;
+                    }
+                    e_pos = it;
+                    e_hit = exponent_prefix(it);
+                    if (!e_hit)
+                    {
+                        return false;
+                    }
+                }
+
+                if (e_hit)
+                {
+                    // disregard the exponent prefix if no exponent follows
+                    iterator exp = it;
+                    if (exp != last_ && (*exp == '+' || *exp == '-'))
+                    {
+                        ++exp;
+                    }
+                    it = (digits(exp) != 0) ? exp : e_pos;
+                }
+
+                // convert the scanned characters in place using the same
+                // (locale independent) conversion as the Spirit parser
+                boost::spirit::qi::parse(number, it,
+                    boost::spirit::qi::real_parser<double,
+                        boost::spirit::qi::strict_real_policies<double>>(),
+                    d);
+                d = neg ? -d : d;
+                it_ = it;
+                return true;
+            }
+
+            std::size_t digits(iterator& it) const
+            {
+                iterator begin = it;
+                while (it != last_ && is_digit(*it))
+                {
+                    ++it;
+                }
+                return it - begin;
+            }
+
+            bool exponent_prefix(iterator& it) const
+            {
+                if (it != last_ && (*it == 'e' || *it == 'E'))
+                {
+                    ++it;
+                    return true;
+                }
+                return false;
+            }
+
+            bool nan_or_inf(iterator& it, double& d) const
+            {
+                iterator i = it;
+                if (match_nocase(i, "nan"))
+                {
+                    // skip optional trailing (...)
+                    if (i != last_ && *i == '(')
+                    {
+                        iterator close = i;
+                        while (++close != last_ && *close != ')')
+                            /**/;
+                        if (close == last_)
+                        {
+                            return false;
+                        }
+                        i = ++close;
+                    }
+                    d = std::numeric_limits<double>::quiet_NaN();
+                    it = i;
+                    return true;
+                }
+
+                if (match_nocase(i, "inf"))
+                {
+                    match_nocase(i, "inity");
+                    d = std::numeric_limits<double>::infinity();
+                    it = i;
+                    return true;
+                }
+                return false;
+            }
+
+            bool match(iterator& it, char const* str) const
+            {
+                iterator i = it;
+                for (/**/; *str != '\0'; ++str, ++i)
+                {
+                    if (i == last_ || *i != *str)
+                    {
+                        return false;
+                    }
+                }
+                it = i;
+                return true;
+            }
+
+            bool match_nocase(iterator& it, char const* str) const
+            {
+                iterator i = it;
+                for (/**/; *str != '\0'; ++str, ++i)
+                {
+                    if (i == last_ || std::tolower(
+                            static_cast<unsigned char>(*i)) != *str)
+                    {
+                        return false;
+                    }
+                }
+                it = i;
+                return true;
+            }
+
+            // binary operators, the longest one matches
+            bool binary_op(ast::optoken& op)
+            {
+                if (it_ == last_)
+                {
+                    return false;
+                }
+
+                char next = (last_ - it_ > 1) ? it_[1] : '\0';
+                std::size_t length = 1;
+                switch (*it_)
+                {
+                case '|':
+                    if (next != '|') return false;
+                    op = ast::optoken::op_logical_or;
+                    length = 2;
+                    break;
+
+                case '&':
+                    if (next != '&') return false;
+                    op = ast::optoken::op_logical_and;
+                    length = 2;
+                    break;
+
+                case '=':
+                    if (next != '=') return false;
+                    op = ast::optoken::op_equal;
+                    length = 2;
+                    break;
+
+                case '!':
+                    if (next != '=') return false;
+                    op = ast::optoken::op_not_equal;
+                    length = 2;
+                    break;
+
+                case '<':
+                    if (next == '=')
+                    {
+                        op = ast::optoken::op_less_equal;
+                        length = 2;
+                    }
+                    else
+                    {
+                        op = ast::optoken::op_less;
+                    }
+                    break;
+
+                case '>':
+                    if (next == '=')
+                    {
+                        op = ast::optoken::op_greater_equal;
+                        length = 2;
+                    }
+                    else
+                    {
+                        op = ast::optoken::op_greater;
+                    }
+                    break;
+
+                case '+': op = ast::optoken::op_plus; break;
+                case '-': op = ast::optoken::op_minus; break;
+                case '*': op = ast::optoken::op_times; break;
+                case '/': op = ast::optoken::op_divide; break;
+
+                default:
+                    return false;
+                }
+
+                it_ += length;
+                return true;
+            }
+
+            iterator first_;
+            iterator it_;
+            iterator last_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        void report_error(recursive_descent const& p,
+            char const* message, char const* what, iterator pos,
+            char const* function)
+        {
+            std::stringstream strm;
+            error_handler<iterator> handler(p.first(), p.last(), strm);
+            handler(message, what, pos);
+
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, function, strm.str());
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    ast::expression parse_expression(std::string const& input)
+    {
+        detail::recursive_descent p(input);
+
+        ast::expression result;
+        try
+        {
+            if (!p.expr(result))
+            {
+                p.skip();
+                detail::report_error(p, "Error! Expecting ", "<expr>",
+                    p.pos(), "phylanx::ast::parser::parse_expression");
+            }
+        }
+        catch (detail::expectation_failure const& e)
+        {
+            detail::report_error(p, "Error! Expecting ", e.what, e.pos,
+                "phylanx::ast::parser::parse_expression");
+        }
+
+        p.skip();
+        if (p.pos() != p.last())
+        {
+            detail::report_error(p, "Error! ", "Incomplete parse:", p.pos(),
+                "phylanx::ast::parser::parse_expression");
+        }
+
+        return result;
+    }
+
+    std::vector<ast::expression> parse_expressions(std::string const& input)
+    {
+        detail::recursive_descent p(input);
+
+        std::vector<ast::expression> result;
+        try
+        {
+            ast::expression expr;
+            while (p.expr(expr))
+            {
+                result.push_back(std::move(expr));
+            }
+
+            if (result.empty())
+            {
+                p.skip();
+                detail::report_error(p, "Error! Expecting ", "<expr>",
+                    p.pos(), "phylanx::ast::parser::parse_expressions");
+            }
+        }
+        catch (detail::expectation_failure const& e)
+        {
+            detail::report_error(p, "Error! Expecting ", e.what, e.pos,
+                "phylanx::ast::parser::parse_expressions");
+        }
+
+        p.skip();
+        if (p.pos() != p.last())
+        {
+            detail::report_error(p, "Error! ", "Incomplete parse:", p.pos(),
+                "phylanx::ast::parser::parse_expressions");
+        }
+
+        return result;
+    }
+}}}
@@ -7,13 +7,18 @@
 #include <phylanx/ast/generate_ast.hpp>
 #include <phylanx/ast/node.hpp>
 #include <phylanx/execution_tree/compile.hpp>
+#include <phylanx/execution_tree/compiler/bytecode.hpp>
 #include <phylanx/execution_tree/compiler/compiler.hpp>
+#include <phylanx/execution_tree/compiler/pattern_index.hpp>
+#include <phylanx/execution_tree/compiler/type_inference.hpp>
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/util/arena.hpp>
 
 #include <hpx/include/naming.hpp>
 
 #include <algorithm>
 #include <cstddef>
+#include <memory>
 
 namespace phylanx { namespace execution_tree
 {
@@ -22,53 +27,87 @@ namespace phylanx { namespace execution_tree
         compiler::function_list& snippets, compiler::environment& env,
         hpx::id_type const& default_locality)
     {
-        pattern_list const& patterns = get_all_known_patterns();
+        auto patterns = get_all_known_expression_patterns();
         return compiler::compile(expr, snippets, env,
-            compiler::generate_patterns(patterns), default_locality);
+            *patterns, default_locality);
     }
 
     compiler::function compile(std::vector<ast::expression> const& exprs,
         compiler::function_list& snippets, compiler::environment& env,
         hpx::id_type const& default_locality)
     {
-        pattern_list const& patterns = get_all_known_patterns();
+        auto patterns = get_all_known_expression_patterns();
         return compiler::compile(exprs, snippets, env,
-            compiler::generate_patterns(patterns), default_locality);
+            *patterns, default_locality);
     }
 
     compiler::function compile(std::string const& expr,
         compiler::function_list& snippets, compiler::environment& env,
         hpx::id_type const& default_locality)
     {
-        return compile(
-            ast::generate_asts(expr), snippets, env, default_locality);
+        // the parsed expressions are needed during compilation only
+        util::arena arena;
+        return compile(ast::generate_asts(expr, arena), snippets, env,
+            default_locality);
     }
 
     ///////////////////////////////////////////////////////////////////////////
     compiler::function compile(ast::expression const& expr,
         compiler::function_list& snippets, hpx::id_type const& default_locality)
     {
-        pattern_list const& patterns = get_all_known_patterns();
+        auto patterns = get_all_known_expression_patterns();
         compiler::environment env =
-            compiler::default_environment(default_locality);
+            compiler::default_environment(*patterns, default_locality);
         return compiler::compile(expr, snippets, env,
-            compiler::generate_patterns(patterns), default_locality);
+            *patterns, default_locality);
     }
 
     compiler::function compile(std::vector<ast::expression> const& exprs,
         compiler::function_list& snippets, hpx::id_type const& default_locality)
     {
-        pattern_list const& patterns = get_all_known_patterns();
+        auto patterns = get_all_known_expression_patterns();
         compiler::environment env =
-            compiler::default_environment(default_locality);
+            compiler::default_environment(*patterns, default_locality);
         return compiler::compile(exprs, snippets, env,
-            compiler::generate_patterns(patterns), default_locality);
+            *patterns, default_locality);
     }
 
     compiler::function compile(std::string const& expr,
         compiler::function_list& snippets, hpx::id_type const& default_locality)
     {
-        return compile(ast::generate_asts(expr), snippets, default_locality);
+        util::arena arena;
+        return compile(
+            ast::generate_asts(expr, arena), snippets, default_locality);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    compiler::type_map infer_types(
+        std::string const& expr, compiler::type_map const& variables)
+    {
+        auto patterns = get_all_known_expression_patterns();
+        compiler::pattern_index index(*patterns);
+
+        util::arena arena;
+        return compiler::infer_types(
+            ast::generate_asts(expr, arena), index, variables);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    compiler::bytecode_program compile_bytecode(ast::expression const& expr,
+        compiler::function_list& snippets, hpx::id_type const& default_locality)
+    {
+        auto patterns = get_all_known_expression_patterns();
+        compiler::environment env =
+            compiler::default_environment(*patterns, default_locality);
+        return compiler::lower(expr, snippets, env,
+            *patterns, default_locality);
     }
-}}
 
+    compiler::bytecode_program compile_bytecode(std::string const& expr,
+        compiler::function_list& snippets, hpx::id_type const& default_locality)
+    {
+        util::arena arena;
+        return compile_bytecode(
+            ast::generate_ast(expr, arena), snippets, default_locality);
+    }
+}}
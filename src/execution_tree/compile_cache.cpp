@@ -0,0 +1,199 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/generate_ast.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/execution_tree/compile.hpp>
+
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/local_lcos.hpp>
+#include <hpx/include/naming.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree
+{
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        using mutex_type = hpx::lcos::local::spinlock;
+
+        // The compiled primitives keep the state of the variables they
+        // define, an instance which has been evaluated can't be handed out
+        // again. Each entry therefore compiles the expression only once into
+        // an image of the execution tree (see compile_to_image), every
+        // request restores a new instance from that image. Expressions
+        // which can't be stored in an image are compiled for every request.
+        class compile_cache_entry
+        {
+            using image_type = std::shared_ptr<std::vector<char> const>;
+
+        public:
+            explicit compile_cache_entry(std::string const& expr)
+              : asts_(ast::generate_asts(expr))
+            {}
+
+            std::shared_ptr<compiled_expression> acquire(
+                hpx::id_type const& default_locality)
+            {
+                image_type image = get_image().get();
+                if (image)
+                {
+                    return load_compiled(*image, default_locality);
+                }
+
+                auto result = std::make_shared<compiled_expression>();
+                result->f = execution_tree::compile(
+                    asts_, result->snippets, default_locality);
+                return result;
+            }
+
+        private:
+            // the image is created once, concurrent requests wait for it (the
+            // requesting thread waits as well, which keeps asts_ alive)
+            hpx::shared_future<image_type> get_image()
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                if (!image_.valid())
+                {
+                    image_ = hpx::async(
+                        [](std::vector<ast::expression> const& asts)
+                        -> image_type
+                        {
+                            try
+                            {
+                                return std::make_shared<
+                                    std::vector<char> const>(
+                                        compile_to_image(asts));
+                            }
+                            catch (...)
+                            {
+                                // trees which can't be stored are compiled
+                                // for each request (which reports errors)
+                            }
+                            return image_type();
+                        },
+                        std::cref(asts_));
+                }
+                return image_;
+            }
+
+            std::vector<ast::expression> const asts_;
+
+            mutex_type mtx_;
+            hpx::shared_future<image_type> image_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // The least recently used entries are evicted once the cache holds
+        // more than the given number of expressions.
+        class compile_cache
+        {
+            using entry_list = std::list<
+                std::pair<std::string, std::shared_ptr<compile_cache_entry>>>;
+
+        public:
+            explicit compile_cache(std::size_t capacity)
+              : capacity_(capacity)
+            {}
+
+            std::shared_ptr<compile_cache_entry> get(std::string const& expr)
+            {
+                {
+                    std::lock_guard<mutex_type> l(mtx_);
+                    auto it = index_.find(expr);
+                    if (it != index_.end())
+                    {
+                        entries_.splice(entries_.begin(), entries_, it->second);
+                        return it->second->second;
+                    }
+                }
+
+                // parse the expression outside of the lock
+                auto entry = std::make_shared<compile_cache_entry>(expr);
+
+                std::lock_guard<mutex_type> l(mtx_);
+                auto it = index_.find(expr);
+                if (it != index_.end())
+                {
+                    entries_.splice(entries_.begin(), entries_, it->second);
+                    return it->second->second;
+                }
+
+                entries_.emplace_front(expr, entry);
+                index_.emplace(expr, entries_.begin());
+                evict();
+
+                return entry;
+            }
+
+            void set_capacity(std::size_t capacity)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                capacity_ = capacity;
+                evict();
+            }
+
+            void clear()
+            {
+                entry_list entries;
+                {
+                    std::lock_guard<mutex_type> l(mtx_);
+                    std::swap(entries, entries_);
+                    index_.clear();
+                }
+            }
+
+        private:
+            void evict()
+            {
+                while (entries_.size() > capacity_)
+                {
+                    index_.erase(entries_.back().first);
+                    entries_.pop_back();
+                }
+            }
+
+            mutex_type mtx_;
+            std::size_t capacity_;
+            entry_list entries_;
+            std::unordered_map<std::string, entry_list::iterator> index_;
+        };
+
+        compile_cache& get_compile_cache()
+        {
+            static compile_cache cache(128);
+            return cache;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::shared_ptr<compiled_expression> compile_cached(
+        std::string const& expr, hpx::id_type const& default_locality)
+    {
+        return detail::get_compile_cache().get(expr)->acquire(
+            default_locality);
+    }
+
+    void set_compile_cache_capacity(std::size_t capacity)
+    {
+        detail::get_compile_cache().set_capacity(capacity);
+    }
+
+    void clear_compile_cache()
+    {
+        detail::get_compile_cache().clear();
+    }
+}}
@@ -0,0 +1,768 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/detail/is_identifier.hpp>
+#include <phylanx/ast/detail/is_literal_value.hpp>
+#include <phylanx/ast/match_ast.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/ast/traverse.hpp>
+#include <phylanx/execution_tree/compiler/actors.hpp>
+#include <phylanx/execution_tree/compiler/bytecode.hpp>
+#include <phylanx/execution_tree/compiler/compiler.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/include/naming.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace compiler
+{
+    namespace bytecode
+    {
+        ///////////////////////////////////////////////////////////////////////
+        value::value(primitive_argument_type && val)
+          : kind(object)
+          , data(0.0)
+        {
+            switch (val.index())
+            {
+            case 1:     // bool
+                kind = boolean;
+                data = util::get<1>(val) ? 1.0 : 0.0;
+                return;
+
+            case 2:     // std::int64_t
+                kind = integer;
+                data = double(util::get<2>(val));
+                obj = std::move(val);       // keep exact value
+                return;
+
+            case 4:     // ir::node_data<double>
+                {
+                    auto const& nd = util::get<4>(val);
+                    if (nd.num_dimensions() == 0)
+                    {
+                        kind = scalar;
+                        data = nd.scalar();
+                        return;
+                    }
+                }
+                break;
+
+            default:
+                break;
+            }
+
+            obj = std::move(val);
+        }
+
+        primitive_argument_type value::to_argument() const
+        {
+            switch (kind)
+            {
+            case scalar:
+                return primitive_argument_type{ir::node_data<double>{data}};
+
+            case boolean:
+                return primitive_argument_type{data != 0.0};
+
+            default:
+                break;
+            }
+            return obj;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        using bytecode::value;
+
+        inline bool is_number(value const& v)
+        {
+            return v.kind == value::scalar || v.kind == value::integer;
+        }
+
+        inline bool is_unboxed(value const& v)
+        {
+            return v.kind != value::object;
+        }
+
+        inline void set_value(value& v, value::kind_type kind, double data)
+        {
+            v.kind = kind;
+            v.data = data;
+            if (v.obj.index() != 0)
+            {
+                v.obj = primitive_argument_type{};
+            }
+        }
+
+        inline bool is_true(value const& v)
+        {
+            if (is_unboxed(v))
+            {
+                return v.data != 0.0;
+            }
+            return extract_boolean_value(v.obj) != 0;
+        }
+
+        value call_fallback(bytecode::fallback const& fb,
+            std::vector<value> const& slots)
+        {
+            arguments_type args;
+            args.reserve(fb.slots.size());
+            for (std::uint32_t slot : fb.slots)
+            {
+                args.push_back(slots[slot].to_argument());
+            }
+            return value(fb.f(std::move(args)));
+        }
+
+        // execute the given operation directly if all operands are
+        // scalars, return false otherwise
+        bool execute_unboxed(bytecode::opcode op, value const& lhs,
+            value const& rhs, value& dest)
+        {
+            using bytecode::opcode;
+
+            switch (op)
+            {
+            case opcode::add:
+                if (!is_number(lhs) || !is_number(rhs))
+                    return false;
+                set_value(dest, value::scalar, lhs.data + rhs.data);
+                return true;
+
+            case opcode::sub:
+                if (!is_number(lhs) || !is_number(rhs))
+                    return false;
+                set_value(dest, value::scalar, lhs.data - rhs.data);
+                return true;
+
+            case opcode::mul:
+                if (!is_number(lhs) || !is_number(rhs))
+                    return false;
+                set_value(dest, value::scalar, lhs.data * rhs.data);
+                return true;
+
+            case opcode::div:
+                if (!is_number(lhs) || !is_number(rhs))
+                    return false;
+                set_value(dest, value::scalar, lhs.data / rhs.data);
+                return true;
+
+            case opcode::less:
+                if (!is_number(lhs) || !is_number(rhs))
+                    return false;
+                set_value(dest, value::boolean, lhs.data < rhs.data);
+                return true;
+
+            case opcode::less_equal:
+                if (!is_number(lhs) || !is_number(rhs))
+                    return false;
+                set_value(dest, value::boolean, lhs.data <= rhs.data);
+                return true;
+
+            case opcode::greater:
+                if (!is_number(lhs) || !is_number(rhs))
+                    return false;
+                set_value(dest, value::boolean, lhs.data > rhs.data);
+                return true;
+
+            case opcode::greater_equal:
+                if (!is_number(lhs) || !is_number(rhs))
+                    return false;
+                set_value(dest, value::boolean, lhs.data >= rhs.data);
+                return true;
+
+            case opcode::equal:
+                if (!(is_number(lhs) && is_number(rhs)) &&
+                    !(lhs.kind == value::boolean && rhs.kind == value::boolean))
+                {
+                    return false;
+                }
+                set_value(dest, value::boolean, lhs.data == rhs.data);
+                return true;
+
+            case opcode::not_equal:
+                if (!(is_number(lhs) && is_number(rhs)) &&
+                    !(lhs.kind == value::boolean && rhs.kind == value::boolean))
+                {
+                    return false;
+                }
+                set_value(dest, value::boolean, lhs.data != rhs.data);
+                return true;
+
+            case opcode::logical_and:
+                if (!is_unboxed(lhs) || !is_unboxed(rhs))
+                    return false;
+                set_value(dest, value::boolean,
+                    lhs.data != 0.0 && rhs.data != 0.0);
+                return true;
+
+            case opcode::logical_or:
+                if (!is_unboxed(lhs) || !is_unboxed(rhs))
+                    return false;
+                set_value(dest, value::boolean,
+                    lhs.data != 0.0 || rhs.data != 0.0);
+                return true;
+
+            default:
+                break;
+            }
+
+            HPX_THROW_EXCEPTION(hpx::invalid_status,
+                "phylanx::execution_tree::compiler::detail::execute_unboxed",
+                "encountered unknown opcode");
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    primitive_argument_type bytecode_program::run() const
+    {
+        using bytecode::opcode;
+        using bytecode::value;
+
+        std::vector<value> slots(num_slots);
+
+        std::size_t const end = code.size();
+        std::size_t pc = 0;
+        while (pc != end)
+        {
+            bytecode::instruction const& inst = code[pc++];
+            switch (inst.op)
+            {
+            case opcode::load_constant:
+                slots[inst.dest] = constants[inst.lhs];
+                break;
+
+            case opcode::move:
+                if (inst.dest != inst.lhs)
+                {
+                    slots[inst.dest] = slots[inst.lhs];
+                }
+                break;
+
+            case opcode::negate:
+                if (detail::is_number(slots[inst.lhs]))
+                {
+                    detail::set_value(slots[inst.dest], value::scalar,
+                        -slots[inst.lhs].data);
+                    break;
+                }
+                slots[inst.dest] =
+                    detail::call_fallback(fallbacks[inst.aux], slots);
+                break;
+
+            case opcode::logical_not:
+                if (detail::is_unboxed(slots[inst.lhs]))
+                {
+                    detail::set_value(slots[inst.dest], value::boolean,
+                        slots[inst.lhs].data == 0.0);
+                    break;
+                }
+                slots[inst.dest] =
+                    detail::call_fallback(fallbacks[inst.aux], slots);
+                break;
+
+            case opcode::jump:
+                pc = inst.lhs;
+                break;
+
+            case opcode::jump_if_false:
+                if (!detail::is_true(slots[inst.lhs]))
+                {
+                    pc = inst.rhs;
+                }
+                break;
+
+            case opcode::call_tree:
+                slots[inst.dest] =
+                    detail::call_fallback(fallbacks[inst.aux], slots);
+                break;
+
+            default:
+                // binary operations
+                if (!detail::execute_unboxed(inst.op, slots[inst.lhs],
+                        slots[inst.rhs], slots[inst.dest]))
+                {
+                    slots[inst.dest] =
+                        detail::call_fallback(fallbacks[inst.aux], slots);
+                }
+                break;
+            }
+        }
+
+        return slots[result].to_argument();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        using bytecode::opcode;
+
+        // thrown whenever an expression can't be lowered into the bytecode
+        // program without changing its semantics
+        struct unsupported {};
+
+        // collect all identifiers referenced by an expression, detect
+        // store() operations which would have to modify those
+        struct collect_identifiers
+        {
+            std::set<std::string>& names;
+            std::set<std::string>& stored;
+
+            template <typename Ast, typename ... Ts>
+            bool operator()(Ast const&, Ts const&...) const
+            {
+                return true;
+            }
+
+            bool operator()(ast::identifier const& id) const
+            {
+                names.insert(id.name);
+                return true;
+            }
+
+            bool operator()(ast::function_call const& fc) const
+            {
+                if (fc.function_name.name == "store" && !fc.args.empty() &&
+                    ast::detail::is_identifier(fc.args[0]))
+                {
+                    stored.insert(ast::detail::identifier_name(fc.args[0]));
+                }
+                return true;
+            }
+        };
+
+        struct lowering
+        {
+            lowering(bytecode_program& program, function_list& snippets,
+                    environment& env, expression_pattern_list const& patterns,
+                    hpx::id_type const& default_locality)
+              : program_(program)
+              , snippets_(snippets)
+              , env_(env)
+              , patterns_(patterns)
+              , default_locality_(default_locality)
+              , scopes_(1)
+            {}
+
+            std::uint32_t operator()(ast::expression const& expr)
+            {
+                for (auto const& pattern : patterns_)
+                {
+                    std::multimap<std::string, ast::expression> placeholders;
+                    if (!ast::match_ast(expr, hpx::util::get<2>(pattern),
+                            on_placeholder_match{placeholders}))
+                    {
+                        continue;   // no match found for the current pattern
+                    }
+
+                    std::vector<ast::expression> operands;
+                    operands.reserve(placeholders.size());
+                    for (auto const& placeholder : placeholders)
+                    {
+                        operands.push_back(placeholder.second);
+                    }
+
+                    return lower_pattern(
+                        hpx::util::get<0>(pattern), operands, expr);
+                }
+
+                if (ast::detail::is_identifier(expr))
+                {
+                    std::uint32_t const* slot =
+                        find_local(ast::detail::identifier_name(expr));
+                    if (slot != nullptr)
+                    {
+                        return *slot;
+                    }
+                }
+                else if (ast::detail::is_literal_value(expr))
+                {
+                    return load_constant(to_primitive_value_type(
+                        ast::detail::literal_value(expr)));
+                }
+
+                return lower_tree(expr);
+            }
+
+        private:
+            std::uint32_t new_slot()
+            {
+                return static_cast<std::uint32_t>(program_.num_slots++);
+            }
+
+            std::uint32_t next_address() const
+            {
+                return static_cast<std::uint32_t>(program_.code.size());
+            }
+
+            std::size_t emit(opcode op, std::uint32_t dest,
+                std::uint32_t lhs = 0, std::uint32_t rhs = 0,
+                std::uint32_t aux = 0)
+            {
+                program_.code.push_back(
+                    bytecode::instruction{op, dest, lhs, rhs, aux});
+                return program_.code.size() - 1;
+            }
+
+            std::uint32_t const* find_local(std::string const& name) const
+            {
+                for (auto it = scopes_.rbegin(); it != scopes_.rend(); ++it)
+                {
+                    auto found = it->find(name);
+                    if (found != it->end())
+                    {
+                        return &found->second;
+                    }
+                }
+                return nullptr;
+            }
+
+            std::uint32_t load_constant(primitive_argument_type && val)
+            {
+                std::uint32_t index =
+                    static_cast<std::uint32_t>(program_.constants.size());
+                program_.constants.emplace_back(std::move(val));
+
+                std::uint32_t dest = new_slot();
+                emit(opcode::load_constant, dest, index);
+                return dest;
+            }
+
+            std::uint32_t add_fallback(bytecode::fallback && fb)
+            {
+                std::uint32_t index =
+                    static_cast<std::uint32_t>(program_.fallbacks.size());
+                program_.fallbacks.push_back(std::move(fb));
+                return index;
+            }
+
+            // Compile the given expression into an execution tree. All local
+            // variables referenced by the expression are passed as arguments.
+            std::uint32_t lower_tree(ast::expression const& expr)
+            {
+                std::set<std::string> names, stored;
+                ast::traverse(expr, collect_identifiers{names, stored});
+
+                environment env(&env_);
+                bytecode::fallback fb;
+
+                std::size_t count = 0;
+                for (auto const& name : names)
+                {
+                    std::uint32_t const* slot = find_local(name);
+                    if (slot == nullptr)
+                    {
+                        continue;
+                    }
+
+                    // the execution tree can't modify local variables
+                    if (stored.find(name) != stored.end())
+                    {
+                        throw unsupported{};
+                    }
+
+                    env.define(name,
+                        hpx::util::bind(arg, count++, default_locality_));
+                    fb.slots.push_back(*slot);
+                }
+
+                fb.f = compile(
+                    expr, snippets_, env, patterns_, default_locality_);
+
+                std::uint32_t dest = new_slot();
+                emit(opcode::call_tree, dest, 0, 0,
+                    add_fallback(std::move(fb)));
+                return dest;
+            }
+
+            // Create an execution tree for the given built-in function
+            // which is invoked with the given slots as its arguments.
+            std::uint32_t builtin_fallback(std::string const& name,
+                std::vector<std::uint32_t> && slots)
+            {
+                compiled_function* cf = env_.find(name);
+                if (cf == nullptr)
+                {
+                    throw unsupported{};
+                }
+
+                function_list args;
+                for (std::size_t i = 0; i != slots.size(); ++i)
+                {
+                    args.push_back(arg(i, default_locality_));
+                }
+
+                bytecode::fallback fb;
+                fb.f = (*cf)(std::move(args));
+                fb.slots = std::move(slots);
+                return add_fallback(std::move(fb));
+            }
+
+            std::uint32_t lower_binary(opcode op, std::string const& name,
+                std::vector<ast::expression> const& operands)
+            {
+                std::uint32_t lhs = (*this)(operands[0]);
+                for (std::size_t i = 1; i != operands.size(); ++i)
+                {
+                    std::uint32_t rhs = (*this)(operands[i]);
+                    std::uint32_t dest = new_slot();
+                    emit(op, dest, lhs, rhs, builtin_fallback(name, {lhs, rhs}));
+                    lhs = dest;
+                }
+                return lhs;
+            }
+
+            std::uint32_t lower_unary(opcode op, std::string const& name,
+                ast::expression const& operand)
+            {
+                std::uint32_t lhs = (*this)(operand);
+                std::uint32_t dest = new_slot();
+                emit(op, dest, lhs, 0, builtin_fallback(name, {lhs}));
+                return dest;
+            }
+
+            std::uint32_t lower_block(
+                std::vector<ast::expression> const& operands)
+            {
+                scopes_.emplace_back();
+
+                std::uint32_t result = 0;
+                if (operands.empty())
+                {
+                    result = load_constant(primitive_argument_type{});
+                }
+                for (auto const& operand : operands)
+                {
+                    result = (*this)(operand);
+                }
+
+                scopes_.pop_back();
+                return result;
+            }
+
+            std::uint32_t lower_define(
+                std::vector<ast::expression> const& operands)
+            {
+                // function definitions are left to the execution tree
+                if (operands.size() != 2 ||
+                    !ast::detail::is_identifier(operands[0]))
+                {
+                    throw unsupported{};
+                }
+
+                std::string name = ast::detail::identifier_name(operands[0]);
+                if (scopes_.back().find(name) != scopes_.back().end())
+                {
+                    throw unsupported{};
+                }
+
+                std::uint32_t val = (*this)(operands[1]);
+                std::uint32_t dest = new_slot();
+                emit(opcode::move, dest, val);
+
+                scopes_.back()[name] = dest;
+                return dest;
+            }
+
+            std::uint32_t lower_store(
+                std::vector<ast::expression> const& operands,
+                ast::expression const& expr)
+            {
+                std::uint32_t const* slot = nullptr;
+                if (ast::detail::is_identifier(operands[0]))
+                {
+                    slot = find_local(ast::detail::identifier_name(operands[0]));
+                }
+                if (slot == nullptr)
+                {
+                    return lower_tree(expr);
+                }
+
+                std::uint32_t dest = *slot;
+                std::uint32_t val = (*this)(operands[1]);
+                emit(opcode::move, dest, val);
+                return dest;
+            }
+
+            std::uint32_t lower_if(std::vector<ast::expression> const& operands)
+            {
+                std::uint32_t result = new_slot();
+
+                std::uint32_t cond = (*this)(operands[0]);
+                std::size_t branch = emit(opcode::jump_if_false, 0, cond);
+
+                emit(opcode::move, result, (*this)(operands[1]));
+
+                if (operands.size() == 3)
+                {
+                    std::size_t skip = emit(opcode::jump, 0);
+                    program_.code[branch].rhs = next_address();
+                    emit(opcode::move, result, (*this)(operands[2]));
+                    program_.code[skip].lhs = next_address();
+                }
+                else
+                {
+                    std::size_t skip = emit(opcode::jump, 0);
+                    program_.code[branch].rhs = next_address();
+                    emit(opcode::move, result,
+                        load_constant(primitive_argument_type{}));
+                    program_.code[skip].lhs = next_address();
+                }
+
+                return result;
+            }
+
+            std::uint32_t lower_while(
+                std::vector<ast::expression> const& operands)
+            {
+                std::uint32_t result = new_slot();
+                emit(opcode::move, result,
+                    load_constant(primitive_argument_type{}));
+
+                std::uint32_t start = next_address();
+                std::size_t branch =
+                    emit(opcode::jump_if_false, 0, (*this)(operands[0]));
+
+                emit(opcode::move, result, (*this)(operands[1]));
+                emit(opcode::jump, 0, start);
+
+                program_.code[branch].rhs = next_address();
+                return result;
+            }
+
+            std::uint32_t lower_for(
+                std::vector<ast::expression> const& operands)
+            {
+                std::uint32_t result = new_slot();
+                emit(opcode::move, result,
+                    load_constant(primitive_argument_type{}));
+
+                (*this)(operands[0]);
+
+                std::uint32_t start = next_address();
+                std::size_t branch =
+                    emit(opcode::jump_if_false, 0, (*this)(operands[1]));
+
+                emit(opcode::move, result, (*this)(operands[3]));
+                (*this)(operands[2]);
+                emit(opcode::jump, 0, start);
+
+                program_.code[branch].rhs = next_address();
+                return result;
+            }
+
+            std::uint32_t lower_pattern(std::string const& name,
+                std::vector<ast::expression> const& operands,
+                ast::expression const& expr)
+            {
+                if (name == "block")
+                    return lower_block(operands);
+                if (name == "define")
+                    return lower_define(operands);
+                if (name == "store")
+                    return lower_store(operands, expr);
+                if (name == "if1" || name == "if2")
+                    return lower_if(operands);
+                if (name == "while")
+                    return lower_while(operands);
+                if (name == "for")
+                    return lower_for(operands);
+
+                if (name == "add")
+                    return lower_binary(opcode::add, name, operands);
+                if (name == "sub")
+                    return lower_binary(opcode::sub, name, operands);
+                if (name == "mul")
+                    return lower_binary(opcode::mul, name, operands);
+                if (name == "div")
+                    return lower_binary(opcode::div, name, operands);
+                if (name == "and")
+                    return lower_binary(opcode::logical_and, name, operands);
+                if (name == "or")
+                    return lower_binary(opcode::logical_or, name, operands);
+
+                if (operands.size() == 2)
+                {
+                    if (name == "lt")
+                        return lower_binary(opcode::less, name, operands);
+                    if (name == "le")
+                        return lower_binary(opcode::less_equal, name, operands);
+                    if (name == "gt")
+                        return lower_binary(opcode::greater, name, operands);
+                    if (name == "ge")
+                        return lower_binary(
+                            opcode::greater_equal, name, operands);
+                    if (name == "eq")
+                        return lower_binary(opcode::equal, name, operands);
+                    if (name == "ne")
+                        return lower_binary(opcode::not_equal, name, operands);
+                }
+                else if (operands.size() == 1)
+                {
+                    if (name == "minus")
+                        return lower_unary(opcode::negate, name, operands[0]);
+                    if (name == "not")
+                        return lower_unary(
+                            opcode::logical_not, name, operands[0]);
+                }
+
+                return lower_tree(expr);
+            }
+
+        private:
+            bytecode_program& program_;
+            function_list& snippets_;
+            environment& env_;
+            expression_pattern_list const& patterns_;
+            hpx::id_type default_locality_;
+            std::vector<std::map<std::string, std::uint32_t>> scopes_;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bytecode_program lower(ast::expression const& expr,
+        function_list& snippets, environment& env,
+        expression_pattern_list const& patterns,
+        hpx::id_type const& default_locality)
+    {
+        bytecode_program program;
+        try {
+            detail::lowering l{
+                program, snippets, env, patterns, default_locality};
+            program.result = l(expr);
+            return program;
+        }
+        catch (detail::unsupported const&) {
+        }
+
+        // evaluate the whole expression using the execution tree
+        bytecode_program tree;
+
+        bytecode::fallback fb;
+        fb.f = compile(expr, snippets, env, patterns, default_locality);
+        tree.fallbacks.push_back(std::move(fb));
+
+        tree.code.push_back(
+            bytecode::instruction{bytecode::opcode::call_tree, 0, 0, 0, 0});
+        tree.num_slots = 1;
+        tree.result = 0;
+        return tree;
+    }
+}}}
@@ -15,14 +15,23 @@
 #include <phylanx/execution_tree/compile.hpp>
 #include <phylanx/execution_tree/compiler/actors.hpp>
 #include <phylanx/execution_tree/compiler/compiler.hpp>
+#include <phylanx/execution_tree/compiler/pattern_index.hpp>
+#include <phylanx/execution_tree/compiler/type_inference.hpp>
+#include <phylanx/execution_tree/compiler/variable_access.hpp>
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/dataflow_block_operation.hpp>
+#include <phylanx/execution_tree/primitives/let_operation.hpp>
+#include <phylanx/execution_tree/primitives/ranked_operation.hpp>
 #include <phylanx/ir/node_data.hpp>
 
 #include <hpx/include/naming.hpp>
 #include <hpx/include/util.hpp>
 
 #include <cstddef>
+#include <cstdint>
+#include <initializer_list>
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 #include <utility>
@@ -48,9 +57,24 @@ namespace phylanx { namespace execution_tree { namespace compiler
         return result;
     }
 
+    environment default_environment(expression_pattern_list const& patterns,
+        hpx::id_type const& default_locality)
+    {
+        environment result;
+
+        for (auto const& pattern : patterns)
+        {
+            result.define(hpx::util::get<0>(pattern),
+                builtin_function(hpx::util::get<3>(pattern), default_locality));
+        }
+
+        return result;
+    }
+
     environment default_environment(hpx::id_type const& default_locality)
     {
-        return default_environment(get_all_known_patterns(), default_locality);
+        return default_environment(
+            *get_all_known_expression_patterns(), default_locality);
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -75,52 +99,6 @@ namespace phylanx { namespace execution_tree { namespace compiler
         return result;
     }
 
-    ///////////////////////////////////////////////////////////////////////////
-    struct on_placeholder_match
-    {
-        std::multimap<std::string, ast::expression>& placeholders;
-
-        template <typename Ast1, typename Ast2, typename... Ts>
-        bool operator()(
-            Ast1 const& ast1, Ast2 const& ast2, Ts const&... ts) const
-        {
-            using value_type = typename std::multimap<std::string,
-                ast::expression>::value_type;
-
-            if (ast::detail::is_placeholder(ast1))
-            {
-                if (ast::detail::is_placeholder_ellipses(ast1))
-                {
-                    placeholders.insert(value_type(
-                        ast::detail::identifier_name(ast1).substr(1),
-                        ast::expression(ast2)));
-                }
-                else
-                {
-                    placeholders.insert(
-                        value_type(ast::detail::identifier_name(ast1),
-                            ast::expression(ast2)));
-                }
-            }
-            else if (ast::detail::is_placeholder(ast2))
-            {
-                if (ast::detail::is_placeholder_ellipses(ast1))
-                {
-                    placeholders.insert(value_type(
-                        ast::detail::identifier_name(ast2).substr(1),
-                        ast::expression(ast1)));
-                }
-                else
-                {
-                    placeholders.insert(
-                        value_type(ast::detail::identifier_name(ast2),
-                            ast::expression(ast1)));
-                }
-            }
-            return true;
-        }
-    };
-
     ///////////////////////////////////////////////////////////////////////////
     template <typename Iterator>
     ast::expression extract_name(std::pair<Iterator, Iterator> const& p)
@@ -199,29 +177,50 @@ namespace phylanx { namespace execution_tree { namespace compiler
     {
         compiler(function_list& snippets, environment& env,
                 expression_pattern_list const& patterns,
-                hpx::id_type const& default_locality)
+                pattern_index const& index, type_map const& types,
+                hpx::id_type const& default_locality,
+                std::map<std::string, std::size_t> temporaries = {},
+                std::size_t num_temporaries = 0, std::size_t num_args = 0)
           : env_(env)
           , snippets_(snippets)
           , patterns_(patterns)
+          , index_(index)
+          , types_(types)
           , default_locality_(default_locality)
+          , temporaries_(std::move(temporaries))
+          , num_temporaries_(num_temporaries)
+          , num_args_(num_args)
         {}
 
     private:
+        // The arguments are bound to the argument values starting at index
+        // 'first_arg', the values before that are the arguments of the
+        // enclosing function (if any).
         function handle_lambda(
             std::vector<ast::expression> const& args,
-            ast::expression const& body) const
+            ast::expression const& body, std::size_t first_arg = 0) const
         {
             environment env(&env_);
             for (std::size_t i = 0; i != args.size(); ++i)
             {
                 HPX_ASSERT(ast::detail::is_identifier(args[i]));
                 env.define(ast::detail::identifier_name(args[i]),
-                    hpx::util::bind(arg, i));
+                    hpx::util::bind(arg, first_arg + i, default_locality_));
             }
-            return compile(body, snippets_, env, patterns_, default_locality_);
+            return compile_function(body, env, first_arg + args.size());
+        }
+
+        // Compile the body of a function or the initializer of a variable,
+        // which doesn't share any common subexpressions with its context.
+        function compile_function(ast::expression const& body,
+            environment& env, std::size_t num_args) const
+        {
+            compiler comp{snippets_, env, patterns_, index_, types_,
+                default_locality_, {}, 0, num_args};
+            return comp.compile_statement(body, env);
         }
 
-        function handle_define(
+        function handle_define(ast::expression const& expr,
             std::multimap<std::string, ast::expression>& placeholders,
             expression_pattern const& pattern)
         {
@@ -230,12 +229,25 @@ namespace phylanx { namespace execution_tree { namespace compiler
                 typename std::multimap<std::string, ast::expression>::iterator;
             std::pair<iterator, iterator> p = placeholders.equal_range("__1");
 
+            std::string name = ast::detail::identifier_name(extract_name(p));
+
+            // refer to the primitives compiled earlier, if possible
+            definition_cache* cache = env_.get_definition_cache();
+            if (cache != nullptr)
+            {
+                if (function const* cf = cache->find(name, expr, env_))
+                {
+                    env_.define(
+                        name, external_function(*cf, default_locality_));
+                    return *cf;
+                }
+            }
+
             // extract expressions representing the newly defined function
             // and store new function description for later use
             snippets_.emplace_back(function{});
             function& f = snippets_.back();
 
-            std::string name = ast::detail::identifier_name(extract_name(p));
             env_.define(name, external_function(f, default_locality_));
 
             auto args = extract_arguments(p);
@@ -244,8 +256,7 @@ namespace phylanx { namespace execution_tree { namespace compiler
             {
                 // define variable
                 environment env(&env_);
-                function bf = compile(body, snippets_, env, patterns_,
-                    default_locality_);
+                function bf = compile_function(body, env, num_args_);
 
                 f = primitive_variable{default_locality_}(
                         std::move(bf.arg_), name);
@@ -263,6 +274,10 @@ namespace phylanx { namespace execution_tree { namespace compiler
                     std::move(handle_lambda(args, body).arg_));
             }
 
+            if (cache != nullptr)
+            {
+                cache->add(name, expr, env_, f);
+            }
             return f;
         }
 
@@ -290,8 +305,7 @@ namespace phylanx { namespace execution_tree { namespace compiler
                 for (auto const& argexpr : argexprs)
                 {
                     environment env(&env_);
-                    args.push_back(compile(argexpr, snippets_, env, patterns_,
-                        default_locality_));
+                    args.push_back(compile_subexpression(argexpr, env));
                 }
                 return (*cf)(std::move(args));
             }
@@ -301,6 +315,144 @@ namespace phylanx { namespace execution_tree { namespace compiler
                 "couldn't find given name in symbol table: " + name);
         }
 
+        // Return whether the given compiled function is the built-in
+        // function of the given name, i.e. whether the name was not
+        // redefined in any of the enclosing scopes.
+        bool is_builtin(std::string const& name,
+            compiled_function const* cf) const
+        {
+            environment* root = &env_;
+            while (root->parent() != nullptr)
+            {
+                root = root->parent();
+            }
+            return cf != nullptr && root->find(name) == cf;
+        }
+
+        // Evaluate the built-in function of the given name at compile time
+        // if all of its operands are literal values. The primitive is created
+        // as a local object and discarded afterwards. Any errors are reported
+        // only once the expression is evaluated at runtime.
+        bool fold_constant(std::string const& name, function_list const& args,
+            compiled_function const* cf, primitive_argument_type& result) const
+        {
+            if (has_side_effects(name) || name == "store" ||
+                name == "while" || name == "for" || !is_builtin(name, cf))
+            {
+                return false;
+            }
+
+            std::vector<primitive_argument_type> operands;
+            operands.reserve(args.size());
+            for (auto const& arg : args)
+            {
+                if (is_primitive_operand(arg.arg_))
+                {
+                    return false;
+                }
+                operands.push_back(arg.arg_);
+            }
+
+            expression_pattern const* pattern = index_.find(name);
+            if (pattern == nullptr)
+            {
+                return false;
+            }
+
+            // some patterns are named after the number of their operands
+            // (e.g. randomized_svd3), check the name of the function as well
+            ast::expression const& expr = hpx::util::get<2>(*pattern);
+            if (ast::detail::is_function_call(expr) &&
+                has_side_effects(ast::detail::function_name(expr)))
+            {
+                return false;
+            }
+
+            factory_function_type factory = hpx::util::get<3>(*pattern);
+            if (factory == nullptr)
+            {
+                return false;
+            }
+
+            try
+            {
+                function f{(*factory)(hpx::invalid_id, std::move(operands))};
+                primitive_argument_type value = f();
+                if (is_primitive_operand(value))
+                {
+                    return false;
+                }
+                result = std::move(value);
+                return true;
+            }
+            catch (...)
+            {
+                return false;
+            }
+        }
+
+        // Create a primitive specialized for the number of dimensions of
+        // its operands if those are known from the type inference. This is
+        // done for the built-in binary operations only, and only if those
+        // were not redefined.
+        bool specialize(std::string const& name,
+            std::multimap<std::string, ast::expression> const& placeholders,
+            function_list const& args, compiled_function const* cf,
+            function& result) const
+        {
+            if (args.size() != 2 ||
+                (name != "add" && name != "sub" && name != "mul" &&
+                    name != "div" && name != "dot"))
+            {
+                return false;
+            }
+
+            std::size_t ranks[2] = {0, 0};
+            std::size_t i = 0;
+            for (auto const& placeholder : placeholders)
+            {
+                auto it = types_.find(ast::to_string(placeholder.second));
+                if (it == types_.end() || !it->second.has_rank())
+                {
+                    return false;
+                }
+
+                inferred_type const& type = it->second;
+                if (type.kind != inferred_type::boolean &&
+                    type.kind != inferred_type::integer &&
+                    type.kind != inferred_type::numeric)
+                {
+                    return false;
+                }
+                ranks[i++] = std::size_t(type.rank);
+            }
+
+            if (!primitives::ranked_operation::is_supported(
+                    name, ranks[0], ranks[1]))
+            {
+                return false;
+            }
+
+            if (!is_builtin(name, cf))
+            {
+                return false;
+            }
+
+            std::vector<primitive_argument_type> operands;
+            operands.reserve(args.size());
+            for (auto const& arg : args)
+            {
+                operands.push_back(arg.arg_);
+            }
+
+            result = function{
+                create_primitive<primitives::ranked_operation>(
+                    default_locality_, std::move(operands), name, ranks[0],
+                    ranks[1]),
+                name};
+            return true;
+        }
+
         function handle_placeholders(
             std::multimap<std::string, ast::expression>& placeholders,
             std::string const& name)
@@ -312,8 +464,22 @@ namespace phylanx { namespace execution_tree { namespace compiler
 
                 for (auto const& placeholder : placeholders)
                 {
-                    args.push_back(compile(placeholder.second,
-                        snippets_, env, patterns_, default_locality_));
+                    args.push_back(
+                        compile_subexpression(placeholder.second, env));
+                }
+
+                // pure functions of literal values are evaluated right away
+                primitive_argument_type value;
+                if (fold_constant(name, args, cf, value))
+                {
+                    return literal_value(std::move(value));
+                }
+
+                // select a kernel for the ranks of the operands, if known
+                function f;
+                if (specialize(name, placeholders, args, cf, f))
+                {
+                    return f;
                 }
 
                 // create primitive with given arguments
@@ -326,11 +492,556 @@ namespace phylanx { namespace execution_tree { namespace compiler
                 "couldn't find built-in function in environment: " + name);
         }
 
+        // The statements of a block() are evaluated concurrently whenever
+        // they don't access the same variables (see variable_access.hpp). A
+        // plain block_operation is used if the statements form a chain.
+        function handle_block(
+            std::multimap<std::string, ast::expression>& placeholders,
+            expression_pattern const& pattern)
+        {
+            std::vector<ast::expression> statements;
+            statements.reserve(placeholders.size());
+            for (auto const& placeholder : placeholders)
+            {
+                statements.push_back(placeholder.second);
+            }
+
+            // definitions which are never referenced are dropped
+            statements =
+                remove_unused_definitions(std::move(statements), patterns_);
+
+            std::vector<std::vector<std::size_t>> dependencies =
+                statement_dependencies(statements, patterns_);
+
+            // all statements share the same environment
+            function_list args;
+            environment env(&env_);
+            for (auto const& statement : statements)
+            {
+                args.push_back(compile_statement(statement, env));
+            }
+
+            bool has_independent_statements = false;
+            for (std::size_t i = 1; i != dependencies.size(); ++i)
+            {
+                if (dependencies[i].empty() ||
+                    dependencies[i].back() != i - 1)
+                {
+                    has_independent_statements = true;
+                    break;
+                }
+            }
+
+            if (!has_independent_statements)
+            {
+                compiled_function* cf = env_.find(hpx::util::get<0>(pattern));
+                if (cf == nullptr)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "phylanx::execution_tree::compiler::handle_block",
+                        "couldn't find built-in function in environment: " +
+                            hpx::util::get<0>(pattern));
+                }
+                return (*cf)(std::move(args));
+            }
+
+            std::vector<primitive_argument_type> fargs;
+            fargs.reserve(args.size());
+            for (auto const& arg : args)
+            {
+                fargs.push_back(arg.arg_);
+            }
+
+            return function{
+                create_primitive<primitives::dataflow_block_operation>(
+                    default_locality_, std::move(fargs),
+                    std::move(dependencies)),
+                "dataflow_block"};
+        }
+
+        // parallel_for(i, start, stop, body): the loop variable is bound as
+        // the argument following the arguments of the enclosing function
+        // (if any), the primitive evaluates the loop body once for each
+        // index, passing along the arguments of the enclosing function.
+        function handle_parallel_for(
+            std::multimap<std::string, ast::expression>& placeholders,
+            expression_pattern const& pattern)
+        {
+            compiled_function* cf = env_.find(hpx::util::get<0>(pattern));
+            if (cf == nullptr)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::compiler::handle_parallel_for",
+                    "couldn't find built-in function in environment: " +
+                        hpx::util::get<0>(pattern));
+            }
+
+            ast::expression const& var = placeholders.find("_1")->second;
+            if (!ast::detail::is_identifier(var))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::compiler::handle_parallel_for",
+                    "the parallel_for() operation requires that the loop "
+                        "variable is represented as a variable name (not "
+                        "an expression)");
+            }
+
+            function_list args;
+            for (char const* name : {"_2", "_3"})
+            {
+                environment env(&env_);
+                args.push_back(compile_subexpression(
+                    placeholders.find(name)->second, env));
+            }
+            args.push_back(handle_lambda(
+                std::vector<ast::expression>{var},
+                placeholders.find("_4")->second, num_args_));
+            args.push_back(function{
+                primitive_argument_type{std::int64_t(num_args_)}});
+
+            return (*cf)(std::move(args));
+        }
+
+        // Collect the operands of nested dot() invocations, e.g.
+        // dot(dot(A, B), v) results in [A, B, v].
+        void flatten_dot_chain(ast::expression const& expr,
+            ast::expression const& pattern,
+            std::vector<ast::expression>& chain) const
+        {
+            std::multimap<std::string, ast::expression> placeholders;
+            if (temporaries_.find(ast::to_string(expr)) != temporaries_.end() ||
+                !ast::match_ast(
+                    expr, pattern, on_placeholder_match{placeholders}))
+            {
+                chain.push_back(expr);
+                return;
+            }
+
+            for (auto const& placeholder : placeholders)
+            {
+                flatten_dot_chain(placeholder.second, pattern, chain);
+            }
+        }
+
+        // Nested dot() invocations are compiled into a single multi_dot()
+        // which reorders the multiplications based on the actual shapes of
+        // its operands.
+        function handle_dot(
+            std::multimap<std::string, ast::expression>& placeholders,
+            expression_pattern const& pattern)
+        {
+            std::vector<ast::expression> chain;
+            for (auto const& placeholder : placeholders)
+            {
+                flatten_dot_chain(
+                    placeholder.second, hpx::util::get<2>(pattern), chain);
+            }
+
+            // nested products are computed by multi_dot, unless dot or
+            // multi_dot were redefined by the program
+            compiled_function* cf = nullptr;
+            if (chain.size() > 2 && is_builtin("dot", env_.find("dot")))
+            {
+                cf = env_.find("multi_dot");
+                if (!is_builtin("multi_dot", cf))
+                {
+                    cf = nullptr;
+                }
+            }
+
+            if (cf == nullptr)
+            {
+                return handle_placeholders(
+                    placeholders, hpx::util::get<0>(pattern));
+            }
+
+            function_list args;
+            environment env(&env_);
+
+            for (auto const& expr : chain)
+            {
+                args.push_back(compile_subexpression(expr, env));
+            }
+
+            return (*cf)(std::move(args));
+        }
+
+        // Compile a sub-expression of the current statement
+        function compile_subexpression(
+            ast::expression const& expr, environment& env) const
+        {
+            compiler comp{snippets_, env, patterns_, index_, types_,
+                default_locality_, temporaries_, num_temporaries_, num_args_};
+            return comp(expr);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Common subexpression elimination: pure subexpressions which occur
+        // more than once in the (unconditionally evaluated) part of a
+        // statement are evaluated only once by a let_operation wrapping the
+        // statement.
+
+        // the operands of these are not evaluated unconditionally, not
+        // evaluated using the arguments of the enclosing statement, or are
+        // evaluated using their own scheduling hints
+        static bool is_cse_barrier(std::string const& name)
+        {
+            return name == "if1" || name == "if2" || name == "while" ||
+                name == "for" || name == "block" ||
+                name == "parallel_block" || name == "parallel_for" ||
+                name == "define" || name == "schedule";
+        }
+
+        using subexpression_counts =
+            std::map<std::string, std::pair<std::size_t, ast::expression>>;
+
+        // Count the occurrences of all subexpressions as seen by operator(),
+        // don't look into the given candidates. The statements of nested
+        // blocks are considered only if enter_blocks is true.
+        void count_subexpressions(ast::expression const& expr,
+            subexpression_counts& counts,
+            std::set<std::string> const* candidates = nullptr,
+            bool enter_blocks = false) const
+        {
+            if (ast::detail::is_identifier(expr) ||
+                ast::detail::is_literal_value(expr))
+            {
+                return;
+            }
+
+            std::string key = ast::to_string(expr);
+            if (temporaries_.find(key) != temporaries_.end())
+            {
+                return;     // computed for an enclosing statement already
+            }
+
+            if (candidates != nullptr &&
+                candidates->find(key) != candidates->end())
+            {
+                auto& entry = counts[key];
+                if (entry.first++ == 0)
+                    entry.second = expr;
+                return;
+            }
+
+            for (auto const* candidate : index_.candidates(expr))
+            {
+                expression_pattern const& pattern = *candidate;
+
+                std::multimap<std::string, ast::expression> placeholders;
+                if (!ast::match_ast(expr, hpx::util::get<2>(pattern),
+                        on_placeholder_match{placeholders}))
+                {
+                    continue;
+                }
+
+                std::string const& name = hpx::util::get<0>(pattern);
+                if (is_cse_barrier(name) && !(enter_blocks && name == "block"))
+                {
+                    return;
+                }
+
+                auto& entry = counts[key];
+                if (entry.first++ == 0)
+                    entry.second = expr;
+
+                for (auto const& placeholder : placeholders)
+                {
+                    count_subexpressions(placeholder.second, counts,
+                        candidates, enter_blocks);
+                }
+                return;
+            }
+
+            // invocations of user defined functions are not pure, but their
+            // arguments may contain common subexpressions
+            if (ast::detail::is_function_call(expr))
+            {
+                for (auto const& arg : ast::detail::function_arguments(expr))
+                {
+                    count_subexpressions(
+                        arg, counts, candidates, enter_blocks);
+                }
+            }
+        }
+
+        std::vector<ast::expression> common_subexpressions(
+            ast::expression const& stmt) const
+        {
+            subexpression_counts counts;
+            count_subexpressions(stmt, counts);
+
+            // variables modified while the statement is evaluated, store()
+            // modifies its target only after its value has been computed
+            std::set<std::string> writes;
+            std::vector<ast::expression> args =
+                ast::detail::function_arguments(stmt);
+            if (ast::detail::function_name(stmt) == "store" &&
+                args.size() == 2)
+            {
+                writes = analyze_variable_access(args[1], patterns_).writes;
+            }
+            else
+            {
+                writes = analyze_variable_access(stmt, patterns_).writes;
+            }
+
+            std::set<std::string> candidates;
+            for (auto const& count : counts)
+            {
+                if (count.second.first < 2)
+                    continue;
+
+                variable_access access =
+                    analyze_variable_access(count.second.second, patterns_);
+                if (access.has_side_effects || !access.writes.empty())
+                    continue;
+
+                bool modified = false;
+                for (auto const& name : access.reads)
+                {
+                    if (writes.find(name) != writes.end())
+                    {
+                        modified = true;
+                        break;
+                    }
+                }
+
+                if (!modified)
+                    candidates.insert(count.first);
+            }
+
+            if (candidates.empty())
+                return {};
+
+            // only the outermost of nested common subexpressions are kept
+            subexpression_counts outermost;
+            count_subexpressions(stmt, outermost, &candidates);
+
+            std::vector<ast::expression> result;
+            for (auto const& count : outermost)
+            {
+                if (count.second.first >= 2 &&
+                    candidates.find(count.first) != candidates.end())
+                {
+                    result.push_back(count.second.second);
+                }
+            }
+            return result;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Loop-invariant code motion: pure subexpressions of while() and
+        // for() loops which don't read any of the variables modified by the
+        // loop are evaluated only once, before the loop is entered. The
+        // invariants are evaluated only if the loop condition holds initially,
+        // i.e. while(c, b) is compiled as if(c, let(invariants, while(c, b))).
+
+        // Collect the outermost loop-invariant subexpressions of the given
+        // parts of a loop which are evaluated during each iteration.
+        std::vector<ast::expression> loop_invariants(ast::expression const& loop,
+            std::vector<ast::expression> const& parts) const
+        {
+            variable_access loop_access =
+                analyze_variable_access(loop, patterns_);
+            if (loop_access.invokes_functions)
+            {
+                return {};
+            }
+
+            subexpression_counts counts;
+            for (auto const& part : parts)
+            {
+                count_subexpressions(part, counts, nullptr, true);
+            }
+
+            std::set<std::string> candidates;
+            for (auto const& count : counts)
+            {
+                variable_access access =
+                    analyze_variable_access(count.second.second, patterns_);
+                if (access.has_side_effects || !access.writes.empty())
+                    continue;
+
+                bool modified = false;
+                for (auto const& name : access.reads)
+                {
+                    if (loop_access.writes.find(name) !=
+                        loop_access.writes.end())
+                    {
+                        modified = true;
+                        break;
+                    }
+                }
+
+                if (!modified)
+                    candidates.insert(count.first);
+            }
+
+            if (candidates.empty())
+                return {};
+
+            subexpression_counts outermost;
+            for (auto const& part : parts)
+            {
+                count_subexpressions(part, outermost, &candidates, true);
+            }
+
+            std::vector<ast::expression> result;
+            for (auto const& count : outermost)
+            {
+                if (candidates.find(count.first) != candidates.end())
+                {
+                    result.push_back(count.second.second);
+                }
+            }
+            return result;
+        }
+
+        // Wrap the given loop (compiled by the supplied function) into a
+        // let_operation evaluating the invariants, guarded by the condition.
+        template <typename F>
+        function hoist_invariants(std::vector<ast::expression> const& invariants,
+            ast::expression const& cond, environment& env, F && compile_loop)
+        {
+            compiled_function* cfif = env_.find("if1");
+            if (cfif == nullptr)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::compiler::hoist_invariants",
+                    "couldn't find built-in function in environment: if1");
+            }
+
+            function guard = compile_subexpression(cond, env);
+
+            std::vector<primitive_argument_type> operands;
+            operands.reserve(invariants.size() + 1);
+
+            std::map<std::string, std::size_t> temporaries = temporaries_;
+            std::size_t num_temporaries = num_temporaries_;
+            for (auto const& invariant : invariants)
+            {
+                operands.push_back(compile_subexpression(invariant, env).arg_);
+                temporaries[ast::to_string(invariant)] = num_temporaries++;
+            }
+
+            compiler comp{snippets_, env, patterns_, index_, types_,
+                default_locality_, std::move(temporaries), num_temporaries,
+                num_args_};
+            operands.push_back(compile_loop(comp).arg_);
+
+            function let{create_primitive<primitives::let_operation>(
+                default_locality_, std::move(operands)), "let"};
+
+            return (*cfif)(function_list{std::move(guard), std::move(let)});
+        }
+
+        function handle_while(ast::expression const& expr,
+            std::multimap<std::string, ast::expression>& placeholders,
+            expression_pattern const& pattern)
+        {
+            std::string const& name = hpx::util::get<0>(pattern);
+
+            ast::expression const& cond = placeholders.find("_1")->second;
+            ast::expression const& body = placeholders.find("_2")->second;
+
+            variable_access cond_access =
+                analyze_variable_access(cond, patterns_);
+
+            std::vector<ast::expression> invariants;
+            if (!cond_access.has_side_effects && cond_access.writes.empty())
+            {
+                invariants = loop_invariants(expr, {cond, body});
+            }
+
+            if (invariants.empty())
+            {
+                return handle_placeholders(placeholders, name);
+            }
+
+            compiled_function* cf = env_.find(name);
+            environment env(&env_);
+            return hoist_invariants(invariants, cond, env,
+                [&](compiler& comp)
+                {
+                    return (*cf)(function_list{comp(cond), comp(body)});
+                });
+        }
+
+        // for(init, cond, reinit, body) is compiled as
+        // block(init, if(cond, let(invariants, for(true, cond, reinit, body))))
+        function handle_for(ast::expression const& expr,
+            std::multimap<std::string, ast::expression>& placeholders,
+            expression_pattern const& pattern)
+        {
+            std::string const& name = hpx::util::get<0>(pattern);
+
+            ast::expression const& init = placeholders.find("_1")->second;
+            ast::expression const& cond = placeholders.find("_2")->second;
+            ast::expression const& reinit = placeholders.find("_3")->second;
+            ast::expression const& body = placeholders.find("_4")->second;
+
+            variable_access cond_access =
+                analyze_variable_access(cond, patterns_);
+
+            std::vector<ast::expression> invariants;
+            if (!cond_access.has_side_effects && cond_access.writes.empty())
+            {
+                invariants = loop_invariants(expr, {cond, reinit, body});
+            }
+
+            if (invariants.empty())
+            {
+                return handle_placeholders(placeholders, name);
+            }
+
+            compiled_function* cf = env_.find(name);
+            compiled_function* cfblock = env_.find("block");
+            if (cfblock == nullptr)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::compiler::handle_for",
+                    "couldn't find built-in function in environment: block");
+            }
+
+            // the loop variable is defined by the init statement, all parts
+            // of the loop share the same environment
+            environment env(&env_);
+            function init_f = compile_subexpression(init, env);
+
+            function loop = hoist_invariants(invariants, cond, env,
+                [&](compiler& comp)
+                {
+                    return (*cf)(function_list{
+                        literal_value(primitive_argument_type{true}),
+                        comp(cond), comp(reinit), comp(body)});
+                });
+
+            return (*cfblock)(
+                function_list{std::move(init_f), std::move(loop)});
+        }
+
     public:
         function operator()(ast::expression const& expr)
         {
-            for (auto const& pattern : patterns_)
+            // refer to the value of a common subexpression, if possible
+            if (!temporaries_.empty())
+            {
+                auto it = temporaries_.find(ast::to_string(expr));
+                if (it != temporaries_.end())
+                {
+                    return function{
+                        create_primitive<primitives::access_temporary>(
+                            default_locality_,
+                            num_temporaries_ - it->second - 1),
+                        "temporary"};
+                }
+            }
+
+            for (auto const* candidate : index_.candidates(expr))
             {
+                expression_pattern const& pattern = *candidate;
+
                 std::multimap<std::string, ast::expression> placeholders;
                 if (!ast::match_ast(expr, hpx::util::get<2>(pattern),
                         on_placeholder_match{placeholders}))
@@ -341,7 +1052,35 @@ namespace phylanx { namespace execution_tree { namespace compiler
                 // Handle define(__1)
                 if (hpx::util::get<0>(pattern) == "define")
                 {
-                    return handle_define(placeholders, pattern);
+                    return handle_define(expr, placeholders, pattern);
+                }
+
+                // Handle while(_1, _2) and for(_1, _2, _3, _4)
+                if (hpx::util::get<0>(pattern) == "while")
+                {
+                    return handle_while(expr, placeholders, pattern);
+                }
+                if (hpx::util::get<0>(pattern) == "for")
+                {
+                    return handle_for(expr, placeholders, pattern);
+                }
+
+                // Handle block(__1)
+                if (hpx::util::get<0>(pattern) == "block")
+                {
+                    return handle_block(placeholders, pattern);
+                }
+
+                // Handle parallel_for(_1, _2, _3, _4)
+                if (hpx::util::get<0>(pattern) == "parallel_for")
+                {
+                    return handle_parallel_for(placeholders, pattern);
+                }
+
+                // Handle dot(dot(_1, _2), _3) and similar
+                if (hpx::util::get<0>(pattern) == "dot")
+                {
+                    return handle_dot(placeholders, pattern);
                 }
 
                 return handle_placeholders(
@@ -376,11 +1115,58 @@ namespace phylanx { namespace execution_tree { namespace compiler
                     ast::to_string(expr));
         }
 
+        // Compile a statement, common subexpressions are evaluated once
+        // before the statement itself.
+        function compile_statement(
+            ast::expression const& expr, environment& env) const
+        {
+            std::vector<ast::expression> common = common_subexpressions(expr);
+            if (common.empty())
+            {
+                return compile_subexpression(expr, env);
+            }
+
+            std::vector<primitive_argument_type> operands;
+            operands.reserve(common.size() + 1);
+
+            std::map<std::string, std::size_t> temporaries = temporaries_;
+            std::size_t num_temporaries = num_temporaries_;
+            for (auto const& subexpr : common)
+            {
+                operands.push_back(compile_subexpression(subexpr, env).arg_);
+                temporaries[ast::to_string(subexpr)] = num_temporaries++;
+            }
+
+            compiler comp{snippets_, env, patterns_, index_, types_,
+                default_locality_, std::move(temporaries), num_temporaries,
+                num_args_};
+            operands.push_back(comp(expr).arg_);
+
+            return function{create_primitive<primitives::let_operation>(
+                default_locality_, std::move(operands)), "let"};
+        }
+
     private:
         environment& env_;
         function_list& snippets_;
         expression_pattern_list const& patterns_;
+        pattern_index const& index_;
+
+        // the inferred types of all subexpressions of the compiled
+        // expression, used to select primitives specialized for the ranks
+        // of their operands
+        type_map const& types_;
+
         hpx::id_type default_locality_;
+
+        // common subexpressions of the enclosing statements, mapped onto
+        // the index of the value appended to the arguments
+        std::map<std::string, std::size_t> temporaries_;
+        std::size_t num_temporaries_;
+
+        // the number of arguments of the enclosing function(s), including
+        // the loop variables of enclosing parallel_for loops
+        std::size_t num_args_;
     };
 
     ///////////////////////////////////////////////////////////////////////////
@@ -389,8 +1175,14 @@ namespace phylanx { namespace execution_tree { namespace compiler
         expression_pattern_list const& patterns,
         hpx::id_type const& default_locality)
     {
-        compiler comp{snippets, env, patterns, default_locality};
-        return comp(expr);
+        pattern_index index(patterns);
+
+        // report operands with incompatible shapes before any of the
+        // primitives is created
+        type_map types = infer_types(expr, index);
+
+        compiler comp{snippets, env, patterns, index, types, default_locality};
+        return comp.compile_statement(expr, env);
     }
 
     function compile(std::vector<ast::expression> const& exprs,
@@ -398,11 +1190,14 @@ namespace phylanx { namespace execution_tree { namespace compiler
         expression_pattern_list const& patterns,
         hpx::id_type const& default_locality)
     {
-        compiler comp{snippets, env, patterns, default_locality};
+        pattern_index index(patterns);
+        type_map types = infer_types(exprs, index);
+
+        compiler comp{snippets, env, patterns, index, types, default_locality};
         function f;
         for (auto const& expr : exprs)
         {
-            f = comp(expr);
+            f = comp.compile_statement(expr, env);
         }
         return f;
     }
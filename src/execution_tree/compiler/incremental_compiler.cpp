@@ -0,0 +1,260 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/detail/is_function_call.hpp>
+#include <phylanx/ast/detail/is_identifier.hpp>
+#include <phylanx/ast/generate_ast.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/ast/traverse.hpp>
+#include <phylanx/execution_tree/compile.hpp>
+#include <phylanx/execution_tree/compiler/actors.hpp>
+#include <phylanx/execution_tree/compiler/compiler.hpp>
+#include <phylanx/execution_tree/compiler/incremental_compiler.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/util/arena.hpp>
+
+#include <hpx/include/naming.hpp>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace compiler
+{
+    namespace detail
+    {
+        // collect all names referenced by an expression (variables and
+        // invoked functions)
+        struct collect_references
+        {
+            std::set<std::string>& names;
+
+            template <typename Ast, typename ... Ts>
+            bool operator()(Ast const&, Ts const&...) const
+            {
+                return true;
+            }
+
+            bool operator()(ast::identifier const& id) const
+            {
+                names.insert(id.name);
+                return true;
+            }
+
+            bool operator()(ast::function_call const& fc) const
+            {
+                names.insert(fc.function_name.name);
+                return true;
+            }
+        };
+
+        // collect the names of all variables which are modified using store()
+        struct collect_stored_names
+        {
+            std::set<std::string>& names;
+
+            template <typename Ast, typename ... Ts>
+            bool operator()(Ast const&, Ts const&...) const
+            {
+                return true;
+            }
+
+            bool operator()(ast::function_call const& fc) const
+            {
+                if (fc.function_name.name == "store" && !fc.args.empty() &&
+                    ast::detail::is_identifier(fc.args[0]))
+                {
+                    names.insert(ast::detail::identifier_name(fc.args[0]));
+                }
+                return true;
+            }
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    incremental_compiler::incremental_compiler(
+            hpx::id_type const& default_locality)
+      : patterns_(get_all_known_expression_patterns())
+      , default_locality_(default_locality)
+      , builtins_(default_environment(*patterns_, default_locality))
+      , env_(new environment(&builtins_))
+      , num_compiled_(0)
+      , num_reused_(0)
+    {}
+
+    // A definition can be reused if its AST did not change, if none of the
+    // definitions it refers to was compiled again, and if all of those are
+    // still defined before it.
+    bool incremental_compiler::is_unchanged(definition const& def,
+        std::map<std::string, std::shared_ptr<definition>> const& current,
+        std::set<std::string> const& recompiled) const
+    {
+        for (auto const& name : def.references)
+        {
+            if (recompiled.find(name) != recompiled.end())
+            {
+                return false;
+            }
+            if (definitions_.find(name) != definitions_.end() &&
+                current.find(name) == current.end())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Decides which of the definitions of the program refer to the
+    // primitives compiled for the previous version. Only the definitions in
+    // the scope of the program (the top-level statements, or the statements
+    // of the top-level block) are considered.
+    class incremental_compiler::program_definitions : public definition_cache
+    {
+    public:
+        program_definitions(incremental_compiler const& compiler,
+                environment const& env, bool is_block,
+                std::set<std::string> const& stored,
+                std::shared_ptr<function_list> const& snippets)
+          : compiler_(compiler)
+          , env_(env)
+          , is_block_(is_block)
+          , stored_(stored)
+          , snippets_(snippets)
+          , num_compiled_(0)
+          , num_reused_(0)
+        {}
+
+        function const* find(std::string const& name,
+            ast::expression const& expr, environment const& scope) override
+        {
+            if (!is_program_scope(scope))
+            {
+                return nullptr;
+            }
+
+            auto it = compiler_.definitions_.find(name);
+            if (it == compiler_.definitions_.end() ||
+                current_.find(name) != current_.end() ||
+                stored_.find(name) != stored_.end() ||
+                it->second->source != ast::to_string(expr) ||
+                !compiler_.is_unchanged(*it->second, current_, recompiled_))
+            {
+                return nullptr;
+            }
+
+            current_[name] = it->second;
+            ++num_reused_;
+            return it->second->f;
+        }
+
+        void add(std::string const& name, ast::expression const& expr,
+            environment const& scope, function const& f) override
+        {
+            if (!is_program_scope(scope))
+            {
+                return;
+            }
+
+            auto def = std::make_shared<definition>();
+            def->source = ast::to_string(expr);
+            ast::traverse(expr, detail::collect_references{def->references});
+            def->references.erase(name);
+            def->snippets = snippets_;
+            def->f = &f;
+
+            current_[name] = std::move(def);
+            recompiled_.insert(name);
+            ++num_compiled_;
+        }
+
+        std::map<std::string, std::shared_ptr<definition>>& current()
+        {
+            return current_;
+        }
+
+        std::size_t num_compiled() const
+        {
+            return num_compiled_;
+        }
+        std::size_t num_reused() const
+        {
+            return num_reused_;
+        }
+
+    private:
+        // the statements of the top-level block are compiled in a scope
+        // nested in the environment of the program
+        bool is_program_scope(environment const& scope) const
+        {
+            return &scope == &env_ ||
+                (is_block_ && scope.parent() == &env_);
+        }
+
+        incremental_compiler const& compiler_;
+        environment const& env_;
+        bool const is_block_;
+        std::set<std::string> const& stored_;
+        std::shared_ptr<function_list> snippets_;
+
+        std::map<std::string, std::shared_ptr<definition>> current_;
+        std::set<std::string> recompiled_;
+
+        std::size_t num_compiled_;
+        std::size_t num_reused_;
+    };
+
+    function incremental_compiler::compile(
+        std::vector<ast::expression> const& exprs)
+    {
+        // the definitions of a single block are handled as if they were
+        // top-level statements
+        bool const is_block = exprs.size() == 1 &&
+            ast::detail::is_function_call(exprs[0]) &&
+            ast::detail::function_name(exprs[0]) == "block";
+
+        // variables modified by the program are always initialized anew
+        std::set<std::string> stored;
+        for (auto const& expr : exprs)
+        {
+            ast::traverse(expr, detail::collect_stored_names{stored});
+        }
+
+        std::unique_ptr<environment> env(new environment(&builtins_));
+        auto snippets = std::make_shared<function_list>();
+
+        // the program is compiled as a whole, the definitions which can be
+        // reused are bound to their existing primitives
+        program_definitions definitions(
+            *this, *env, is_block, stored, snippets);
+        env->set_definition_cache(&definitions);
+
+        function result = compiler::compile(
+            exprs, *snippets, *env, *patterns_, default_locality_);
+
+        env->set_definition_cache(nullptr);
+
+        // replace the previous version of the program
+        env_ = std::move(env);
+        definitions_ = std::move(definitions.current());
+        snippets_ = std::move(snippets);
+
+        num_compiled_ = definitions.num_compiled();
+        num_reused_ = definitions.num_reused();
+
+        return result;
+    }
+
+    function incremental_compiler::compile(std::string const& exprs)
+    {
+        util::arena arena;
+        return compile(ast::generate_asts(exprs, arena));
+    }
+}}}
@@ -0,0 +1,222 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/detail/is_placeholder.hpp>
+#include <phylanx/ast/match_ast.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/execution_tree/compiler/compiler.hpp>
+#include <phylanx/execution_tree/compiler/pattern_index.hpp>
+
+#include <hpx/include/util.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace compiler
+{
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        enum class shape
+        {
+            call,       // function call, e.g. block(__1)
+            unary,      // unary operator, e.g. -_1
+            binary,     // binary operator(s), e.g. _1 + __2
+            other       // anything else
+        };
+
+        // Classify the top-level of an expression the same way as
+        // ast::match_ast looks at it (i.e. ignoring parentheses).
+        shape classify(ast::expression const& expr,
+            ast::function_call const*& fc, ast::unary_expr const*& ue)
+        {
+            ast::expression const& e = ast::detail::extract_expression(expr);
+            if (ast::detail::is_placeholder(e))
+            {
+                return shape::other;
+            }
+
+            if (!e.rest.empty())
+            {
+                return shape::binary;
+            }
+
+            if (e.first.index() == 2)       // unary_expr
+            {
+                ue = &util::get<2>(e.first.get()).get();
+                return shape::unary;
+            }
+
+            if (e.first.index() == 1)       // primary_expr
+            {
+                ast::primary_expr const& pe = util::get<1>(e.first.get()).get();
+                if (pe.index() == 7)        // function_call
+                {
+                    fc = &util::get<7>(pe.get()).get();
+                    if (!ast::detail::is_placeholder(fc->function_name))
+                    {
+                        return shape::call;
+                    }
+                }
+            }
+
+            return shape::other;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    pattern_index::pattern_index(expression_pattern_list const& patterns)
+      : patterns_(patterns)
+    {
+        for (std::size_t i = 0; i != patterns_.size(); ++i)
+        {
+            expression_pattern const& pattern = patterns_[i];
+            names_.emplace(hpx::util::get<0>(pattern), i);
+
+            ast::expression const& expr = hpx::util::get<2>(pattern);
+
+            ast::function_call const* fc = nullptr;
+            ast::unary_expr const* ue = nullptr;
+            switch (detail::classify(expr, fc, ue))
+            {
+            case detail::shape::call:
+                calls_[fc->function_name.name].push_back(i);
+                break;
+
+            case detail::shape::unary:
+                unary_[ue->operator_].push_back(i);
+                break;
+
+            case detail::shape::binary:
+                // all operators of the pattern have to be present in a
+                // matching expression, indexing the first one is sufficient
+                binary_[ast::detail::extract_expression(expr)
+                    .rest.front().operator_].push_back(i);
+                break;
+
+            case detail::shape::other: HPX_FALLTHROUGH;
+            default:
+                generic_.push_back(i);
+                break;
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<expression_pattern const*> pattern_index::merge(
+        std::vector<std::vector<std::size_t> const*> const& buckets) const
+    {
+        std::vector<std::size_t> indices;
+        for (auto const* bucket : buckets)
+        {
+            indices.insert(indices.end(), bucket->begin(), bucket->end());
+        }
+
+        // the buckets are disjoint, restore the original order of patterns
+        if (buckets.size() > 1)
+        {
+            std::sort(indices.begin(), indices.end());
+        }
+
+        std::vector<expression_pattern const*> result;
+        result.reserve(indices.size());
+        for (std::size_t i : indices)
+        {
+            result.push_back(&patterns_[i]);
+        }
+        return result;
+    }
+
+    std::vector<expression_pattern const*> pattern_index::candidates(
+        ast::expression const& expr) const
+    {
+        std::vector<std::vector<std::size_t> const*> buckets;
+        if (!generic_.empty())
+        {
+            buckets.push_back(&generic_);
+        }
+
+        ast::function_call const* fc = nullptr;
+        ast::unary_expr const* ue = nullptr;
+        switch (detail::classify(expr, fc, ue))
+        {
+        case detail::shape::call:
+            {
+                auto it = calls_.find(fc->function_name.name);
+                if (it != calls_.end())
+                {
+                    buckets.push_back(&it->second);
+                }
+            }
+            break;
+
+        case detail::shape::unary:
+            {
+                auto it = unary_.find(ue->operator_);
+                if (it != unary_.end())
+                {
+                    buckets.push_back(&it->second);
+                }
+            }
+            break;
+
+        case detail::shape::binary:
+            {
+                std::vector<ast::optoken> tokens;
+                for (auto const& op :
+                    ast::detail::extract_expression(expr).rest)
+                {
+                    if (std::find(tokens.begin(), tokens.end(),
+                            op.operator_) != tokens.end())
+                    {
+                        continue;
+                    }
+                    tokens.push_back(op.operator_);
+
+                    auto it = binary_.find(op.operator_);
+                    if (it != binary_.end())
+                    {
+                        buckets.push_back(&it->second);
+                    }
+                }
+            }
+            break;
+
+        case detail::shape::other: HPX_FALLTHROUGH;
+        default:
+            // placeholders (and function calls through placeholders) may
+            // match any of the patterns
+            if (ast::detail::is_placeholder(
+                    ast::detail::extract_expression(expr)) ||
+                fc != nullptr)
+            {
+                std::vector<expression_pattern const*> result;
+                result.reserve(patterns_.size());
+                for (auto const& pattern : patterns_)
+                {
+                    result.push_back(&pattern);
+                }
+                return result;
+            }
+            break;
+        }
+
+        return merge(buckets);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    expression_pattern const* pattern_index::find(std::string const& name) const
+    {
+        auto it = names_.find(name);
+        if (it == names_.end())
+        {
+            return nullptr;
+        }
+        return &patterns_[it->second];
+    }
+}}}
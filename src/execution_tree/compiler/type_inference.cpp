@@ -0,0 +1,676 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/detail/is_function_call.hpp>
+#include <phylanx/ast/detail/is_identifier.hpp>
+#include <phylanx/ast/detail/is_literal_value.hpp>
+#include <phylanx/ast/match_ast.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/ast/traverse.hpp>
+#include <phylanx/execution_tree/compiler/compiler.hpp>
+#include <phylanx/execution_tree/compiler/pattern_index.hpp>
+#include <phylanx/execution_tree/compiler/type_inference.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace compiler
+{
+    ///////////////////////////////////////////////////////////////////////////
+    inferred_type join(inferred_type const& lhs, inferred_type const& rhs)
+    {
+        if (lhs.kind != rhs.kind)
+        {
+            return inferred_type{};
+        }
+
+        inferred_type result(lhs.kind);
+        if (lhs.rank == rhs.rank)
+        {
+            result.rank = lhs.rank;
+            for (std::size_t i = 0; i != result.dimensions.size(); ++i)
+            {
+                if (lhs.dimensions[i] == rhs.dimensions[i])
+                {
+                    result.dimensions[i] = lhs.dimensions[i];
+                }
+            }
+        }
+        return result;
+    }
+
+    namespace detail
+    {
+        char const* const kind_names[] =
+        {
+            "unknown", "nil", "boolean", "integer", "string", "numeric",
+            "float32", "list", "function"
+        };
+
+        std::string extent(std::size_t value)
+        {
+            return value != 0 ? std::to_string(value) : std::string("?");
+        }
+    }
+
+    std::string to_string(inferred_type const& type)
+    {
+        std::string result = detail::kind_names[type.kind];
+        switch (type.rank)
+        {
+        case 0:
+            return result + " scalar";
+
+        case 1:
+            return result + " vector of size " +
+                detail::extent(type.dimensions[0]);
+
+        case 2:
+            return result + " matrix of size " +
+                detail::extent(type.dimensions[0]) + "x" +
+                detail::extent(type.dimensions[1]);
+
+        default:
+            break;
+        }
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // collect the names of all variables which are modified using store()
+        struct collect_stored_names
+        {
+            std::set<std::string>& names;
+
+            template <typename Ast, typename ... Ts>
+            bool operator()(Ast const&, Ts const&...) const
+            {
+                return true;
+            }
+
+            bool operator()(ast::function_call const& fc) const
+            {
+                if (fc.function_name.name == "store" && !fc.args.empty() &&
+                    ast::detail::is_identifier(fc.args[0]))
+                {
+                    names.insert(ast::detail::identifier_name(fc.args[0]));
+                }
+                return true;
+            }
+        };
+
+        // booleans and integers are converted to numeric scalars by all
+        // arithmetic primitives
+        bool is_numeric(inferred_type const& type)
+        {
+            return type.kind == inferred_type::boolean ||
+                type.kind == inferred_type::integer ||
+                type.kind == inferred_type::numeric;
+        }
+
+        inferred_type numeric_result(inferred_type const& type)
+        {
+            inferred_type result = type;
+            result.kind = inferred_type::numeric;
+            return result;
+        }
+
+        // Both extents have to be equal if both of them are known, return
+        // the known one.
+        bool merge_extent(std::size_t lhs, std::size_t rhs, std::size_t& result)
+        {
+            if (lhs != 0 && rhs != 0 && lhs != rhs)
+            {
+                return false;
+            }
+            result = lhs != 0 ? lhs : rhs;
+            return true;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // The inference mirrors the way the compiler matches the expressions
+        // against the known patterns. It is conservative: any expression
+        // which can't be fully understood (unknown primitives, function
+        // calls, variables modified using store(), etc.) is considered to
+        // be of unknown type, which disables all checks which depend on it.
+        class type_inference
+        {
+        public:
+            type_inference(pattern_index const& index,
+                    type_map const& variables)
+              : index_(index)
+              , scopes_(1, variables)
+              , barrier_(0)
+            {}
+
+            void prepare(ast::expression const& expr)
+            {
+                ast::traverse(expr, collect_stored_names{stored_});
+            }
+
+            inferred_type operator()(ast::expression const& expr)
+            {
+                inferred_type result = infer(expr);
+
+                auto p = types_.emplace(ast::to_string(expr), result);
+                if (!p.second && p.first->second != result)
+                {
+                    p.first->second = join(p.first->second, result);
+                }
+                return result;
+            }
+
+            type_map& types()
+            {
+                return types_;
+            }
+
+        private:
+            inferred_type infer(ast::expression const& expr)
+            {
+                for (auto const* candidate : index_.candidates(expr))
+                {
+                    expression_pattern const& pattern = *candidate;
+
+                    std::multimap<std::string, ast::expression> placeholders;
+                    if (!ast::match_ast(expr, hpx::util::get<2>(pattern),
+                            on_placeholder_match{placeholders}))
+                    {
+                        continue;   // no match found for the current pattern
+                    }
+
+                    std::vector<ast::expression> operands;
+                    operands.reserve(placeholders.size());
+                    for (auto const& placeholder : placeholders)
+                    {
+                        operands.push_back(placeholder.second);
+                    }
+
+                    return infer_pattern(
+                        hpx::util::get<0>(pattern), operands, expr);
+                }
+
+                if (ast::detail::is_identifier(expr))
+                {
+                    return find_variable(ast::detail::identifier_name(expr));
+                }
+
+                if (ast::detail::is_function_call(expr))
+                {
+                    // the arguments are evaluated in the scope of the caller
+                    for (auto const& arg :
+                        ast::detail::function_arguments(expr))
+                    {
+                        (*this)(arg);
+                    }
+                    return inferred_type{};
+                }
+
+                if (ast::detail::is_literal_value(expr))
+                {
+                    return literal_type(ast::detail::literal_value(expr));
+                }
+
+                return inferred_type{};
+            }
+
+            static inferred_type literal_type(ast::literal_value_type&& val)
+            {
+                switch (val.index())
+                {
+                case 0:     // nil
+                    return inferred_type(inferred_type::nil);
+
+                case 1:     // bool
+                    return inferred_type::scalar(inferred_type::boolean);
+
+                case 2:     // std::int64_t
+                    return inferred_type::scalar(inferred_type::integer);
+
+                case 3:     // std::string
+                    return inferred_type(inferred_type::string);
+
+                case 4:     // phylanx::ir::node_data<double>
+                    {
+                        auto const& data =
+                            util::get<ir::node_data<double>>(val);
+                        auto dims = data.dimensions();
+                        return inferred_type(inferred_type::numeric,
+                            int(data.num_dimensions()), dims[0], dims[1]);
+                    }
+
+                default:
+                    break;
+                }
+                return inferred_type{};
+            }
+
+            inferred_type find_variable(std::string const& name) const
+            {
+                if (stored_.find(name) != stored_.end())
+                {
+                    return inferred_type{};
+                }
+
+                for (std::size_t i = scopes_.size(); i != barrier_; --i)
+                {
+                    auto found = scopes_[i - 1].find(name);
+                    if (found != scopes_[i - 1].end())
+                    {
+                        return found->second;
+                    }
+                }
+                return inferred_type{};
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            [[noreturn]] static void report_mismatch(std::string const& name,
+                inferred_type const& lhs, inferred_type const& rhs,
+                ast::expression const& expr)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::compiler::infer_types",
+                    "the operands of '" + name + "' have incompatible "
+                        "shapes (" + to_string(lhs) + " and " +
+                        to_string(rhs) + "): " + ast::to_string(expr));
+            }
+
+            // +, -, / and the element-wise forms of *
+            inferred_type elementwise(std::string const& name,
+                inferred_type const& lhs, inferred_type const& rhs,
+                ast::expression const& expr) const
+            {
+                if (lhs.rank == 0)
+                {
+                    return numeric_result(rhs);
+                }
+                if (rhs.rank == 0)
+                {
+                    return numeric_result(lhs);
+                }
+                if (!lhs.has_rank() || !rhs.has_rank())
+                {
+                    return inferred_type(inferred_type::numeric);
+                }
+                if (lhs.rank != rhs.rank)
+                {
+                    report_mismatch(name, lhs, rhs, expr);
+                }
+
+                inferred_type result(inferred_type::numeric, lhs.rank);
+                for (std::size_t i = 0; i != result.dimensions.size(); ++i)
+                {
+                    if (!merge_extent(lhs.dimensions[i], rhs.dimensions[i],
+                            result.dimensions[i]))
+                    {
+                        report_mismatch(name, lhs, rhs, expr);
+                    }
+                }
+                return result;
+            }
+
+            // vector/matrix products as performed by '*' and dot()
+            inferred_type product(std::string const& name,
+                inferred_type const& lhs, inferred_type const& rhs,
+                ast::expression const& expr) const
+            {
+                std::size_t inner = 0;
+                if (lhs.rank == 1 && rhs.rank == 2)
+                {
+                    if (!merge_extent(
+                            lhs.dimensions[0], rhs.dimensions[0], inner))
+                    {
+                        report_mismatch(name, lhs, rhs, expr);
+                    }
+                    return inferred_type(
+                        inferred_type::numeric, 1, rhs.dimensions[1], 1);
+                }
+
+                if (lhs.rank == 2 && rhs.rank == 1)
+                {
+                    if (!merge_extent(
+                            lhs.dimensions[1], rhs.dimensions[0], inner))
+                    {
+                        report_mismatch(name, lhs, rhs, expr);
+                    }
+                    return inferred_type(
+                        inferred_type::numeric, 1, lhs.dimensions[0], 1);
+                }
+
+                // lhs.rank == 2 && rhs.rank == 2
+                if (!merge_extent(lhs.dimensions[1], rhs.dimensions[0], inner))
+                {
+                    report_mismatch(name, lhs, rhs, expr);
+                }
+                return inferred_type(inferred_type::numeric, 2,
+                    lhs.dimensions[0], rhs.dimensions[1]);
+            }
+
+            inferred_type multiply(std::string const& name,
+                inferred_type const& lhs, inferred_type const& rhs,
+                ast::expression const& expr) const
+            {
+                if (lhs.rank <= 0 || rhs.rank <= 0 ||
+                    (lhs.rank == 1 && rhs.rank == 1))
+                {
+                    return elementwise(name, lhs, rhs, expr);
+                }
+                return product(name, lhs, rhs, expr);
+            }
+
+            inferred_type dot(std::string const& name,
+                inferred_type const& lhs, inferred_type const& rhs,
+                ast::expression const& expr) const
+            {
+                if (!lhs.has_rank() || !rhs.has_rank())
+                {
+                    return inferred_type(inferred_type::numeric);
+                }
+
+                if (lhs.rank == 0 || rhs.rank == 0)
+                {
+                    if (lhs.rank != rhs.rank)
+                    {
+                        report_mismatch(name, lhs, rhs, expr);
+                    }
+                    return inferred_type::scalar(inferred_type::numeric);
+                }
+
+                if (lhs.rank == 1 && rhs.rank == 1)
+                {
+                    std::size_t size = 0;
+                    if (!merge_extent(
+                            lhs.dimensions[0], rhs.dimensions[0], size))
+                    {
+                        report_mismatch(name, lhs, rhs, expr);
+                    }
+                    return inferred_type::scalar(inferred_type::numeric);
+                }
+
+                return product(name, lhs, rhs, expr);
+            }
+
+            template <typename F>
+            inferred_type binary(std::string const& name,
+                std::vector<ast::expression> const& operands,
+                ast::expression const& expr, F && f)
+            {
+                std::vector<inferred_type> types;
+                types.reserve(operands.size());
+                for (auto const& operand : operands)
+                {
+                    types.push_back((*this)(operand));
+                }
+
+                // primitives handle more than two operands in special ways,
+                // all operands have to be numeric values
+                if (types.size() != 2 || !is_numeric(types[0]) ||
+                    !is_numeric(types[1]))
+                {
+                    return inferred_type{};
+                }
+                return (this->*f)(name, types[0], types[1], expr);
+            }
+
+            inferred_type compare(std::vector<ast::expression> const& operands)
+            {
+                bool scalars = true;
+                for (auto const& operand : operands)
+                {
+                    inferred_type type = (*this)(operand);
+                    if (type.rank != 0 || !is_numeric(type))
+                    {
+                        scalars = false;
+                    }
+                }
+
+                if (scalars)
+                {
+                    return inferred_type::scalar(inferred_type::boolean);
+                }
+                return inferred_type{};
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            inferred_type infer_block(
+                std::vector<ast::expression> const& operands)
+            {
+                scopes_.emplace_back();
+
+                inferred_type result(inferred_type::nil);
+                for (auto const& operand : operands)
+                {
+                    result = (*this)(operand);
+                }
+
+                scopes_.pop_back();
+                return result;
+            }
+
+            inferred_type infer_define(
+                std::vector<ast::expression> const& operands)
+            {
+                if (operands.size() < 2 ||
+                    !ast::detail::is_identifier(operands[0]))
+                {
+                    return inferred_type{};
+                }
+
+                std::string name = ast::detail::identifier_name(operands[0]);
+                if (operands.size() == 2)
+                {
+                    // define variable
+                    scopes_.emplace_back();
+                    inferred_type result = (*this)(operands[1]);
+                    scopes_.pop_back();
+
+                    scopes_.back()[name] = result;
+                    return result;
+                }
+
+                // define function, the arguments are not known
+                scopes_.back()[name] = inferred_type(inferred_type::function);
+
+                scopes_.emplace_back();
+                for (std::size_t i = 1; i != operands.size() - 1; ++i)
+                {
+                    if (ast::detail::is_identifier(operands[i]))
+                    {
+                        scopes_.back()[ast::detail::identifier_name(
+                            operands[i])] = inferred_type{};
+                    }
+                }
+                (*this)(operands.back());
+                scopes_.pop_back();
+
+                return inferred_type(inferred_type::function);
+            }
+
+            // control structures introduce a scope for their operands
+            inferred_type infer_scoped(
+                std::vector<ast::expression> const& operands)
+            {
+                scopes_.emplace_back();
+
+                std::vector<inferred_type> types;
+                types.reserve(operands.size());
+                for (auto const& operand : operands)
+                {
+                    types.push_back((*this)(operand));
+                }
+
+                scopes_.pop_back();
+
+                if (types.size() == 3)      // if(_1, _2, _3)
+                {
+                    return join(types[1], types[2]);
+                }
+                return inferred_type{};
+            }
+
+            inferred_type infer_pattern(std::string const& name,
+                std::vector<ast::expression> const& operands,
+                ast::expression const& expr)
+            {
+                if (name == "block")
+                    return infer_block(operands);
+                if (name == "define")
+                    return infer_define(operands);
+                if (name == "if1" || name == "if2" || name == "while" ||
+                    name == "for")
+                {
+                    return infer_scoped(operands);
+                }
+                if (name == "store")
+                    return (*this)(operands[1]);
+
+                if (name == "add" || name == "sub" || name == "div")
+                    return binary(
+                        name, operands, expr, &type_inference::elementwise);
+                if (name == "mul")
+                    return binary(
+                        name, operands, expr, &type_inference::multiply);
+                if (name == "dot")
+                    return binary(name, operands, expr, &type_inference::dot);
+
+                if (name == "lt" || name == "le" || name == "gt" ||
+                    name == "ge" || name == "eq" || name == "ne" ||
+                    name == "and" || name == "or")
+                {
+                    return compare(operands);
+                }
+
+                if (name == "minus" || name == "exp")
+                {
+                    inferred_type type = (*this)(operands[0]);
+                    return is_numeric(type) ?
+                        numeric_result(type) : inferred_type{};
+                }
+                if (name == "not")
+                {
+                    return compare(operands);
+                }
+                if (name == "transpose")
+                {
+                    inferred_type type = (*this)(operands[0]);
+                    if (!is_numeric(type))
+                    {
+                        return inferred_type{};
+                    }
+                    if (type.rank == 2)
+                    {
+                        std::swap(type.dimensions[0], type.dimensions[1]);
+                    }
+                    return numeric_result(type);
+                }
+                if (name == "float32")
+                {
+                    inferred_type type = (*this)(operands[0]);
+                    return inferred_type(inferred_type::float32, type.rank,
+                        type.dimensions[0], type.dimensions[1]);
+                }
+
+                if (name == "constant1" || name == "constant2")
+                {
+                    (*this)(operands[0]);
+                    if (operands.size() == 1)
+                    {
+                        return inferred_type::scalar(inferred_type::numeric);
+                    }
+
+                    // constant(value, size) creates a vector
+                    (*this)(operands[1]);
+                    if (ast::detail::is_literal_value(operands[1]))
+                    {
+                        ast::literal_value_type size =
+                            ast::detail::literal_value(operands[1]);
+                        if (size.index() == 2 &&
+                            util::get<std::int64_t>(size) > 0)
+                        {
+                            return inferred_type(inferred_type::numeric, 1,
+                                std::size_t(util::get<std::int64_t>(size)), 1);
+                        }
+                    }
+                    return inferred_type(inferred_type::numeric);
+                }
+
+                if (name == "shape1")
+                {
+                    (*this)(operands[0]);
+                    return inferred_type(inferred_type::list);
+                }
+                if (name == "shape2")
+                {
+                    (*this)(operands[0]);
+                    return inferred_type::scalar(inferred_type::integer);
+                }
+
+                // The operands of all other primitives are inspected without
+                // referring to any enclosing variables as those primitives
+                // might bind names themselves (e.g. lambda). This records
+                // the (mostly unknown) types of all of their subexpressions.
+                std::size_t barrier = barrier_;
+                scopes_.emplace_back();
+                barrier_ = scopes_.size() - 1;
+
+                for (auto const& operand : operands)
+                {
+                    (*this)(operand);
+                }
+
+                scopes_.pop_back();
+                barrier_ = barrier;
+
+                return inferred_type{};
+            }
+
+        private:
+            pattern_index const& index_;
+            std::vector<type_map> scopes_;
+
+            // variables defined in scopes below this one are not visible
+            std::size_t barrier_;
+            std::set<std::string> stored_;
+            type_map types_;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    type_map infer_types(ast::expression const& expr,
+        pattern_index const& index, type_map const& variables)
+    {
+        detail::type_inference infer(index, variables);
+        infer.prepare(expr);
+        infer(expr);
+        return std::move(infer.types());
+    }
+
+    type_map infer_types(std::vector<ast::expression> const& exprs,
+        pattern_index const& index, type_map const& variables)
+    {
+        detail::type_inference infer(index, variables);
+        for (auto const& expr : exprs)
+        {
+            infer.prepare(expr);
+        }
+        for (auto const& expr : exprs)
+        {
+            infer(expr);
+        }
+        return std::move(infer.types());
+    }
+}}}
@@ -0,0 +1,264 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/detail/is_function_call.hpp>
+#include <phylanx/ast/detail/is_identifier.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/ast/traverse.hpp>
+#include <phylanx/execution_tree/compiler/compiler.hpp>
+#include <phylanx/execution_tree/compiler/variable_access.hpp>
+
+#include <hpx/include/util.hpp>
+
+#include <cstddef>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace compiler
+{
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        bool intersects(std::set<std::string> const& lhs,
+            std::set<std::string> const& rhs)
+        {
+            auto it1 = lhs.begin();
+            auto it2 = rhs.begin();
+            while (it1 != lhs.end() && it2 != rhs.end())
+            {
+                if (*it1 < *it2)
+                    ++it1;
+                else if (*it2 < *it1)
+                    ++it2;
+                else
+                    return true;
+            }
+            return false;
+        }
+
+        std::set<std::string> builtin_names(
+            expression_pattern_list const& patterns)
+        {
+            std::set<std::string> names;
+            for (auto const& pattern : patterns)
+            {
+                ast::expression const& expr = hpx::util::get<2>(pattern);
+                if (ast::detail::is_function_call(expr))
+                {
+                    names.insert(ast::detail::function_name(expr));
+                }
+            }
+            return names;
+        }
+
+        struct collect_variable_access
+        {
+            variable_access& access;
+            std::set<std::string> const& builtins;
+
+            template <typename Ast, typename ... Ts>
+            bool operator()(Ast const&, Ts const&...) const
+            {
+                return true;
+            }
+
+            bool operator()(ast::identifier const& id) const
+            {
+                access.reads.insert(id.name);
+                return true;
+            }
+
+            bool operator()(ast::function_call const& fc) const
+            {
+                std::string const& name = fc.function_name.name;
+                if (name == "store" || name == "define")
+                {
+                    if (!fc.args.empty() &&
+                        ast::detail::is_identifier(fc.args[0]))
+                    {
+                        access.writes.insert(
+                            ast::detail::identifier_name(fc.args[0]));
+                    }
+                    else
+                    {
+                        access.has_side_effects = true;
+                    }
+                }
+                else if (builtins.find(name) == builtins.end() ||
+                    name == "map")
+                {
+                    access.has_side_effects = true;
+                    access.invokes_functions = true;
+                }
+                else if (compiler::has_side_effects(name))
+                {
+                    access.has_side_effects = true;
+                }
+                return true;
+            }
+        };
+
+        variable_access analyze_variable_access(ast::expression const& expr,
+            std::set<std::string> const& builtins)
+        {
+            variable_access result;
+            ast::traverse(expr, collect_variable_access{result, builtins});
+            return result;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // built-in functions which interact with the outside world, which invoke
+    // functions passed as arguments, or which don't return the same value
+    // when invoked twice
+    bool has_side_effects(std::string const& name)
+    {
+        return name == "cout" || name == "file_read" ||
+            name == "file_write" || name == "file_read_csv" ||
+            name == "file_write_csv" || name == "map" || name == "random" ||
+            name == "randomized_svd";
+    }
+
+    bool variable_access::depends_on(variable_access const& rhs) const
+    {
+        if (has_side_effects || rhs.has_side_effects)
+        {
+            return true;
+        }
+
+        // read after write, write after write, and write after read
+        return detail::intersects(reads, rhs.writes) ||
+            detail::intersects(writes, rhs.writes) ||
+            detail::intersects(writes, rhs.reads);
+    }
+
+    variable_access analyze_variable_access(
+        ast::expression const& expr, expression_pattern_list const& patterns)
+    {
+        return detail::analyze_variable_access(
+            expr, detail::builtin_names(patterns));
+    }
+
+    std::vector<std::vector<std::size_t>> statement_dependencies(
+        std::vector<ast::expression> const& statements,
+        expression_pattern_list const& patterns)
+    {
+        std::set<std::string> builtins = detail::builtin_names(patterns);
+
+        std::vector<variable_access> accesses;
+        accesses.reserve(statements.size());
+        for (auto const& statement : statements)
+        {
+            accesses.push_back(
+                detail::analyze_variable_access(statement, builtins));
+        }
+
+        std::vector<std::vector<std::size_t>> result(statements.size());
+        for (std::size_t i = 0; i != statements.size(); ++i)
+        {
+            for (std::size_t j = 0; j != i; ++j)
+            {
+                if (accesses[i].depends_on(accesses[j]))
+                {
+                    result[i].push_back(j);
+                }
+            }
+        }
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // return the name defined by the given statement, if it is a
+        // definition whose removal doesn't change the program otherwise
+        bool is_removable_definition(ast::expression const& statement,
+            std::set<std::string> const& builtins, std::string& name)
+        {
+            if (!ast::detail::is_function_call(statement) ||
+                ast::detail::function_name(statement) != "define")
+            {
+                return false;
+            }
+
+            std::vector<ast::expression> args =
+                ast::detail::function_arguments(statement);
+            if (args.size() < 2 || !ast::detail::is_identifier(args[0]))
+            {
+                return false;
+            }
+
+            // variables are initialized right away, defining a function
+            // doesn't evaluate its body
+            if (args.size() == 2)
+            {
+                variable_access access =
+                    analyze_variable_access(args[1], builtins);
+                if (access.has_side_effects || !access.writes.empty())
+                {
+                    return false;
+                }
+            }
+
+            name = ast::detail::identifier_name(args[0]);
+            return true;
+        }
+    }
+
+    std::vector<ast::expression> remove_unused_definitions(
+        std::vector<ast::expression> statements,
+        expression_pattern_list const& patterns)
+    {
+        std::set<std::string> builtins = detail::builtin_names(patterns);
+
+        // removing a definition might make others unused as well
+        bool changed = true;
+        while (changed && statements.size() > 1)
+        {
+            changed = false;
+
+            std::vector<variable_access> accesses;
+            accesses.reserve(statements.size());
+            for (auto const& statement : statements)
+            {
+                accesses.push_back(
+                    detail::analyze_variable_access(statement, builtins));
+            }
+
+            // the last statement determines the value of the block
+            for (std::size_t i = 0; i != statements.size() - 1; ++i)
+            {
+                std::string name;
+                if (!detail::is_removable_definition(
+                        statements[i], builtins, name))
+                {
+                    continue;
+                }
+
+                bool referenced = false;
+                for (std::size_t j = 0; j != statements.size(); ++j)
+                {
+                    if (j != i && accesses[j].reads.find(name) !=
+                            accesses[j].reads.end())
+                    {
+                        referenced = true;
+                        break;
+                    }
+                }
+
+                if (!referenced)
+                {
+                    statements.erase(statements.begin() + i);
+                    changed = true;
+                    break;
+                }
+            }
+        }
+
+        return statements;
+    }
+}}}
@@ -6,6 +6,18 @@
 #include <phylanx/config.hpp>
 #include <phylanx/execution_tree/primitives.hpp>
 #include <phylanx/execution_tree/compile.hpp>
+#include <phylanx/execution_tree/compiler/compiler.hpp>
+
+#include <hpx/include/local_lcos.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace phylanx { namespace execution_tree
 {
@@ -22,22 +34,34 @@ namespace phylanx { namespace execution_tree
             primitives::row_slicing_operation::match_data,
             primitives::column_slicing_operation::match_data,
             primitives::console_output::match_data,
+            primitives::multi_dot_operation::match_data,
             // n-nary functions
             primitives::if_conditional::match_data,
+            primitives::einsum_operation::match_data,
+            primitives::randomized_svd::match_data,
             primitives::for_operation::match_data,
+            primitives::parallel_for_operation::match_data,
             // binary functions
+            primitives::batched_dot::match_data,
+            primitives::batched_solve::match_data,
             primitives::cross_operation::match_data,
             primitives::dot_operation::match_data,
+            primitives::kron_operation::match_data,
+            primitives::map_operation::match_data,
+            primitives::scheduled_operation::match_data,
+            primitives::outer_operation::match_data,
             primitives::file_read::match_data,
             primitives::file_write::match_data,
             primitives::file_read_csv::match_data,
             primitives::file_write_csv::match_data,
             primitives::while_operation::match_data,
             // unary functions
+            primitives::batched_inverse::match_data,
             primitives::constant::match_data,
             primitives::determinant::match_data,
             primitives::exponential_operation::match_data,
             primitives::extract_shape::match_data,
+            primitives::float32_operation::match_data,
             primitives::inverse_operation::match_data,
             primitives::transpose_operation::match_data,
             primitives::random::match_data,
@@ -63,4 +87,82 @@ namespace phylanx { namespace execution_tree
 
         return patterns;
     }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // The parsed patterns are generated once and shared by all
+        // compilations. Registering additional patterns replaces the shared
+        // list with an extended copy, compilations which are in flight keep
+        // using the list they started with.
+        struct pattern_registry
+        {
+            pattern_registry()
+              : patterns_(std::make_shared<compiler::expression_pattern_list>(
+                    compiler::generate_patterns(get_all_known_patterns())))
+            {}
+
+            std::shared_ptr<compiler::expression_pattern_list const> get() const
+            {
+                return std::atomic_load(&patterns_);
+            }
+
+            void add(std::vector<match_pattern_type> const& patterns)
+            {
+                compiler::expression_pattern_list added =
+                    compiler::generate_patterns(pattern_list{patterns});
+
+                std::lock_guard<mutex_type> l(mtx_);
+
+                auto result =
+                    std::make_shared<compiler::expression_pattern_list>(
+                        *patterns_);
+
+                result->reserve(result->size() + added.size());
+                for (auto& pattern : added)
+                {
+                    for (auto const& known : *result)
+                    {
+                        if (hpx::util::get<0>(known) ==
+                            hpx::util::get<0>(pattern))
+                        {
+                            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                                "phylanx::execution_tree::register_patterns",
+                                "a pattern with the given name is already "
+                                    "registered: " +
+                                    hpx::util::get<0>(pattern));
+                        }
+                    }
+                    result->push_back(std::move(pattern));
+                }
+
+                std::atomic_store(&patterns_,
+                    std::shared_ptr<compiler::expression_pattern_list const>(
+                        std::move(result)));
+            }
+
+        private:
+            using mutex_type = hpx::lcos::local::spinlock;
+
+            mutex_type mtx_;
+            std::shared_ptr<compiler::expression_pattern_list const> patterns_;
+        };
+
+        pattern_registry& get_pattern_registry()
+        {
+            static pattern_registry registry;
+            return registry;
+        }
+    }
+
+    std::shared_ptr<compiler::expression_pattern_list const>
+    get_all_known_expression_patterns()
+    {
+        return detail::get_pattern_registry().get();
+    }
+
+    void register_patterns(std::vector<match_pattern_type> const& patterns)
+    {
+        detail::get_pattern_registry().add(patterns);
+    }
 }}
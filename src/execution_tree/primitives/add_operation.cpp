@@ -265,10 +265,30 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 }
             }
 
-        public:
-            hpx::future<primitive_result_type> eval(
-                std::vector<primitive_argument_type> const& operands,
-                std::vector<primitive_argument_type> const& args) const
+            primitive_result_type add_all(args_type && args) const
+            {
+                std::size_t lhs_dims = args[0].num_dimensions();
+                switch (lhs_dims)
+                {
+                case 0:
+                    return add0d(std::move(args));
+
+                case 1:
+                    return add1d(std::move(args));
+
+                case 2:
+                    return add2d(std::move(args));
+
+                default:
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "add_operation::eval",
+                        "left hand side operand has unsupported "
+                            "number of dimensions");
+                }
+            }
+
+            void verify_operands(
+                std::vector<primitive_argument_type> const& operands) const
             {
                 if (operands.size() < 2)
                 {
@@ -294,32 +314,32 @@ namespace phylanx { namespace execution_tree { namespace primitives
                         "the add_operation primitive requires that the "
                             "arguments given by the operands array are valid");
                 }
+            }
+
+        public:
+            hpx::future<primitive_result_type> eval(
+                std::vector<primitive_argument_type> const& operands,
+                std::vector<primitive_argument_type> const& args) const
+            {
+                verify_operands(operands);
 
                 auto this_ = this->shared_from_this();
-                return hpx::dataflow(hpx::util::unwrapping(
+                return detail::invoke_when_ready(
                     [this_](args_type && args) -> primitive_result_type
                     {
-                        std::size_t lhs_dims = args[0].num_dimensions();
-                        switch (lhs_dims)
-                        {
-                        case 0:
-                            return this_->add0d(std::move(args));
-
-                        case 1:
-                            return this_->add1d(std::move(args));
-
-                        case 2:
-                            return this_->add2d(std::move(args));
-
-                        default:
-                            HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                                "add_operation::eval",
-                                "left hand side operand has unsupported "
-                                    "number of dimensions");
-                        }
-                    }),
-                    detail::map_operands(operands, numeric_operand, args)
-                );
+                        return this_->add_all(std::move(args));
+                    },
+                    detail::map_operands(operands, numeric_operand, args));
+            }
+
+            primitive_result_type eval_direct(
+                std::vector<primitive_argument_type> const& operands,
+                std::vector<primitive_argument_type> const& args) const
+            {
+                verify_operands(operands);
+
+                return add_all(detail::map_operands_concurrently(
+                    operands, numeric_operand_sync, args));
             }
         };
     }
@@ -335,4 +355,15 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         return std::make_shared<detail::add>()->eval(operands_, args);
     }
+
+    primitive_result_type add_operation::eval_direct(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        if (operands_.empty())
+        {
+            return detail::add{}.eval_direct(args, noargs);
+        }
+
+        return detail::add{}.eval_direct(operands_, args);
+    }
 }}}
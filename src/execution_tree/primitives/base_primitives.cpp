@@ -76,6 +76,11 @@ namespace phylanx { namespace execution_tree
     hpx::future<primitive_argument_type> primitive::eval(
         std::vector<primitive_argument_type> const& params) const
     {
+        if (local_)
+        {
+            return local_->eval_nonvirtual(params);
+        }
+
         using action_type = primitives::base_primitive::eval_action;
         return hpx::async(action_type(), this->base_type::get_id(), params);
     }
@@ -89,6 +94,11 @@ namespace phylanx { namespace execution_tree
     primitive_argument_type primitive::eval_direct(
         std::vector<primitive_argument_type> const& params) const
     {
+        if (local_)
+        {
+            return local_->eval_direct_nonvirtual(params);
+        }
+
         using action_type = primitives::base_primitive::eval_direct_action;
         return action_type()(this->base_type::get_id(), params);
     }
@@ -101,6 +111,12 @@ namespace phylanx { namespace execution_tree
 
     hpx::future<void> primitive::store(primitive_argument_type const& data)
     {
+        if (local_)
+        {
+            local_->store_nonvirtual(data);
+            return hpx::make_ready_future();
+        }
+
         using action_type = primitives::base_primitive::store_action;
         return hpx::async(action_type(), this->base_type::get_id(), data);
     }
@@ -108,12 +124,21 @@ namespace phylanx { namespace execution_tree
     void primitive::store(hpx::launch::sync_policy,
         primitive_argument_type const& data)
     {
+        if (local_)
+        {
+            return local_->store_nonvirtual(data);
+        }
         return store(data).get();
     }
 
     hpx::future<bool> primitive::bind(
         std::vector<primitive_argument_type> const& args)
     {
+        if (local_)
+        {
+            return hpx::make_ready_future(local_->bind_nonvirtual(args));
+        }
+
         using action_type = primitives::base_primitive::bind_action;
         return hpx::async(action_type(), this->base_type::get_id(), args);
     }
@@ -121,6 +146,10 @@ namespace phylanx { namespace execution_tree
     bool primitive::bind(hpx::launch::sync_policy,
         std::vector<primitive_argument_type> const& args)
     {
+        if (local_)
+        {
+            return local_->bind_nonvirtual(args);
+        }
         return bind(args).get();
     }
 
@@ -137,6 +166,7 @@ namespace phylanx { namespace execution_tree
         case 5:     // primitive
         case 6:     // std::vector<ast::expression>
         case 7:     // std::vector<primitive_argument_type>
+        case 8:     // phylanx::ir::node_data<float>
             return val;
 
         default:
@@ -160,6 +190,7 @@ namespace phylanx { namespace execution_tree
         case 5:     // primitive
         case 6:     // std::vector<ast::expression>
         case 7:     // std::vector<primitive_argument_type>
+        case 8:     // phylanx::ir::node_data<float>
             return std::move(val);
 
         default:
@@ -192,6 +223,9 @@ namespace phylanx { namespace execution_tree
         case 4:     // phylanx::ir::node_data<double>
             return util::get<4>(val);
 
+        case 8:     // phylanx::ir::node_data<float>
+            return util::get<8>(val);
+
         case 5: HPX_FALLTHROUGH;    // primitive
         case 6: HPX_FALLTHROUGH;    // std::vector<ast::expression>
         case 7: HPX_FALLTHROUGH;    // std::vector<primitive_argument_type>
@@ -223,6 +257,9 @@ namespace phylanx { namespace execution_tree
         case 4:     // phylanx::ir::node_data<double>
             return util::get<4>(std::move(val));
 
+        case 8:     // phylanx::ir::node_data<float>
+            return util::get<8>(std::move(val));
+
         case 5: HPX_FALLTHROUGH;    // primitive
         case 6: HPX_FALLTHROUGH;    // std::vector<ast::expression>
         case 7: HPX_FALLTHROUGH;    // std::vector<primitive_argument_type>
@@ -250,6 +287,9 @@ namespace phylanx { namespace execution_tree
         case 4:     // phylanx::ir::node_data<double>
             return util::get<4>(val);
 
+        case 8:     // phylanx::ir::node_data<float>
+            return ir::node_data<double>{util::get<8>(val)};
+
         case 0: HPX_FALLTHROUGH;    // nil
         case 3: HPX_FALLTHROUGH;    // string
         case 5: HPX_FALLTHROUGH;    // primitive
@@ -277,6 +317,9 @@ namespace phylanx { namespace execution_tree
         case 4:     // phylanx::ir::node_data<double>
             return util::get<4>(std::move(val));
 
+        case 8:     // phylanx::ir::node_data<float>
+            return ir::node_data<double>{util::get<8>(val)};
+
         case 0: HPX_FALLTHROUGH;    // nil
         case 3: HPX_FALLTHROUGH;    // string
         case 5: HPX_FALLTHROUGH;    // primitive
@@ -291,6 +334,34 @@ namespace phylanx { namespace execution_tree
             "primitive_argument_type does not hold a numeric value type");
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    bool is_float32_value(primitive_argument_type const& val)
+    {
+        return util::get_if<ir::node_data<float>>(&val) != nullptr;
+    }
+
+    ir::node_data<float> extract_float32_value(
+        primitive_argument_type const& val)
+    {
+        ir::node_data<float> const* p =
+            util::get_if<ir::node_data<float>>(&val);
+        if (p != nullptr)
+        {
+            return *p;
+        }
+        return ir::node_data<float>{extract_numeric_value(val)};
+    }
+
+    ir::node_data<float> extract_float32_value(primitive_argument_type&& val)
+    {
+        ir::node_data<float>* p = util::get_if<ir::node_data<float>>(&val);
+        if (p != nullptr)
+        {
+            return std::move(*p);
+        }
+        return ir::node_data<float>{extract_numeric_value(std::move(val))};
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     std::int64_t extract_integer_value(primitive_argument_type const& val)
     {
@@ -305,6 +376,9 @@ namespace phylanx { namespace execution_tree
         case 4:     // phylanx::ir::node_data<double>
             return std::int64_t(util::get<4>(val)[0]);
 
+        case 8:     // phylanx::ir::node_data<float>
+            return std::int64_t(util::get<8>(val)[0]);
+
         case 0: HPX_FALLTHROUGH;    // nil
         case 3: HPX_FALLTHROUGH;    // string
         case 5: HPX_FALLTHROUGH;    // primitive
@@ -332,6 +406,9 @@ namespace phylanx { namespace execution_tree
         case 4:     // phylanx::ir::node_data<double>
             return std::int64_t(util::get<4>(std::move(val))[0]);
 
+        case 8:     // phylanx::ir::node_data<float>
+            return std::int64_t(util::get<8>(std::move(val))[0]);
+
         case 0: HPX_FALLTHROUGH;    // nil
         case 3: HPX_FALLTHROUGH;    // string
         case 5: HPX_FALLTHROUGH;    // primitive
@@ -363,6 +440,9 @@ namespace phylanx { namespace execution_tree
         case 4:     // phylanx::ir::node_data<double>
             return bool(util::get<4>(val));
 
+        case 8:     // phylanx::ir::node_data<float>
+            return bool(util::get<8>(val));
+
         case 7:     // std::vector<primitive_argument_type>
             return !(util::get<7>(val).get().empty());
 
@@ -394,6 +474,9 @@ namespace phylanx { namespace execution_tree
         case 4:     // phylanx::ir::node_data<double>
             return bool(util::get<4>(std::move(val)));
 
+        case 8:     // phylanx::ir::node_data<float>
+            return bool(util::get<8>(std::move(val)));
+
         case 7:     // std::vector<primitive_argument_type>
             return !(util::get<7>(std::move(val)).get().empty());
 
@@ -433,6 +516,7 @@ namespace phylanx { namespace execution_tree
         case 0: HPX_FALLTHROUGH;    // nil
         case 5: HPX_FALLTHROUGH;    // primitive
         case 7: HPX_FALLTHROUGH;    // std::vector<primitive_argument_type>
+        case 8: HPX_FALLTHROUGH;    // phylanx::ir::node_data<float>
         default:
             break;
         }
@@ -465,6 +549,7 @@ namespace phylanx { namespace execution_tree
         case 0: HPX_FALLTHROUGH;    // nil
         case 5: HPX_FALLTHROUGH;    // primitive
         case 7: HPX_FALLTHROUGH;    // std::vector<primitive_argument_type>
+        case 8: HPX_FALLTHROUGH;    // phylanx::ir::node_data<float>
         default:
             break;
         }
@@ -498,6 +583,9 @@ namespace phylanx { namespace execution_tree
         case 6:     // std::vector<ast::expression>
             return {util::get<6>(val)};
 
+        case 8:     // phylanx::ir::node_data<float>
+            return {util::get<8>(val)};
+
         case 7:     // std::vector<primitive_argument_type>
 //             {
 //                 auto const& v = util::get<7>(val).get();
@@ -544,6 +632,9 @@ namespace phylanx { namespace execution_tree
         case 6:     // std::vector<ast::expression>
             return {util::get<6>(std::move(val))};
 
+        case 8:     // phylanx::ir::node_data<float>
+            return {util::get<8>(std::move(val))};
+
         case 7:     // std::vector<primitive_argument_type>
             {
                 auto && v = util::get<7>(std::move(val)).get();
@@ -853,6 +944,10 @@ namespace phylanx { namespace execution_tree
             }
             return os;
 
+        case 8:     // phylanx::ir::node_data<float>
+            os << util::get<8>(val);
+            return os;
+
         default:
             break;
         }
@@ -0,0 +1,620 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/batched_operations.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/serialization/blaze.hpp>
+
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/include/util.hpp>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+typedef hpx::components::component<
+    phylanx::execution_tree::primitives::batched_dot>
+    batched_dot_type;
+HPX_REGISTER_DERIVED_COMPONENT_FACTORY(batched_dot_type,
+    phylanx_batched_dot_component, "phylanx_primitive_component",
+    hpx::components::factory_enabled)
+HPX_DEFINE_GET_COMPONENT_TYPE(batched_dot_type::wrapped_type)
+
+typedef hpx::components::component<
+    phylanx::execution_tree::primitives::batched_inverse>
+    batched_inverse_type;
+HPX_REGISTER_DERIVED_COMPONENT_FACTORY(batched_inverse_type,
+    phylanx_batched_inverse_component, "phylanx_primitive_component",
+    hpx::components::factory_enabled)
+HPX_DEFINE_GET_COMPONENT_TYPE(batched_inverse_type::wrapped_type)
+
+typedef hpx::components::component<
+    phylanx::execution_tree::primitives::batched_solve>
+    batched_solve_type;
+HPX_REGISTER_DERIVED_COMPONENT_FACTORY(batched_solve_type,
+    phylanx_batched_solve_component, "phylanx_primitive_component",
+    hpx::components::factory_enabled)
+HPX_DEFINE_GET_COMPONENT_TYPE(batched_solve_type::wrapped_type)
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<match_pattern_type> const batched_dot::match_data =
+    {
+        hpx::util::make_tuple(
+            "batched_dot", "batched_dot(_1, _2)", &create<batched_dot>)
+    };
+
+    std::vector<match_pattern_type> const batched_inverse::match_data =
+    {
+        hpx::util::make_tuple(
+            "batched_inverse", "batched_inverse(_1)", &create<batched_inverse>)
+    };
+
+    std::vector<match_pattern_type> const batched_solve::match_data =
+    {
+        hpx::util::make_tuple(
+            "batched_solve", "batched_solve(_1, _2)", &create<batched_solve>)
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    batched_dot::batched_dot(std::vector<primitive_argument_type>&& operands)
+      : base_primitive(std::move(operands))
+    {}
+
+    batched_inverse::batched_inverse(
+            std::vector<primitive_argument_type>&& operands)
+      : base_primitive(std::move(operands))
+    {}
+
+    batched_solve::batched_solve(
+            std::vector<primitive_argument_type>&& operands)
+      : base_primitive(std::move(operands))
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        using operand_type = ir::node_data<double>;
+        using operands_type = std::vector<operand_type>;
+
+        ///////////////////////////////////////////////////////////////////////
+        // Kernels for square problems of a size known at compile time operate
+        // on blaze::StaticMatrix, which keeps the data on the stack and allows
+        // the compiler to fully unroll the loops. Size zero selects the
+        // fallback for arbitrary sizes.
+        template <std::size_t N>
+        struct small_matrix
+        {
+            using matrix_type = blaze::StaticMatrix<double, N, N>;
+            using vector_type = blaze::StaticVector<double, N>;
+            using pivots_type = std::array<std::size_t, N>;
+
+            static matrix_type load(blaze::DynamicMatrix<double> const& m)
+            {
+                return matrix_type(m);
+            }
+            static vector_type load(blaze::DynamicVector<double> const& v)
+            {
+                return vector_type(v);
+            }
+
+            static pivots_type make_pivots(std::size_t)
+            {
+                return pivots_type{};
+            }
+        };
+
+        template <>
+        struct small_matrix<0>
+        {
+            using matrix_type = blaze::DynamicMatrix<double>;
+            using vector_type = blaze::DynamicVector<double>;
+            using pivots_type = std::vector<std::size_t>;
+
+            static matrix_type const& load(matrix_type const& m)
+            {
+                return m;
+            }
+            static vector_type const& load(vector_type const& v)
+            {
+                return v;
+            }
+
+            static pivots_type make_pivots(std::size_t n)
+            {
+                return pivots_type(n);
+            }
+        };
+
+        // Invoke the given function with the compile-time size matching n.
+        // The largest fixed size is limited to keep the kernels' stack
+        // footprint well below the (small) HPX thread stack size.
+        template <typename F>
+        operand_type dispatch_fixed_size(std::size_t n, F && f)
+        {
+            switch (n)
+            {
+            case 2:
+                return f(std::integral_constant<std::size_t, 2>{});
+
+            case 3:
+                return f(std::integral_constant<std::size_t, 3>{});
+
+            case 4:
+                return f(std::integral_constant<std::size_t, 4>{});
+
+            case 6:
+                return f(std::integral_constant<std::size_t, 6>{});
+
+            case 8:
+                return f(std::integral_constant<std::size_t, 8>{});
+
+            case 12:
+                return f(std::integral_constant<std::size_t, 12>{});
+
+            case 16:
+                return f(std::integral_constant<std::size_t, 16>{});
+
+            default:
+                break;
+            }
+            return f(std::integral_constant<std::size_t, 0>{});
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // In-place LU factorization with partial pivoting (L has an implicit
+        // unit diagonal).
+        template <typename Matrix, typename Pivots>
+        void lu_factorize(Matrix& a, Pivots& pivots, std::size_t n)
+        {
+            for (std::size_t k = 0; k != n; ++k)
+            {
+                std::size_t p = k;
+                double max = std::abs(a(k, k));
+                for (std::size_t i = k + 1; i != n; ++i)
+                {
+                    double val = std::abs(a(i, k));
+                    if (val > max)
+                    {
+                        max = val;
+                        p = i;
+                    }
+                }
+
+                if (max == 0.0)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "batched_operations::lu_factorize",
+                        "the given matrix is singular");
+                }
+
+                pivots[k] = p;
+                if (p != k)
+                {
+                    for (std::size_t j = 0; j != n; ++j)
+                    {
+                        std::swap(a(k, j), a(p, j));
+                    }
+                }
+
+                double const inv_pivot = 1.0 / a(k, k);
+                for (std::size_t i = k + 1; i != n; ++i)
+                {
+                    double const l = (a(i, k) *= inv_pivot);
+                    for (std::size_t j = k + 1; j != n; ++j)
+                    {
+                        a(i, j) -= l * a(k, j);
+                    }
+                }
+            }
+        }
+
+        // Solve (in-place) for all columns of the right hand side b, given
+        // the factorization generated by lu_factorize.
+        template <typename Matrix, typename Pivots>
+        void lu_solve(Matrix const& lu, Pivots const& pivots,
+            blaze::DynamicMatrix<double>& b, std::size_t n)
+        {
+            std::size_t const columns = b.columns();
+
+            for (std::size_t k = 0; k != n; ++k)
+            {
+                if (pivots[k] != k)
+                {
+                    for (std::size_t j = 0; j != columns; ++j)
+                    {
+                        std::swap(b(k, j), b(pivots[k], j));
+                    }
+                }
+            }
+
+            // forward substitution
+            for (std::size_t i = 1; i < n; ++i)
+            {
+                for (std::size_t k = 0; k != i; ++k)
+                {
+                    double const l = lu(i, k);
+                    for (std::size_t j = 0; j != columns; ++j)
+                    {
+                        b(i, j) -= l * b(k, j);
+                    }
+                }
+            }
+
+            // backward substitution
+            for (std::size_t i = n; i-- != 0; /**/)
+            {
+                for (std::size_t k = i + 1; k != n; ++k)
+                {
+                    double const u = lu(i, k);
+                    for (std::size_t j = 0; j != columns; ++j)
+                    {
+                        b(i, j) -= u * b(k, j);
+                    }
+                }
+
+                double const inv_diag = 1.0 / lu(i, i);
+                for (std::size_t j = 0; j != columns; ++j)
+                {
+                    b(i, j) *= inv_diag;
+                }
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        template <std::size_t N>
+        operand_type dot_kernel(operand_type const& lhs, operand_type const& rhs)
+        {
+            using kernel = small_matrix<N>;
+            auto && a = kernel::load(lhs.matrix());
+
+            if (rhs.num_dimensions() == 1)
+            {
+                auto && v = kernel::load(rhs.vector());
+                return operand_type{blaze::DynamicVector<double>(a * v)};
+            }
+
+            if (rhs.dimension(1) == lhs.dimension(0))
+            {
+                auto && b = kernel::load(rhs.matrix());
+                return operand_type{blaze::DynamicMatrix<double>(a * b)};
+            }
+            return operand_type{blaze::DynamicMatrix<double>(a * rhs.matrix())};
+        }
+
+        template <std::size_t N>
+        operand_type inverse_kernel(operand_type const& op)
+        {
+            using kernel = small_matrix<N>;
+
+            std::size_t const n = op.dimension(0);
+            typename kernel::matrix_type a(op.matrix());
+            auto pivots = kernel::make_pivots(n);
+            lu_factorize(a, pivots, n);
+
+            blaze::DynamicMatrix<double> result(n, n, 0.0);
+            for (std::size_t i = 0; i != n; ++i)
+            {
+                result(i, i) = 1.0;
+            }
+            lu_solve(a, pivots, result, n);
+
+            return operand_type{std::move(result)};
+        }
+
+        template <std::size_t N>
+        operand_type solve_kernel(operand_type const& lhs, operand_type const& rhs)
+        {
+            using kernel = small_matrix<N>;
+
+            std::size_t const n = lhs.dimension(0);
+            typename kernel::matrix_type a(lhs.matrix());
+            auto pivots = kernel::make_pivots(n);
+            lu_factorize(a, pivots, n);
+
+            if (rhs.num_dimensions() == 1)
+            {
+                blaze::DynamicMatrix<double> x(n, 1UL);
+                blaze::column(x, 0UL) = rhs.vector();
+                lu_solve(a, pivots, x, n);
+                return operand_type{
+                    blaze::DynamicVector<double>(blaze::column(x, 0UL))};
+            }
+
+            blaze::DynamicMatrix<double> x(rhs.matrix());
+            lu_solve(a, pivots, x, n);
+            return operand_type{std::move(x)};
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        operand_type dot_one(operand_type const& lhs, operand_type const& rhs)
+        {
+            if (lhs.num_dimensions() == 1 && rhs.num_dimensions() == 1)
+            {
+                if (lhs.size() != rhs.size())
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "batched_dot::eval",
+                        "the operands have incompatible number of "
+                            "dimensions");
+                }
+                return operand_type{blaze::dot(lhs.vector(), rhs.vector())};
+            }
+
+            if (lhs.num_dimensions() != 2 || rhs.num_dimensions() == 0)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "batched_dot::eval",
+                    "the batched_dot primitive requires for the elements of "
+                        "the left hand side to be matrices or vectors");
+            }
+
+            if (lhs.dimension(1) != rhs.dimension(0))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "batched_dot::eval",
+                    "the operands have incompatible number of dimensions");
+            }
+
+            if (lhs.dimension(0) != lhs.dimension(1))
+            {
+                return dot_kernel<0>(lhs, rhs);
+            }
+
+            return dispatch_fixed_size(lhs.dimension(0),
+                [&](auto size)
+                {
+                    return dot_kernel<decltype(size)::value>(lhs, rhs);
+                });
+        }
+
+        operand_type inverse_one(operand_type const& op)
+        {
+            if (op.num_dimensions() == 0)
+            {
+                return operand_type{1.0 / op.scalar()};
+            }
+
+            if (op.num_dimensions() != 2 || op.dimension(0) != op.dimension(1))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "batched_inverse::eval",
+                    "matrices to inverse have to be quadratic");
+            }
+
+            return dispatch_fixed_size(op.dimension(0),
+                [&](auto size)
+                {
+                    return inverse_kernel<decltype(size)::value>(op);
+                });
+        }
+
+        operand_type solve_one(operand_type const& lhs, operand_type const& rhs)
+        {
+            if (lhs.num_dimensions() != 2 ||
+                lhs.dimension(0) != lhs.dimension(1))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "batched_solve::eval",
+                    "the coefficient matrices have to be quadratic");
+            }
+
+            if (rhs.num_dimensions() == 0 ||
+                rhs.dimension(0) != lhs.dimension(0))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "batched_solve::eval",
+                    "the operands have incompatible number of dimensions");
+            }
+
+            return dispatch_fixed_size(lhs.dimension(0),
+                [&](auto size)
+                {
+                    return solve_kernel<decltype(size)::value>(lhs, rhs);
+                });
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        operands_type extract_batch(std::vector<primitive_argument_type>&& ops)
+        {
+            operands_type result;
+            result.reserve(ops.size());
+            for (auto && op : ops)
+            {
+                result.push_back(extract_numeric_value(std::move(op)));
+            }
+            return result;
+        }
+
+        // Determine the number of problems in a batch, batches of size one
+        // are broadcast to match the other batch.
+        std::size_t batch_size(operands_type const& lhs,
+            operands_type const& rhs, char const* name)
+        {
+            if (lhs.size() == 1)
+                return rhs.size();
+            if (rhs.size() == 1 || lhs.size() == rhs.size())
+                return lhs.size();
+
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, name,
+                "the batched operands must have the same number of elements");
+        }
+
+        template <typename F>
+        primitive_result_type apply_batched(operands_type const& lhs,
+            operands_type const& rhs, F && f, char const* name)
+        {
+            std::size_t const size = batch_size(lhs, rhs, name);
+
+            std::vector<primitive_argument_type> result(size);
+            hpx::parallel::for_loop(hpx::parallel::execution::par,
+                std::size_t(0), size,
+                [&](std::size_t i)
+                {
+                    result[i] = f(lhs[lhs.size() == 1 ? 0 : i],
+                        rhs[rhs.size() == 1 ? 0 : i]);
+                });
+
+            return primitive_result_type{std::move(result)};
+        }
+
+        template <typename F>
+        primitive_result_type apply_batched(
+            operands_type const& ops, F && f)
+        {
+            std::vector<primitive_argument_type> result(ops.size());
+            hpx::parallel::for_loop(hpx::parallel::execution::par,
+                std::size_t(0), ops.size(),
+                [&](std::size_t i)
+                {
+                    result[i] = f(ops[i]);
+                });
+
+            return primitive_result_type{std::move(result)};
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        struct batched_binary : std::enable_shared_from_this<batched_binary>
+        {
+            using kernel_type =
+                operand_type (*)(operand_type const&, operand_type const&);
+
+            batched_binary(kernel_type kernel, char const* name)
+              : kernel_(kernel)
+              , name_(name)
+            {}
+
+            hpx::future<primitive_result_type> eval(
+                std::vector<primitive_argument_type> const& operands,
+                std::vector<primitive_argument_type> const& args)
+            {
+                if (operands.size() != 2)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter, name_,
+                        "the batched primitives require exactly two "
+                            "operands");
+                }
+
+                if (!valid(operands[0]) || !valid(operands[1]))
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter, name_,
+                        "the batched primitives require that the arguments "
+                            "given by the operands array are valid");
+                }
+
+                auto this_ = this->shared_from_this();
+                return hpx::dataflow(hpx::util::unwrapping(
+                    [this_](std::vector<primitive_argument_type>&& lhs,
+                            std::vector<primitive_argument_type>&& rhs)
+                    ->  primitive_result_type
+                    {
+                        return apply_batched(extract_batch(std::move(lhs)),
+                            extract_batch(std::move(rhs)), this_->kernel_,
+                            this_->name_);
+                    }),
+                    list_operand(operands[0], args),
+                    list_operand(operands[1], args));
+            }
+
+        private:
+            kernel_type kernel_;
+            char const* name_;
+        };
+
+        struct batched_unary : std::enable_shared_from_this<batched_unary>
+        {
+            using kernel_type = operand_type (*)(operand_type const&);
+
+            batched_unary(kernel_type kernel, char const* name)
+              : kernel_(kernel)
+              , name_(name)
+            {}
+
+            hpx::future<primitive_result_type> eval(
+                std::vector<primitive_argument_type> const& operands,
+                std::vector<primitive_argument_type> const& args)
+            {
+                if (operands.size() != 1)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter, name_,
+                        "the batched primitive requires exactly one operand");
+                }
+
+                if (!valid(operands[0]))
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter, name_,
+                        "the batched primitive requires that the argument "
+                            "given by the operands array is valid");
+                }
+
+                auto this_ = this->shared_from_this();
+                return list_operand(operands[0], args).then(
+                    hpx::util::unwrapping(
+                        [this_](std::vector<primitive_argument_type>&& ops)
+                        ->  primitive_result_type
+                        {
+                            return apply_batched(
+                                extract_batch(std::move(ops)), this_->kernel_);
+                        }));
+            }
+
+        private:
+            kernel_type kernel_;
+            char const* name_;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_result_type> batched_dot::eval(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        auto f = std::make_shared<detail::batched_binary>(
+            &detail::dot_one, "batched_dot::eval");
+
+        if (operands_.empty())
+        {
+            return f->eval(args, noargs);
+        }
+        return f->eval(operands_, args);
+    }
+
+    hpx::future<primitive_result_type> batched_inverse::eval(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        auto f = std::make_shared<detail::batched_unary>(
+            &detail::inverse_one, "batched_inverse::eval");
+
+        if (operands_.empty())
+        {
+            return f->eval(args, noargs);
+        }
+        return f->eval(operands_, args);
+    }
+
+    hpx::future<primitive_result_type> batched_solve::eval(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        auto f = std::make_shared<detail::batched_binary>(
+            &detail::solve_one, "batched_solve::eval");
+
+        if (operands_.empty())
+        {
+            return f->eval(args, noargs);
+        }
+        return f->eval(operands_, args);
+    }
+}}}
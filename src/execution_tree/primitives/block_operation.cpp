@@ -115,4 +115,34 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         return std::make_shared<detail::step>(operands_, args)->eval();
     }
+
+    primitive_result_type block_operation::eval_direct(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        std::vector<primitive_argument_type> const& operands =
+            operands_.empty() ? args : operands_;
+        std::vector<primitive_argument_type> const& params =
+            operands_.empty() ? noargs : args;
+
+        if (operands.empty())
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "phylanx::execution_tree::primitives::"
+                    "block_operation::eval_direct",
+                "the block_operation primitive requires at least one "
+                    "argument");
+        }
+
+        // the value of the last step is returned, statements that don't
+        // return anything are skipped
+        primitive_result_type result;
+        for (auto const& operand : operands)
+        {
+            if (valid(operand))
+            {
+                result = value_operand_sync(operand, params);
+            }
+        }
+        return result;
+    }
 }}}
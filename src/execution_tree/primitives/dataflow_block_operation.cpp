@@ -0,0 +1,139 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/dataflow_block_operation.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/util.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+typedef hpx::components::component<
+    phylanx::execution_tree::primitives::dataflow_block_operation>
+    dataflow_block_operation_type;
+HPX_REGISTER_DERIVED_COMPONENT_FACTORY(dataflow_block_operation_type,
+    phylanx_dataflow_block_operation_component,
+    "phylanx_primitive_component", hpx::components::factory_enabled)
+HPX_DEFINE_GET_COMPONENT_TYPE(dataflow_block_operation_type::wrapped_type)
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    dataflow_block_operation::dataflow_block_operation(
+            std::vector<primitive_argument_type>&& operands,
+            std::vector<std::vector<std::size_t>>&& dependencies)
+      : base_primitive(std::move(operands))
+      , dependencies_(std::move(dependencies))
+    {
+        if (operands_.empty() || operands_.size() != dependencies_.size())
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "phylanx::execution_tree::primitives::"
+                    "dataflow_block_operation::dataflow_block_operation",
+                "the dataflow_block_operation primitive requires at least "
+                    "one argument and one dependency list per argument");
+        }
+    }
+
+    namespace detail
+    {
+        struct dataflow_block : std::enable_shared_from_this<dataflow_block>
+        {
+            dataflow_block(std::vector<primitive_argument_type> const& operands,
+                    std::vector<std::vector<std::size_t>> const& dependencies,
+                    std::vector<primitive_argument_type> const& args)
+              : operands_(operands)
+              , dependencies_(dependencies)
+              , args_(args)
+            {}
+
+            hpx::future<primitive_result_type> eval()
+            {
+                using result_future = hpx::shared_future<primitive_result_type>;
+
+                auto this_ = this->shared_from_this();
+
+                std::vector<result_future> steps;
+                steps.reserve(operands_.size());
+
+                for (std::size_t i = 0; i != operands_.size(); ++i)
+                {
+                    // statements that don't return anything are skipped
+                    if (!valid(operands_[i]))
+                    {
+                        steps.push_back(
+                            hpx::make_ready_future(primitive_result_type{}));
+                        continue;
+                    }
+
+                    std::vector<result_future> deps;
+                    deps.reserve(dependencies_[i].size());
+                    for (std::size_t dep : dependencies_[i])
+                    {
+                        deps.push_back(steps[dep]);
+                    }
+
+                    // evaluate the statement on a new thread once all of its
+                    // dependencies have been satisfied, the statement itself
+                    // is evaluated directly on that thread
+                    steps.push_back(hpx::dataflow(hpx::launch::async,
+                        [this_, i](std::vector<result_future> && deps)
+                        {
+                            for (auto& dep : deps)
+                            {
+                                dep.get();      // rethrow exceptions
+                            }
+                            return value_operand_sync(
+                                this_->operands_[i], this_->args_);
+                        },
+                        std::move(deps)));
+                }
+
+                // wait for all statements to finish, return the value of the
+                // last one
+                return hpx::when_all(steps).then(
+                    [](hpx::future<std::vector<result_future>> && f)
+                    {
+                        std::vector<result_future> steps = f.get();
+                        for (auto& step : steps)
+                        {
+                            step.get();         // rethrow exceptions
+                        }
+                        return steps.back().get();
+                    });
+            }
+
+        private:
+            std::vector<primitive_argument_type> operands_;
+            std::vector<std::vector<std::size_t>> dependencies_;
+            std::vector<primitive_argument_type> args_;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_result_type> dataflow_block_operation::eval(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        return std::make_shared<detail::dataflow_block>(
+            operands_, dependencies_, args)->eval();
+    }
+
+    // the independent statements are evaluated concurrently in this case as
+    // well, the calling thread waits for the value of the last statement
+    primitive_result_type dataflow_block_operation::eval_direct(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        return std::make_shared<detail::dataflow_block>(
+            operands_, dependencies_, args)->eval().get();
+    }
+}}}
@@ -10,6 +10,7 @@
 #include <hpx/include/components.hpp>
 #include <hpx/include/util.hpp>
 
+#include <memory>
 #include <vector>
 #include <utility>
 
@@ -30,6 +31,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
     ///////////////////////////////////////////////////////////////////////////
     define_function::define_function(std::string name)
       : name_(std::move(name))
+      , locality_(hpx::find_here())
+    {}
+
+    define_function::define_function(std::string name, hpx::id_type locality)
+      : name_(std::move(name))
+      , locality_(std::move(locality))
     {}
 
     primitive_result_type define_function::eval_direct(
@@ -48,8 +55,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
             }
 
             primitive_argument_type operand = body_;
-            target_ = primitive(hpx::new_<primitives::wrapped_function>(
-                hpx::find_here(), std::move(operand), name_));
+            target_ = create_primitive<primitives::wrapped_function>(
+                locality_, std::move(operand), name_);
 
             // bind this name to the result of the expression right away
             primitive* p = util::get_if<primitive>(&target_);
@@ -82,6 +89,15 @@ namespace phylanx { namespace execution_tree
     void define_function::set_body(hpx::launch::sync_policy,
         primitive_argument_type&& body)
     {
+        detail::record_function_body(*this, body);
+
+        if (is_local())
+        {
+            std::static_pointer_cast<primitives::define_function>(local())
+                ->set_body(std::move(body));
+            return;
+        }
+
         using action_type = primitives::define_function::set_body_action;
         action_type()(this->primitive::get_id(), std::move(body));
     }
@@ -35,12 +35,21 @@ namespace phylanx { namespace execution_tree { namespace primitives
     ///////////////////////////////////////////////////////////////////////////
     define_variable::define_variable(primitive_argument_type&& operand)
       : body_(std::move(operand))
+      , locality_(hpx::find_here())
     {}
 
     define_variable::define_variable(
             primitive_argument_type&& operand, std::string name)
       : body_(std::move(operand))
       , name_(std::move(name))
+      , locality_(hpx::find_here())
+    {}
+
+    define_variable::define_variable(primitive_argument_type&& operand,
+            std::string name, hpx::id_type locality)
+      : body_(std::move(operand))
+      , name_(std::move(name))
+      , locality_(std::move(locality))
     {}
 
     primitive_result_type define_variable::eval_direct(
@@ -50,8 +59,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
         if (!valid(target_))
         {
             primitive_argument_type operand = body_;
-            target_ = primitive(hpx::new_<primitives::variable>(
-                hpx::find_here(), std::move(operand), name_));
+            target_ = create_primitive<primitives::variable>(
+                locality_, std::move(operand), name_);
 
             // bind this name to the result of the expression right away
             primitive* p = util::get_if<primitive>(&target_);
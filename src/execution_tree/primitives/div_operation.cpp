@@ -274,10 +274,30 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 }
             }
 
-        public:
-            hpx::future<primitive_result_type> eval(
-                std::vector<primitive_argument_type> const& operands,
-                std::vector<primitive_argument_type> const& args) const
+            primitive_result_type div_all(operands_type && ops) const
+            {
+                std::size_t lhs_dims = ops[0].num_dimensions();
+                switch (lhs_dims)
+                {
+                case 0:
+                    return div0d(std::move(ops));
+
+                case 1:
+                    return div1d(std::move(ops));
+
+                case 2:
+                    return div2d(std::move(ops));
+
+                default:
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "div_operation::eval",
+                        "left hand side operand has unsupported number "
+                        "of dimensions");
+                }
+            }
+
+            void verify_operands(
+                std::vector<primitive_argument_type> const& operands) const
             {
                 if (operands.size() < 2)
                 {
@@ -303,32 +323,32 @@ namespace phylanx { namespace execution_tree { namespace primitives
                         "the div_operation primitive requires that the "
                             "arguments given by the operands array are valid");
                 }
+            }
+
+        public:
+            hpx::future<primitive_result_type> eval(
+                std::vector<primitive_argument_type> const& operands,
+                std::vector<primitive_argument_type> const& args) const
+            {
+                verify_operands(operands);
 
                 auto this_ = this->shared_from_this();
-                return hpx::dataflow(hpx::util::unwrapping(
+                return detail::invoke_when_ready(
                     [this_](operands_type && ops) -> primitive_result_type
                     {
-                        std::size_t lhs_dims = ops[0].num_dimensions();
-                        switch (lhs_dims)
-                        {
-                        case 0:
-                            return this_->div0d(std::move(ops));
-
-                        case 1:
-                            return this_->div1d(std::move(ops));
-
-                        case 2:
-                            return this_->div2d(std::move(ops));
-
-                        default:
-                            HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                                "div_operation::eval",
-                                "left hand side operand has unsupported number "
-                                "of dimensions");
-                        }
-                    }),
-                    detail::map_operands(operands, numeric_operand, args)
-                );
+                        return this_->div_all(std::move(ops));
+                    },
+                    detail::map_operands(operands, numeric_operand, args));
+            }
+
+            primitive_result_type eval_direct(
+                std::vector<primitive_argument_type> const& operands,
+                std::vector<primitive_argument_type> const& args) const
+            {
+                verify_operands(operands);
+
+                return div_all(detail::map_operands_concurrently(
+                    operands, numeric_operand_sync, args));
             }
         };
     }
@@ -344,4 +364,15 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         return std::make_shared<detail::div>()->eval(operands_, args);
     }
+
+    primitive_result_type div_operation::eval_direct(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        if (operands_.empty())
+        {
+            return detail::div{}.eval_direct(args, noargs);
+        }
+
+        return detail::div{}.eval_direct(operands_, args);
+    }
 }}}
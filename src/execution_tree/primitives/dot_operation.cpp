@@ -13,6 +13,7 @@
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/util.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <memory>
 #include <utility>
@@ -45,6 +46,125 @@ namespace phylanx { namespace execution_tree { namespace primitives
     ///////////////////////////////////////////////////////////////////////////
     namespace detail
     {
+        ///////////////////////////////////////////////////////////////////////
+        // Products involving single precision operands are computed tile by
+        // tile: each tile of a single precision operand is widened to double
+        // precision right before it is used by the (BLAS backed) double
+        // precision kernels, tiles of double precision operands are used in
+        // place. No double precision copy of a whole operand is created.
+        constexpr std::size_t const tile_size = 128;
+
+        inline blaze::DynamicVector<double> tile(
+            blaze::DynamicVector<float> const& v, std::size_t i, std::size_t n)
+        {
+            return blaze::subvector(v, i, n);
+        }
+
+        inline auto tile(blaze::DynamicVector<double> const& v, std::size_t i,
+                std::size_t n)
+        ->  decltype(blaze::subvector(v, i, n))
+        {
+            return blaze::subvector(v, i, n);
+        }
+
+        inline blaze::DynamicMatrix<double> tile(
+            blaze::DynamicMatrix<float> const& m, std::size_t i, std::size_t j,
+            std::size_t rows, std::size_t columns)
+        {
+            return blaze::submatrix(m, i, j, rows, columns);
+        }
+
+        inline auto tile(blaze::DynamicMatrix<double> const& m, std::size_t i,
+                std::size_t j, std::size_t rows, std::size_t columns)
+        ->  decltype(blaze::submatrix(m, i, j, rows, columns))
+        {
+            return blaze::submatrix(m, i, j, rows, columns);
+        }
+
+        inline std::size_t tile_extent(std::size_t i, std::size_t n)
+        {
+            return (std::min)(tile_size, n - i);
+        }
+
+        template <typename T1, typename T2>
+        double dot1d1d_tiled(blaze::DynamicVector<T1> const& lhs,
+            blaze::DynamicVector<T2> const& rhs)
+        {
+            double result = 0.0;
+            for (std::size_t k = 0; k < lhs.size(); k += tile_size)
+            {
+                std::size_t kb = tile_extent(k, lhs.size());
+                result += blaze::dot(tile(lhs, k, kb), tile(rhs, k, kb));
+            }
+            return result;
+        }
+
+        template <typename T1, typename T2>
+        blaze::DynamicVector<double> dot1d2d_tiled(
+            blaze::DynamicVector<T1> const& lhs,
+            blaze::DynamicMatrix<T2> const& rhs)
+        {
+            blaze::DynamicVector<double> result(rhs.columns(), 0.0);
+            for (std::size_t j = 0; j < rhs.columns(); j += tile_size)
+            {
+                std::size_t jb = tile_extent(j, rhs.columns());
+                auto r = blaze::subvector(result, j, jb);
+                for (std::size_t k = 0; k < lhs.size(); k += tile_size)
+                {
+                    std::size_t kb = tile_extent(k, lhs.size());
+                    r += blaze::trans(blaze::trans(tile(lhs, k, kb)) *
+                        tile(rhs, k, j, kb, jb));
+                }
+            }
+            return result;
+        }
+
+        template <typename T1, typename T2>
+        blaze::DynamicVector<double> dot2d1d_tiled(
+            blaze::DynamicMatrix<T1> const& lhs,
+            blaze::DynamicVector<T2> const& rhs)
+        {
+            blaze::DynamicVector<double> result(lhs.rows(), 0.0);
+            for (std::size_t i = 0; i < lhs.rows(); i += tile_size)
+            {
+                std::size_t ib = tile_extent(i, lhs.rows());
+                auto r = blaze::subvector(result, i, ib);
+                for (std::size_t k = 0; k < rhs.size(); k += tile_size)
+                {
+                    std::size_t kb = tile_extent(k, rhs.size());
+                    r += tile(lhs, i, k, ib, kb) * tile(rhs, k, kb);
+                }
+            }
+            return result;
+        }
+
+        template <typename T1, typename T2>
+        blaze::DynamicMatrix<double> dot2d2d_tiled(
+            blaze::DynamicMatrix<T1> const& lhs,
+            blaze::DynamicMatrix<T2> const& rhs)
+        {
+            blaze::DynamicMatrix<double> result(
+                lhs.rows(), rhs.columns(), 0.0);
+            for (std::size_t i = 0; i < lhs.rows(); i += tile_size)
+            {
+                std::size_t ib = tile_extent(i, lhs.rows());
+                for (std::size_t k = 0; k < lhs.columns(); k += tile_size)
+                {
+                    // the widened tile of lhs is reused for all tiles of rhs
+                    std::size_t kb = tile_extent(k, lhs.columns());
+                    auto a = tile(lhs, i, k, ib, kb);
+                    for (std::size_t j = 0; j < rhs.columns(); j += tile_size)
+                    {
+                        std::size_t jb = tile_extent(j, rhs.columns());
+                        blaze::submatrix(result, i, j, ib, jb) +=
+                            a * tile(rhs, k, j, kb, jb);
+                    }
+                }
+            }
+            return result;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
         struct dot : std::enable_shared_from_this<dot>
         {
             dot() = default;
@@ -175,10 +295,125 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 return std::move(lhs);
             }
 
-        public:
-            hpx::future<primitive_result_type> eval(
-                std::vector<primitive_argument_type> const& operands,
-                std::vector<primitive_argument_type> const& args)
+            // at least one of the operands is stored in single precision,
+            // the result is computed in double precision
+            template <typename T1, typename T2>
+            primitive_result_type dot_tiled(ir::node_data<T1>&& lhs,
+                ir::node_data<T2>&& rhs) const
+            {
+                std::size_t lhs_dims = lhs.num_dimensions();
+                std::size_t rhs_dims = rhs.num_dimensions();
+
+                if (lhs_dims == 0 && rhs_dims == 0)
+                {
+                    return operand_type(double(lhs.scalar()) * rhs.scalar());
+                }
+
+                if (lhs_dims == 1 && rhs_dims == 1)
+                {
+                    if (lhs.size() != rhs.size())
+                    {
+                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "dot_operation::dot1d1d",
+                            "the operands have incompatible number of "
+                                "dimensions");
+                    }
+                    return operand_type(
+                        dot1d1d_tiled(lhs.vector(), rhs.vector()));
+                }
+
+                if (lhs_dims == 1 && rhs_dims == 2)
+                {
+                    if (lhs.size() != rhs.dimension(0))
+                    {
+                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "dot_operation::dot1d2d",
+                            "the operands have incompatible number of "
+                                "dimensions");
+                    }
+                    return operand_type(
+                        dot1d2d_tiled(lhs.vector(), rhs.matrix()));
+                }
+
+                if (lhs_dims == 2 && rhs_dims == 1)
+                {
+                    if (lhs.dimension(1) != rhs.size())
+                    {
+                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "dot_operation::dot2d1d",
+                            "the operands have incompatible number of "
+                                "dimensions");
+                    }
+                    return operand_type(
+                        dot2d1d_tiled(lhs.matrix(), rhs.vector()));
+                }
+
+                if (lhs_dims == 2 && rhs_dims == 2)
+                {
+                    if (lhs.dimension(1) != rhs.dimension(0))
+                    {
+                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "dot_operation::dot2d2d",
+                            "the operands have incompatible number of "
+                                "dimensions");
+                    }
+                    return operand_type(
+                        dot2d2d_tiled(lhs.matrix(), rhs.matrix()));
+                }
+
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "dot_operation::eval",
+                    "the operands have incompatible number of dimensions");
+            }
+
+            primitive_result_type dot_any(
+                std::vector<primitive_argument_type> && args) const
+            {
+                bool lhs_float32 = is_float32_value(args[0]);
+                bool rhs_float32 = is_float32_value(args[1]);
+                if (lhs_float32 && rhs_float32)
+                {
+                    return dot_tiled(util::get<8>(std::move(args[0])),
+                        util::get<8>(std::move(args[1])));
+                }
+                if (lhs_float32)
+                {
+                    return dot_tiled(util::get<8>(std::move(args[0])),
+                        extract_numeric_value(std::move(args[1])));
+                }
+                if (rhs_float32)
+                {
+                    return dot_tiled(extract_numeric_value(std::move(args[0])),
+                        util::get<8>(std::move(args[1])));
+                }
+
+                operands_type ops;
+                ops.reserve(2);
+                ops.push_back(extract_numeric_value(std::move(args[0])));
+                ops.push_back(extract_numeric_value(std::move(args[1])));
+
+                std::size_t dims = ops[0].num_dimensions();
+                switch (dims)
+                {
+                case 0UL:
+                    return dot0d(std::move(ops));
+
+                case 1UL:
+                    return dot1d(std::move(ops));
+
+                case 2UL:
+                    return dot2d(std::move(ops));
+
+                default:
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "dot_operation::eval",
+                        "left hand side operand has unsupported "
+                            "number of dimensions");
+                }
+            }
+
+            void verify_operands(
+                std::vector<primitive_argument_type> const& operands) const
             {
                 if (operands.size() != 2)
                 {
@@ -195,32 +430,33 @@ namespace phylanx { namespace execution_tree { namespace primitives
                         "the dot_operation primitive requires that the "
                             "arguments given by the operands array are valid");
                 }
+            }
+
+        public:
+            hpx::future<primitive_result_type> eval(
+                std::vector<primitive_argument_type> const& operands,
+                std::vector<primitive_argument_type> const& args) const
+            {
+                verify_operands(operands);
 
                 auto this_ = this->shared_from_this();
-                return hpx::dataflow(hpx::util::unwrapping(
-                    [this_](operands_type&& ops) -> primitive_result_type
+                return detail::invoke_when_ready(
+                    [this_](std::vector<primitive_argument_type>&& ops)
+                    -> primitive_result_type
                     {
-                        std::size_t dims = ops[0].num_dimensions();
-                        switch (dims)
-                        {
-                        case 0UL:
-                            return this_->dot0d(std::move(ops));
-
-                        case 1UL:
-                            return this_->dot1d(std::move(ops));
-
-                        case 2UL:
-                            return this_->dot2d(std::move(ops));
-
-                        default:
-                            HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                                "dot_operation::eval",
-                                "left hand side operand has unsupported "
-                                    "number of dimensions");
-                        }
-                    }),
-                    detail::map_operands(operands, numeric_operand, args)
-                );
+                        return this_->dot_any(std::move(ops));
+                    },
+                    detail::map_operands(operands, literal_operand, args));
+            }
+
+            primitive_result_type eval_direct(
+                std::vector<primitive_argument_type> const& operands,
+                std::vector<primitive_argument_type> const& args) const
+            {
+                verify_operands(operands);
+
+                return dot_any(detail::map_operands_concurrently(
+                    operands, literal_operand_sync, args));
             }
         };
     }
@@ -236,4 +472,15 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         return std::make_shared<detail::dot>()->eval(operands_, args);
     }
+
+    primitive_result_type dot_operation::eval_direct(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        if (operands_.empty())
+        {
+            return detail::dot{}.eval_direct(args, noargs);
+        }
+
+        return detail::dot{}.eval_direct(operands_, args);
+    }
 }}}
@@ -0,0 +1,492 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/einsum_operation.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/serialization/blaze.hpp>
+
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/util.hpp>
+
+#include <cctype>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+typedef hpx::components::component<
+    phylanx::execution_tree::primitives::einsum_operation>
+    einsum_operation_type;
+HPX_REGISTER_DERIVED_COMPONENT_FACTORY(einsum_operation_type,
+    phylanx_einsum_operation_component, "phylanx_primitive_component",
+    hpx::components::factory_enabled)
+HPX_DEFINE_GET_COMPONENT_TYPE(einsum_operation_type::wrapped_type)
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<match_pattern_type> const einsum_operation::match_data =
+    {
+        hpx::util::make_tuple(
+            "einsum3", "einsum(_1, _2, _3)", &create<einsum_operation>),
+        hpx::util::make_tuple(
+            "einsum2", "einsum(_1, _2)", &create<einsum_operation>)
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    einsum_operation::einsum_operation(
+            std::vector<primitive_argument_type>&& operands)
+      : base_primitive(std::move(operands))
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        namespace einsum_kernels
+        {
+            using operand_type = ir::node_data<double>;
+            using vector_type = blaze::DynamicVector<double>;
+            using matrix_type = blaze::DynamicMatrix<double>;
+
+            using unary_kernel_type = operand_type (*)(operand_type&&);
+            using binary_kernel_type =
+                operand_type (*)(operand_type&&, operand_type&&);
+
+            ///////////////////////////////////////////////////////////////////
+            void check_dimensions(operand_type const& op, std::size_t dims)
+            {
+                if (op.num_dimensions() != dims)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "einsum_operation::eval",
+                        "the number of subscripts does not match the number "
+                            "of dimensions of the corresponding operand");
+                }
+            }
+
+            void check_extent(std::size_t lhs, std::size_t rhs)
+            {
+                if (lhs != rhs)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "einsum_operation::eval",
+                        "the operands have incompatible extents for a "
+                            "shared subscript");
+                }
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            // unary kernels
+            operand_type identity1d(operand_type&& op)
+            {
+                check_dimensions(op, 1);
+                return std::move(op);
+            }
+
+            operand_type sum1d(operand_type&& op)
+            {
+                check_dimensions(op, 1);
+
+                double result = 0.0;
+                for (double val : op.vector())
+                {
+                    result += val;
+                }
+                return operand_type{result};
+            }
+
+            operand_type identity2d(operand_type&& op)
+            {
+                check_dimensions(op, 2);
+                return std::move(op);
+            }
+
+            operand_type transpose2d(operand_type&& op)
+            {
+                check_dimensions(op, 2);
+                blaze::transpose(op.matrix());
+                return std::move(op);
+            }
+
+            operand_type sum2d(operand_type&& op)
+            {
+                check_dimensions(op, 2);
+
+                matrix_type const& m = op.matrix();
+
+                double result = 0.0;
+                for (std::size_t i = 0; i != m.rows(); ++i)
+                {
+                    for (std::size_t j = 0; j != m.columns(); ++j)
+                    {
+                        result += m(i, j);
+                    }
+                }
+                return operand_type{result};
+            }
+
+            operand_type row_sums(operand_type&& op)
+            {
+                check_dimensions(op, 2);
+
+                matrix_type const& m = op.matrix();
+                vector_type ones(m.columns(), 1.0);
+                return operand_type{vector_type(m * ones)};
+            }
+
+            operand_type column_sums(operand_type&& op)
+            {
+                check_dimensions(op, 2);
+
+                matrix_type const& m = op.matrix();
+                vector_type ones(m.rows(), 1.0);
+                return operand_type{
+                    vector_type(blaze::trans(blaze::trans(ones) * m))};
+            }
+
+            operand_type trace(operand_type&& op)
+            {
+                check_dimensions(op, 2);
+
+                matrix_type const& m = op.matrix();
+                check_extent(m.rows(), m.columns());
+
+                double result = 0.0;
+                for (std::size_t i = 0; i != m.rows(); ++i)
+                {
+                    result += m(i, i);
+                }
+                return operand_type{result};
+            }
+
+            operand_type diagonal(operand_type&& op)
+            {
+                check_dimensions(op, 2);
+
+                matrix_type const& m = op.matrix();
+                check_extent(m.rows(), m.columns());
+
+                vector_type result(m.rows());
+                for (std::size_t i = 0; i != m.rows(); ++i)
+                {
+                    result[i] = m(i, i);
+                }
+                return operand_type{std::move(result)};
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            // binary kernels
+            operand_type dot1d1d(operand_type&& lhs, operand_type&& rhs)
+            {
+                check_dimensions(lhs, 1);
+                check_dimensions(rhs, 1);
+                check_extent(lhs.size(), rhs.size());
+
+                return operand_type{blaze::dot(lhs.vector(), rhs.vector())};
+            }
+
+            operand_type mul1d1d(operand_type&& lhs, operand_type&& rhs)
+            {
+                check_dimensions(lhs, 1);
+                check_dimensions(rhs, 1);
+                check_extent(lhs.size(), rhs.size());
+
+                lhs.vector() *= rhs.vector();
+                return std::move(lhs);
+            }
+
+            operand_type outer1d1d(operand_type&& lhs, operand_type&& rhs)
+            {
+                check_dimensions(lhs, 1);
+                check_dimensions(rhs, 1);
+
+                return operand_type{
+                    matrix_type(lhs.vector() * blaze::trans(rhs.vector()))};
+            }
+
+            operand_type gemv(operand_type&& lhs, operand_type&& rhs)
+            {
+                check_dimensions(lhs, 2);
+                check_dimensions(rhs, 1);
+                check_extent(lhs.dimension(1), rhs.size());
+
+                return operand_type{vector_type(lhs.matrix() * rhs.vector())};
+            }
+
+            operand_type gemv_trans(operand_type&& lhs, operand_type&& rhs)
+            {
+                check_dimensions(lhs, 2);
+                check_dimensions(rhs, 1);
+                check_extent(lhs.dimension(0), rhs.size());
+
+                return operand_type{vector_type(
+                    blaze::trans(lhs.matrix()) * rhs.vector())};
+            }
+
+            operand_type vector_matrix(operand_type&& lhs, operand_type&& rhs)
+            {
+                check_dimensions(lhs, 1);
+                check_dimensions(rhs, 2);
+                check_extent(lhs.size(), rhs.dimension(0));
+
+                return operand_type{vector_type(blaze::trans(
+                    blaze::trans(lhs.vector()) * rhs.matrix()))};
+            }
+
+            operand_type gemm(operand_type&& lhs, operand_type&& rhs)
+            {
+                check_dimensions(lhs, 2);
+                check_dimensions(rhs, 2);
+                check_extent(lhs.dimension(1), rhs.dimension(0));
+
+                lhs.matrix() *= rhs.matrix();
+                return std::move(lhs);
+            }
+
+            operand_type gemm_trans_rhs(operand_type&& lhs, operand_type&& rhs)
+            {
+                check_dimensions(lhs, 2);
+                check_dimensions(rhs, 2);
+                check_extent(lhs.dimension(1), rhs.dimension(1));
+
+                return operand_type{
+                    matrix_type(lhs.matrix() * blaze::trans(rhs.matrix()))};
+            }
+
+            operand_type gemm_trans_lhs(operand_type&& lhs, operand_type&& rhs)
+            {
+                check_dimensions(lhs, 2);
+                check_dimensions(rhs, 2);
+                check_extent(lhs.dimension(0), rhs.dimension(0));
+
+                return operand_type{
+                    matrix_type(blaze::trans(lhs.matrix()) * rhs.matrix())};
+            }
+
+            operand_type mul2d2d(operand_type&& lhs, operand_type&& rhs)
+            {
+                check_dimensions(lhs, 2);
+                check_dimensions(rhs, 2);
+                check_extent(lhs.dimension(0), rhs.dimension(0));
+                check_extent(lhs.dimension(1), rhs.dimension(1));
+
+                lhs.matrix() %= rhs.matrix();
+                return std::move(lhs);
+            }
+
+            operand_type inner2d2d(operand_type&& lhs, operand_type&& rhs)
+            {
+                check_dimensions(lhs, 2);
+                check_dimensions(rhs, 2);
+                check_extent(lhs.dimension(0), rhs.dimension(0));
+                check_extent(lhs.dimension(1), rhs.dimension(1));
+
+                matrix_type const& a = lhs.matrix();
+                matrix_type const& b = rhs.matrix();
+
+                double result = 0.0;
+                for (std::size_t i = 0; i != a.rows(); ++i)
+                {
+                    for (std::size_t j = 0; j != a.columns(); ++j)
+                    {
+                        result += a(i, j) * b(i, j);
+                    }
+                }
+                return operand_type{result};
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            // All supported contractions, keyed by their canonical subscripts
+            std::map<std::string, unary_kernel_type> const& unary_kernels()
+            {
+                static std::map<std::string, unary_kernel_type> const kernels =
+                {
+                    { "i->i", &identity1d },
+                    { "i->", &sum1d },
+                    { "ij->ij", &identity2d },
+                    { "ij->ji", &transpose2d },
+                    { "ij->", &sum2d },
+                    { "ij->i", &row_sums },
+                    { "ij->j", &column_sums },
+                    { "ii->", &trace },
+                    { "ii->i", &diagonal }
+                };
+                return kernels;
+            }
+
+            std::map<std::string, binary_kernel_type> const& binary_kernels()
+            {
+                static std::map<std::string, binary_kernel_type> const kernels =
+                {
+                    { "i,i->", &dot1d1d },
+                    { "i,i->i", &mul1d1d },
+                    { "i,j->ij", &outer1d1d },
+                    { "ij,j->i", &gemv },
+                    { "ij,i->j", &gemv_trans },
+                    { "i,ij->j", &vector_matrix },
+                    { "ij,jk->ik", &gemm },
+                    { "ij,kj->ik", &gemm_trans_rhs },
+                    { "ij,ik->jk", &gemm_trans_lhs },
+                    { "ij,ij->ij", &mul2d2d },
+                    { "ij,ij->", &inner2d2d }
+                };
+                return kernels;
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            // Rename the subscript labels in the order of their first
+            // appearance, e.g. 'ab,bc->ac' becomes 'ij,jk->ik'.
+            std::string canonical_subscripts(std::string const& subscripts)
+            {
+                if (subscripts.find("->") == std::string::npos)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "einsum_operation::eval",
+                        "the einsum subscripts must explicitly specify the "
+                            "output subscripts (using '->'): " + subscripts);
+                }
+
+                std::map<char, char> labels;
+                char next = 'i';
+
+                std::string result;
+                result.reserve(subscripts.size());
+                for (char c : subscripts)
+                {
+                    if (std::isspace(static_cast<unsigned char>(c)))
+                    {
+                        continue;
+                    }
+
+                    if (std::isalpha(static_cast<unsigned char>(c)))
+                    {
+                        auto it = labels.find(c);
+                        if (it == labels.end())
+                        {
+                            it = labels.emplace(c, next++).first;
+                        }
+                        result.push_back(it->second);
+                    }
+                    else
+                    {
+                        result.push_back(c);
+                    }
+                }
+                return result;
+            }
+        }
+
+        struct einsum : std::enable_shared_from_this<einsum>
+        {
+            einsum() = default;
+
+        protected:
+            using operand_type = ir::node_data<double>;
+            using operands_type = std::vector<operand_type>;
+
+            primitive_result_type evaluate(
+                std::string const& subscripts, operands_type && ops) const
+            {
+                std::string key =
+                    einsum_kernels::canonical_subscripts(subscripts);
+
+                if (ops.size() == 1)
+                {
+                    auto const& kernels = einsum_kernels::unary_kernels();
+                    auto it = kernels.find(key);
+                    if (it != kernels.end())
+                    {
+                        return (*it->second)(std::move(ops[0]));
+                    }
+                }
+                else
+                {
+                    auto const& kernels = einsum_kernels::binary_kernels();
+                    auto it = kernels.find(key);
+                    if (it != kernels.end())
+                    {
+                        return (*it->second)(
+                            std::move(ops[0]), std::move(ops[1]));
+                    }
+                }
+
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "einsum_operation::eval",
+                    "unsupported einsum subscripts: " + subscripts);
+            }
+
+        public:
+            hpx::future<primitive_result_type> eval(
+                std::vector<primitive_argument_type> const& operands,
+                std::vector<primitive_argument_type> const& args)
+            {
+                if (operands.size() != 2 && operands.size() != 3)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "einsum_operation::eval",
+                        "the einsum_operation primitive requires a subscripts "
+                            "string and one or two operands");
+                }
+
+                for (auto const& operand : operands)
+                {
+                    if (!valid(operand))
+                    {
+                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "einsum_operation::eval",
+                            "the einsum_operation primitive requires that the "
+                                "arguments given by the operands array are "
+                                "valid");
+                    }
+                }
+
+                std::vector<hpx::future<operand_type>> ops;
+                ops.reserve(operands.size() - 1);
+                for (std::size_t i = 1; i != operands.size(); ++i)
+                {
+                    ops.push_back(numeric_operand(operands[i], args));
+                }
+
+                auto this_ = this->shared_from_this();
+                return hpx::dataflow(hpx::util::unwrapping(
+                    [this_](primitive_argument_type&& subscripts,
+                            operands_type&& ops)
+                    ->  primitive_result_type
+                    {
+                        std::string const* s =
+                            util::get_if<std::string>(&subscripts);
+                        if (s == nullptr)
+                        {
+                            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                                "einsum_operation::eval",
+                                "the first argument of einsum must be a "
+                                    "string specifying the subscripts");
+                        }
+                        return this_->evaluate(*s, std::move(ops));
+                    }),
+                    literal_operand(operands[0], args), std::move(ops));
+            }
+        };
+    }
+
+    hpx::future<primitive_result_type> einsum_operation::eval(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        if (operands_.empty())
+        {
+            return std::make_shared<detail::einsum>()->eval(args, noargs);
+        }
+
+        return std::make_shared<detail::einsum>()->eval(operands_, args);
+    }
+}}}
@@ -76,10 +76,30 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 return ir::node_data<double>(std::move(result));
             }
 
-        public:
-            hpx::future<primitive_result_type> eval(
-                std::vector<primitive_argument_type> const& operands,
-                std::vector<primitive_argument_type> const& args) const
+            primitive_result_type exponential_all(operands_type && ops) const
+            {
+                std::size_t dims = ops[0].num_dimensions();
+                switch (dims)
+                {
+                case 0:
+                    return exponential0d(std::move(ops));
+
+                case 1:
+                    return exponential1d(std::move(ops));
+
+                case 2:
+                    return exponentialxd(std::move(ops));
+
+                default:
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "exponential_operation::eval",
+                        "left hand side operand has unsupported "
+                            "number of dimensions");
+                }
+            }
+
+            void verify_operands(
+                std::vector<primitive_argument_type> const& operands) const
             {
                 if (operands.size() != 1)
                 {
@@ -97,32 +117,32 @@ namespace phylanx { namespace execution_tree { namespace primitives
                             "that the arguments given by the operands array"
                             " is valid");
                 }
+            }
+
+        public:
+            hpx::future<primitive_result_type> eval(
+                std::vector<primitive_argument_type> const& operands,
+                std::vector<primitive_argument_type> const& args) const
+            {
+                verify_operands(operands);
 
                 auto this_ = this->shared_from_this();
-                return hpx::dataflow(hpx::util::unwrapping(
-                    [this_](operands_type&& ops) -> primitive_result_type
+                return detail::invoke_when_ready(
+                    [this_](operands_type && ops) -> primitive_result_type
                     {
-                        std::size_t dims = ops[0].num_dimensions();
-                        switch (dims)
-                        {
-                        case 0:
-                            return this_->exponential0d(std::move(ops));
-
-                        case 1:
-                            return this_->exponential1d(std::move(ops));
-
-                        case 2:
-                            return this_->exponentialxd(std::move(ops));
-
-                        default:
-                            HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                                "exponential_operation::eval",
-                                "left hand side operand has unsupported "
-                                    "number of dimensions");
-                        }
-                    }),
-                    detail::map_operands(operands, numeric_operand, args)
-                );
+                        return this_->exponential_all(std::move(ops));
+                    },
+                    detail::map_operands(operands, numeric_operand, args));
+            }
+
+            primitive_result_type eval_direct(
+                std::vector<primitive_argument_type> const& operands,
+                std::vector<primitive_argument_type> const& args) const
+            {
+                verify_operands(operands);
+
+                return exponential_all(detail::map_operands(
+                    operands, numeric_operand_sync, args));
             }
         };
     }
@@ -138,4 +158,15 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         return std::make_shared<detail::exp>()->eval(operands_, args);
     }
+
+    primitive_result_type exponential_operation::eval_direct(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        if (operands_.empty())
+        {
+            return detail::exp{}.eval_direct(args, noargs);
+        }
+
+        return detail::exp{}.eval_direct(operands_, args);
+    }
 }}}
@@ -0,0 +1,74 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/float32_operation.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/util.hpp>
+
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+typedef hpx::components::component<
+    phylanx::execution_tree::primitives::float32_operation>
+    float32_operation_type;
+HPX_REGISTER_DERIVED_COMPONENT_FACTORY(float32_operation_type,
+    phylanx_float32_operation_component, "phylanx_primitive_component",
+    hpx::components::factory_enabled)
+HPX_DEFINE_GET_COMPONENT_TYPE(float32_operation_type::wrapped_type)
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<match_pattern_type> const float32_operation::match_data =
+    {
+        hpx::util::make_tuple(
+            "float32", "float32(_1)", &create<float32_operation>)
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    float32_operation::float32_operation(
+            std::vector<primitive_argument_type>&& operands)
+      : base_primitive(std::move(operands))
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_result_type> float32_operation::eval(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        std::vector<primitive_argument_type> const& operands =
+            operands_.empty() ? args : operands_;
+        std::vector<primitive_argument_type> const& params =
+            operands_.empty() ? noargs : args;
+
+        if (operands.size() != 1)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "float32_operation::eval",
+                "the float32_operation primitive requires exactly one "
+                    "operand");
+        }
+
+        if (!valid(operands[0]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "float32_operation::eval",
+                "the float32_operation primitive requires that the argument "
+                    "given by the operands array is valid");
+        }
+
+        return literal_operand(operands[0], params).then(
+            [](hpx::future<primitive_argument_type>&& f)
+            -> primitive_result_type
+            {
+                return extract_float32_value(f.get());
+            });
+    }
+}}}
@@ -45,6 +45,29 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
     namespace detail
     {
+        void verify_for_operands(
+            std::vector<primitive_argument_type> const& operands)
+        {
+            if (operands.size() != 4)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::primitives::for_operation::"
+                        "eval",
+                    "the for_operation primitive requires exactly four "
+                        "arguments");
+            }
+
+            if (!valid(operands[0]) || !valid(operands[1])
+                || !valid(operands[2]) || !valid(operands[3]))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::primitives::for_operation::"
+                        "eval",
+                    "the for_operation primitive requires that the arguments "
+                        "given by the operands array are valid");
+            }
+        }
+
         struct iteration_for : std::enable_shared_from_this<iteration_for>
         {
             iteration_for(std::vector<primitive_argument_type> const& operands,
@@ -52,85 +75,122 @@ namespace phylanx { namespace execution_tree { namespace primitives
               : operands_(operands)
               , args_(args)
             {
-                if (operands_.size() != 4)
-                {
-                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                        "phylanx::execution_tree::primitives::for_operation::"
-                            "eval",
-                        "the for_operation primitive requires exactly four "
-                            "arguments");
-                }
+                verify_for_operands(operands_);
+            }
 
-                if (!valid(operands_[0]) || !valid(operands_[1])
-                    || !valid(operands_[2]) || !valid(operands_[3]))
+            hpx::future<primitive_result_type> init()
+            {
+                hpx::future<primitive_result_type> val =
+                    literal_operand(operands_[0], args_);
+                if (!val.is_ready())
                 {
-                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                        "phylanx::execution_tree::primitives::for_operation::"
-                            "eval",
-                        "the for_operation primitive requires that the arguments "
-                            "given by the operands array are valid");
+                    return resume(std::move(val), false);
                 }
+                val.get();
+                return loop();
             }
 
-            hpx::future<primitive_result_type> init()
+            // Run as many iterations as possible in place. Only if any of the
+            // condition, the body, or the reinit statement is not available
+            // yet do we attach a continuation and resume the loop once the
+            // value has been computed.
+            hpx::future<primitive_result_type> loop()
             {
-                auto this_ = this->shared_from_this();
-                return literal_operand(operands_[0], args_).then(
-                    [this_](auto val)
+                while (true)
+                {
+                    // evaluate condition of for statement
+                    hpx::future<primitive_result_type> cond =
+                        literal_operand(operands_[1], args_);
+                    if (!cond.is_ready())
                     {
-                        val.get();
-                        return this_->loop();
-                    });
-            }
+                        auto this_ = this->shared_from_this();
+                        return cond.then(
+                            [this_](hpx::future<primitive_result_type> && cond)
+                            {
+                                return this_->body(std::move(cond));
+                            });
+                    }
+
+                    if (!extract_boolean_value(cond.get()))
+                    {
+                        return hpx::make_ready_future(std::move(result_));
+                    }
 
-            hpx::future<primitive_result_type> reinit()
-            {
-                auto this_ = this->shared_from_this();
-                return literal_operand(operands_[2], args_).then(
-                    [this_](hpx::future<primitive_result_type> && val)
+                    // evaluate body of for statement
+                    hpx::future<primitive_result_type> body =
+                        literal_operand(operands_[3], args_);
+                    if (!body.is_ready())
                     {
-                        val.get();
-                        return this_->loop();   // call the loop again
-                    });
+                        return resume(std::move(body), true);
+                    }
+                    result_ = body.get();
+
+                    // do the reinit statement
+                    hpx::future<primitive_result_type> val =
+                        literal_operand(operands_[2], args_);
+                    if (!val.is_ready())
+                    {
+                        return resume(std::move(val), false);
+                    }
+                    val.get();
+                }
             }
 
+        private:
             hpx::future<primitive_result_type> body(
                 hpx::future<primitive_result_type>&& cond)
             {
                 if (extract_boolean_value(cond.get()))
                 {
-                    // evaluate body of for statement
-                    auto this_ = this->shared_from_this();
-                    return literal_operand(operands_[3], args_).then(
-                        [this_](
-                            hpx::future<primitive_result_type> && result
-                        ) mutable
-                        {
-                            this_->result_ = result.get();
-                            return this_->reinit();    // do the reinit statement
-                        });
+                    hpx::future<primitive_result_type> body =
+                        literal_operand(operands_[3], args_);
+                    if (!body.is_ready())
+                    {
+                        return resume(std::move(body), true);
+                    }
+                    result_ = body.get();
+                    return reinit();
                 }
+                return hpx::make_ready_future(std::move(result_));
+            }
 
-                hpx::future<primitive_result_type> f = p_.get_future();
-                p_.set_value(std::move(result_));
-                return f;
+            hpx::future<primitive_result_type> reinit()
+            {
+                hpx::future<primitive_result_type> val =
+                    literal_operand(operands_[2], args_);
+                if (!val.is_ready())
+                {
+                    return resume(std::move(val), false);
+                }
+                val.get();
+                return loop();
             }
 
-            hpx::future<primitive_result_type> loop()
+            // wait for the given future and continue with the condition, if
+            // the future represents the loop body the result is stored
+            hpx::future<primitive_result_type> resume(
+                hpx::future<primitive_result_type>&& f, bool is_body)
             {
-                // evaluate condition of for statement
                 auto this_ = this->shared_from_this();
-                return literal_operand(operands_[1], args_).then(
-                    [this_](hpx::future<primitive_result_type> && cond)
+                if (is_body)
+                {
+                    return f.then(
+                        [this_](hpx::future<primitive_result_type> && result)
+                        {
+                            this_->result_ = result.get();
+                            return this_->reinit();
+                        });
+                }
+                return f.then(
+                    [this_](hpx::future<primitive_result_type> && val)
                     {
-                        return this_->body(std::move(cond));
+                        val.get();
+                        return this_->loop();
                     });
             }
 
-        private:
             std::vector<primitive_argument_type> operands_;
             std::vector<primitive_argument_type> args_;
-            hpx::promise<primitive_result_type> p_;
             primitive_result_type result_;
         };
     }
@@ -146,4 +206,24 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         return std::make_shared<detail::iteration_for>(operands_, args)->init();
     }
+
+    primitive_result_type for_operation::eval_direct(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        std::vector<primitive_argument_type> const& operands =
+            operands_.empty() ? args : operands_;
+        std::vector<primitive_argument_type> const& params =
+            operands_.empty() ? noargs : args;
+
+        detail::verify_for_operands(operands);
+
+        primitive_result_type result;
+        for (literal_operand_sync(operands[0], params);
+             extract_boolean_value(literal_operand_sync(operands[1], params));
+             literal_operand_sync(operands[2], params))
+        {
+            result = literal_operand_sync(operands[3], params);
+        }
+        return result;
+    }
 }}}
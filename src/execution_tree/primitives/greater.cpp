@@ -242,6 +242,38 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     return lhs > rhs[0];
                 }
 
+                // data stored in single precision is compared element-wise
+                // after widening it to double precision
+                bool operator()(ir::node_data<float>&& lhs,
+                    ir::node_data<float>&& rhs) const
+                {
+                    return (*this)(operand_type(lhs), operand_type(rhs));
+                }
+
+                bool operator()(
+                    ir::node_data<float>&& lhs, operand_type&& rhs) const
+                {
+                    return (*this)(operand_type(lhs), std::move(rhs));
+                }
+
+                bool operator()(
+                    operand_type&& lhs, ir::node_data<float>&& rhs) const
+                {
+                    return (*this)(std::move(lhs), operand_type(rhs));
+                }
+
+                bool operator()(
+                    ir::node_data<float>&& lhs, std::int64_t&& rhs) const
+                {
+                    return (*this)(operand_type(lhs), std::move(rhs));
+                }
+
+                bool operator()(
+                    std::int64_t&& lhs, ir::node_data<float>&& rhs) const
+                {
+                    return (*this)(std::move(lhs), operand_type(rhs));
+                }
+
                 bool operator()(operand_type&& lhs, operand_type&& rhs) const
                 {
                     return greater_.greater_all(std::move(lhs), std::move(rhs));
@@ -250,10 +282,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 greater const& greater_;
             };
 
-        public:
-            hpx::future<primitive_result_type> eval(
-                std::vector<primitive_argument_type> const& operands,
-                std::vector<primitive_argument_type> const& args) const
+            void verify_operands(
+                std::vector<primitive_argument_type> const& operands) const
             {
                 if (operands.size() != 2)
                 {
@@ -269,17 +299,37 @@ namespace phylanx { namespace execution_tree { namespace primitives
                         "the greater primitive requires that the arguments given "
                             "by the operands array are valid");
                 }
+            }
+
+        public:
+            hpx::future<primitive_result_type> eval(
+                std::vector<primitive_argument_type> const& operands,
+                std::vector<primitive_argument_type> const& args) const
+            {
+                verify_operands(operands);
 
                 auto this_ = this->shared_from_this();
-                return hpx::dataflow(hpx::util::unwrapping(
+                return detail::invoke_when_ready(
                     [this_](operands_type && ops)
                     {
                         return primitive_result_type(
                             util::visit(visit_greater{*this_},
                                 std::move(ops[0]), std::move(ops[1])));
-                    }),
-                    detail::map_operands(operands, literal_operand, args)
-                );
+                    },
+                    detail::map_operands(operands, literal_operand, args));
+            }
+
+            primitive_result_type eval_direct(
+                std::vector<primitive_argument_type> const& operands,
+                std::vector<primitive_argument_type> const& args) const
+            {
+                verify_operands(operands);
+
+                operands_type ops = detail::map_operands_concurrently(
+                    operands, literal_operand_sync, args);
+
+                return primitive_result_type(util::visit(visit_greater{*this},
+                    std::move(ops[0]), std::move(ops[1])));
             }
         };
     }
@@ -295,4 +345,15 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         return std::make_shared<detail::greater>()->eval(operands_, args);
     }
+
+    primitive_result_type greater::eval_direct(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        if (operands_.empty())
+        {
+            return detail::greater{}.eval_direct(args, noargs);
+        }
+
+        return detail::greater{}.eval_direct(operands_, args);
+    }
 }}}
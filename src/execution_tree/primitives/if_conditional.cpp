@@ -48,6 +48,34 @@ namespace phylanx { namespace execution_tree { namespace primitives
     // (used to resolve lifetime issues)
     namespace detail
     {
+        void verify_if_operands(
+            std::vector<primitive_argument_type> const& operands)
+        {
+            if (operands.size() != 3 && operands.size() != 2)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "if_conditional::if_conditional",
+                    "the if_conditional primitive requires three operands");
+            }
+
+            bool arguments_valid = true;
+            for (std::size_t i = 0; i != operands.size(); ++i)
+            {
+                if (!valid(operands[i]))
+                {
+                    arguments_valid = false;
+                }
+            }
+
+            if (!arguments_valid)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "if_conditional::if_conditional",
+                    "the if_conditional primitive requires that the "
+                        "arguments given by the operands array is valid");
+            }
+        }
+
         struct if_impl : std::enable_shared_from_this<if_impl>
         {
             if_impl(std::vector<primitive_argument_type> const& operands,
@@ -55,29 +83,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
               : operands_(operands)
               , args_(args)
             {
-                if (operands_.size() != 3 && operands_.size() != 2)
-                {
-                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                        "if_conditional::if_conditional",
-                        "the if_conditional primitive requires three operands");
-                }
-
-                bool arguments_valid = true;
-                for (std::size_t i = 0; i != operands_.size(); ++i)
-                {
-                    if (!valid(operands_[i]))
-                    {
-                        arguments_valid = false;
-                    }
-                }
-
-                if (!arguments_valid)
-                {
-                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                        "if_conditional::if_conditional",
-                        "the if_conditional primitive requires that the "
-                            "arguments given by the operands array is valid");
-                }
+                verify_if_operands(operands_);
             }
 
             hpx::future<primitive_result_type> body()
@@ -119,4 +125,25 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         return std::make_shared<detail::if_impl>(operands_, args)->body();
     }
+
+    primitive_result_type if_conditional::eval_direct(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        std::vector<primitive_argument_type> const& operands =
+            operands_.empty() ? args : operands_;
+        std::vector<primitive_argument_type> const& params =
+            operands_.empty() ? noargs : args;
+
+        detail::verify_if_operands(operands);
+
+        if (boolean_operand_sync(operands[0], params) != 0)
+        {
+            return literal_operand_sync(operands[1], params);
+        }
+        else if (operands.size() > 2)
+        {
+            return literal_operand_sync(operands[2], params);
+        }
+        return primitive_result_type{};
+    }
 }}}
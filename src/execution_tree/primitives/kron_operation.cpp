@@ -0,0 +1,190 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/kron_operation.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/serialization/blaze.hpp>
+
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/util.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+typedef hpx::components::component<
+    phylanx::execution_tree::primitives::kron_operation>
+    kron_operation_type;
+HPX_REGISTER_DERIVED_COMPONENT_FACTORY(kron_operation_type,
+    phylanx_kron_operation_component, "phylanx_primitive_component",
+    hpx::components::factory_enabled)
+HPX_DEFINE_GET_COMPONENT_TYPE(kron_operation_type::wrapped_type)
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<match_pattern_type> const kron_operation::match_data =
+    {
+        hpx::util::make_tuple("kron", "kron(_1, _2)", &create<kron_operation>)
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    kron_operation::kron_operation(
+            std::vector<primitive_argument_type>&& operands)
+      : base_primitive(std::move(operands))
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        struct kron : std::enable_shared_from_this<kron>
+        {
+            kron() = default;
+
+        protected:
+            using operand_type = ir::node_data<double>;
+            using operands_type = std::vector<operand_type>;
+
+            using vector_type = blaze::DynamicVector<double>;
+            using matrix_type = blaze::DynamicMatrix<double>;
+
+            // a vector combined with a matrix is treated as a row vector
+            static matrix_type as_matrix(operand_type const& op)
+            {
+                if (op.num_dimensions() == 2)
+                {
+                    return op.matrix();
+                }
+                return matrix_type(blaze::trans(op.vector()));
+            }
+
+            primitive_result_type kron0d(operands_type && ops) const
+            {
+                operand_type& lhs = ops[0];
+                operand_type& rhs = ops[1];
+
+                switch (rhs.num_dimensions())
+                {
+                case 0:
+                    lhs.scalar() *= rhs.scalar();
+                    return std::move(lhs);
+
+                case 1:
+                    rhs.vector() *= lhs.scalar();
+                    return std::move(rhs);
+
+                case 2:
+                    rhs.matrix() *= lhs.scalar();
+                    return std::move(rhs);
+
+                default:
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "kron_operation::kron0d",
+                        "right hand side operand has unsupported number of "
+                            "dimensions");
+                }
+            }
+
+            primitive_result_type kron1d1d(
+                operand_type const& lhs, operand_type const& rhs) const
+            {
+                vector_type const& a = lhs.vector();
+                vector_type const& b = rhs.vector();
+
+                std::size_t const n = b.size();
+                vector_type result(a.size() * n);
+                for (std::size_t i = 0; i != a.size(); ++i)
+                {
+                    blaze::subvector(result, i * n, n) = a[i] * b;
+                }
+                return operand_type{std::move(result)};
+            }
+
+            primitive_result_type kron2d2d(
+                matrix_type const& a, matrix_type const& b) const
+            {
+                std::size_t const rows = b.rows();
+                std::size_t const columns = b.columns();
+
+                matrix_type result(a.rows() * rows, a.columns() * columns);
+                for (std::size_t i = 0; i != a.rows(); ++i)
+                {
+                    for (std::size_t j = 0; j != a.columns(); ++j)
+                    {
+                        blaze::submatrix(result, i * rows, j * columns,
+                            rows, columns) = a(i, j) * b;
+                    }
+                }
+                return operand_type{std::move(result)};
+            }
+
+        public:
+            hpx::future<primitive_result_type> eval(
+                std::vector<primitive_argument_type> const& operands,
+                std::vector<primitive_argument_type> const& args)
+            {
+                if (operands.size() != 2)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "kron_operation::eval",
+                        "the kron_operation primitive requires exactly two "
+                            "operands");
+                }
+
+                if (!valid(operands[0]) || !valid(operands[1]))
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "kron_operation::eval",
+                        "the kron_operation primitive requires that the "
+                            "arguments given by the operands array are valid");
+                }
+
+                auto this_ = this->shared_from_this();
+                return hpx::dataflow(hpx::util::unwrapping(
+                    [this_](operands_type&& ops) -> primitive_result_type
+                    {
+                        std::size_t lhs_dims = ops[0].num_dimensions();
+                        std::size_t rhs_dims = ops[1].num_dimensions();
+
+                        if (lhs_dims == 0)
+                        {
+                            return this_->kron0d(std::move(ops));
+                        }
+                        if (rhs_dims == 0)
+                        {
+                            std::swap(ops[0], ops[1]);
+                            return this_->kron0d(std::move(ops));
+                        }
+                        if (lhs_dims == 1 && rhs_dims == 1)
+                        {
+                            return this_->kron1d1d(ops[0], ops[1]);
+                        }
+                        return this_->kron2d2d(
+                            as_matrix(ops[0]), as_matrix(ops[1]));
+                    }),
+                    detail::map_operands(operands, numeric_operand, args)
+                );
+            }
+        };
+    }
+
+    hpx::future<primitive_result_type> kron_operation::eval(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        if (operands_.empty())
+        {
+            return std::make_shared<detail::kron>()->eval(args, noargs);
+        }
+
+        return std::make_shared<detail::kron>()->eval(operands_, args);
+    }
+}}}
@@ -0,0 +1,129 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/let_operation.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+typedef hpx::components::component<
+    phylanx::execution_tree::primitives::let_operation>
+    let_operation_type;
+HPX_REGISTER_DERIVED_COMPONENT_FACTORY(let_operation_type,
+    phylanx_let_operation_component, "phylanx_primitive_component",
+    hpx::components::factory_enabled)
+HPX_DEFINE_GET_COMPONENT_TYPE(let_operation_type::wrapped_type)
+
+typedef hpx::components::component<
+    phylanx::execution_tree::primitives::access_temporary>
+    access_temporary_type;
+HPX_REGISTER_DERIVED_COMPONENT_FACTORY(access_temporary_type,
+    phylanx_access_temporary_component, "phylanx_primitive_component",
+    hpx::components::factory_enabled)
+HPX_DEFINE_GET_COMPONENT_TYPE(access_temporary_type::wrapped_type)
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    let_operation::let_operation(
+            std::vector<primitive_argument_type>&& operands)
+      : base_primitive(std::move(operands))
+    {
+        if (operands_.size() < 2)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "phylanx::execution_tree::primitives::"
+                    "let_operation::let_operation",
+                "the let_operation primitive requires at least two operands");
+        }
+    }
+
+    namespace detail
+    {
+        struct let : std::enable_shared_from_this<let>
+        {
+            let(std::vector<primitive_argument_type> const& operands,
+                    std::vector<primitive_argument_type> const& args)
+              : operands_(operands)
+              , args_(args)
+            {}
+
+            hpx::future<primitive_result_type> eval()
+            {
+                std::vector<hpx::future<primitive_result_type>> temporaries;
+                temporaries.reserve(operands_.size() - 1);
+                for (std::size_t i = 0; i != operands_.size() - 1; ++i)
+                {
+                    temporaries.push_back(value_operand(operands_[i], args_));
+                }
+
+                auto this_ = this->shared_from_this();
+                return hpx::dataflow(hpx::util::unwrapping(
+                    [this_](std::vector<primitive_result_type> && values)
+                    {
+                        std::vector<primitive_argument_type>& args =
+                            this_->args_;
+
+                        args.reserve(args.size() + values.size());
+                        for (auto && value : values)
+                        {
+                            args.push_back(std::move(value));
+                        }
+                        return value_operand(this_->operands_.back(), args);
+                    }),
+                    std::move(temporaries));
+            }
+
+        private:
+            std::vector<primitive_argument_type> operands_;
+            std::vector<primitive_argument_type> args_;
+        };
+    }
+
+    hpx::future<primitive_result_type> let_operation::eval(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        return std::make_shared<detail::let>(operands_, args)->eval();
+    }
+
+    primitive_result_type let_operation::eval_direct(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        std::vector<primitive_argument_type> params(args);
+        params.reserve(args.size() + operands_.size() - 1);
+
+        for (std::size_t i = 0; i != operands_.size() - 1; ++i)
+        {
+            params.push_back(value_operand_sync(operands_[i], args));
+        }
+        return value_operand_sync(operands_.back(), params);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    primitive_result_type access_temporary::eval_direct(
+        std::vector<primitive_argument_type> const& params) const
+    {
+        if (offset_ >= params.size())
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "phylanx::execution_tree::primitives::"
+                    "access_temporary::eval_direct",
+                "temporary offset out of bounds: " + std::to_string(offset_));
+        }
+        return params[params.size() - offset_ - 1];
+    }
+}}}
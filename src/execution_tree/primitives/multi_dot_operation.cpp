@@ -0,0 +1,307 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/multi_dot_operation.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/serialization/blaze.hpp>
+
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/util.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+typedef hpx::components::component<
+    phylanx::execution_tree::primitives::multi_dot_operation>
+    multi_dot_operation_type;
+HPX_REGISTER_DERIVED_COMPONENT_FACTORY(multi_dot_operation_type,
+    phylanx_multi_dot_operation_component, "phylanx_primitive_component",
+    hpx::components::factory_enabled)
+HPX_DEFINE_GET_COMPONENT_TYPE(multi_dot_operation_type::wrapped_type)
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<match_pattern_type> const multi_dot_operation::match_data =
+    {
+        hpx::util::make_tuple("multi_dot", "multi_dot(__1)",
+            &create<multi_dot_operation>)
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    multi_dot_operation::multi_dot_operation(
+            std::vector<primitive_argument_type>&& operands)
+      : base_primitive(std::move(operands))
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        struct multi_dot : std::enable_shared_from_this<multi_dot>
+        {
+            multi_dot() = default;
+
+        protected:
+            using operand_type = ir::node_data<double>;
+            using operands_type = std::vector<operand_type>;
+
+            using vector_type = blaze::DynamicVector<double>;
+            using matrix_type = blaze::DynamicMatrix<double>;
+
+            // The operands form a valid matrix chain if all inner operands
+            // are matrices with matching extents. The first operand may be a
+            // vector (treated as a row vector), the last operand may be a
+            // vector (treated as a column vector).
+            static bool is_matrix_chain(operands_type const& ops)
+            {
+                std::size_t const last = ops.size() - 1;
+                for (std::size_t i = 0; i != ops.size(); ++i)
+                {
+                    std::size_t dims = ops[i].num_dimensions();
+                    if (dims == 2)
+                    {
+                        continue;
+                    }
+                    if (dims != 1 || (i != 0 && i != last))
+                    {
+                        return false;
+                    }
+                }
+
+                for (std::size_t i = 0; i != last; ++i)
+                {
+                    std::size_t lhs_inner = ops[i].num_dimensions() == 1 ?
+                        ops[i].dimension(0) : ops[i].dimension(1);
+                    if (lhs_inner != ops[i + 1].dimension(0))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            static matrix_type as_matrix(operand_type& op, bool row)
+            {
+                if (op.num_dimensions() == 2)
+                {
+                    return std::move(op.matrix());
+                }
+
+                vector_type const& v = op.vector();
+                if (row)
+                {
+                    matrix_type result(1, v.size());
+                    blaze::row(result, 0) = blaze::trans(v);
+                    return result;
+                }
+
+                matrix_type result(v.size(), 1);
+                blaze::column(result, 0) = v;
+                return result;
+            }
+
+            // Classic dynamic programming solution of the matrix chain
+            // ordering problem: split[i][j] is the position at which the
+            // sub-chain [i, j] is divided for the cheapest evaluation.
+            static std::vector<std::vector<std::size_t>> optimal_order(
+                std::vector<std::size_t> const& extents)
+            {
+                std::size_t const n = extents.size() - 1;
+
+                std::vector<std::vector<double>> cost(
+                    n, std::vector<double>(n, 0.0));
+                std::vector<std::vector<std::size_t>> split(
+                    n, std::vector<std::size_t>(n, 0));
+
+                for (std::size_t length = 1; length != n; ++length)
+                {
+                    for (std::size_t i = 0; i + length != n; ++i)
+                    {
+                        std::size_t j = i + length;
+                        cost[i][j] = (std::numeric_limits<double>::max)();
+                        for (std::size_t k = i; k != j; ++k)
+                        {
+                            double c = cost[i][k] + cost[k + 1][j] +
+                                double(extents[i]) * extents[k + 1] *
+                                    extents[j + 1];
+                            if (c < cost[i][j])
+                            {
+                                cost[i][j] = c;
+                                split[i][j] = k;
+                            }
+                        }
+                    }
+                }
+                return split;
+            }
+
+            static matrix_type multiply(std::vector<matrix_type>& ms,
+                std::vector<std::vector<std::size_t>> const& split,
+                std::size_t i, std::size_t j)
+            {
+                if (i == j)
+                {
+                    return std::move(ms[i]);
+                }
+
+                std::size_t k = split[i][j];
+                matrix_type lhs = multiply(ms, split, i, k);
+                matrix_type rhs = multiply(ms, split, k + 1, j);
+                return lhs * rhs;
+            }
+
+            primitive_result_type chain(operands_type && ops) const
+            {
+                std::size_t const last = ops.size() - 1;
+                bool row_vector = ops[0].num_dimensions() == 1;
+                bool column_vector = ops[last].num_dimensions() == 1;
+
+                std::vector<std::size_t> extents;
+                extents.reserve(ops.size() + 1);
+                extents.push_back(row_vector ? 1 : ops[0].dimension(0));
+                for (std::size_t i = 0; i != last; ++i)
+                {
+                    extents.push_back(ops[i + 1].dimension(0));
+                }
+                extents.push_back(
+                    column_vector ? 1 : ops[last].dimension(1));
+
+                std::vector<matrix_type> ms;
+                ms.reserve(ops.size());
+                for (std::size_t i = 0; i != ops.size(); ++i)
+                {
+                    ms.push_back(as_matrix(ops[i], i == 0));
+                }
+
+                matrix_type result =
+                    multiply(ms, optimal_order(extents), 0, last);
+
+                if (row_vector && column_vector)
+                {
+                    return operand_type{result(0, 0)};
+                }
+                if (row_vector)
+                {
+                    return operand_type{
+                        vector_type(blaze::trans(blaze::row(result, 0)))};
+                }
+                if (column_vector)
+                {
+                    return operand_type{vector_type(blaze::column(result, 0))};
+                }
+                return operand_type{std::move(result)};
+            }
+
+            // Fall back to evaluating the chain from left to right for all
+            // operand combinations which do not form a matrix chain.
+            primitive_result_type left_to_right(operands_type && ops) const
+            {
+                operand_type result = std::move(ops[0]);
+                for (std::size_t i = 1; i != ops.size(); ++i)
+                {
+                    operand_type& rhs = ops[i];
+                    std::size_t lhs_dims = result.num_dimensions();
+                    std::size_t rhs_dims = rhs.num_dimensions();
+
+                    if (lhs_dims == 0 && rhs_dims == 0)
+                    {
+                        result.scalar() *= rhs.scalar();
+                    }
+                    else if (lhs_dims == 1 && rhs_dims == 1 &&
+                        result.size() == rhs.size())
+                    {
+                        result = operand_type{
+                            blaze::dot(result.vector(), rhs.vector())};
+                    }
+                    else if (lhs_dims == 1 && rhs_dims == 2 &&
+                        result.size() == rhs.dimension(0))
+                    {
+                        result = operand_type{vector_type(blaze::trans(
+                            blaze::trans(result.vector()) * rhs.matrix()))};
+                    }
+                    else if (lhs_dims == 2 && rhs_dims == 1 &&
+                        result.dimension(1) == rhs.size())
+                    {
+                        result = operand_type{
+                            vector_type(result.matrix() * rhs.vector())};
+                    }
+                    else if (lhs_dims == 2 && rhs_dims == 2 &&
+                        result.dimension(1) == rhs.dimension(0))
+                    {
+                        result = operand_type{
+                            matrix_type(result.matrix() * rhs.matrix())};
+                    }
+                    else
+                    {
+                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "multi_dot_operation::eval",
+                            "the operands have incompatible number of "
+                                "dimensions");
+                    }
+                }
+                return primitive_result_type{std::move(result)};
+            }
+
+        public:
+            hpx::future<primitive_result_type> eval(
+                std::vector<primitive_argument_type> const& operands,
+                std::vector<primitive_argument_type> const& args)
+            {
+                if (operands.size() < 2)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "multi_dot_operation::eval",
+                        "the multi_dot_operation primitive requires at least "
+                            "two operands");
+                }
+
+                for (auto const& operand : operands)
+                {
+                    if (!valid(operand))
+                    {
+                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "multi_dot_operation::eval",
+                            "the multi_dot_operation primitive requires "
+                                "that the arguments given by the operands "
+                                "array are valid");
+                    }
+                }
+
+                auto this_ = this->shared_from_this();
+                return hpx::dataflow(hpx::util::unwrapping(
+                    [this_](operands_type&& ops) -> primitive_result_type
+                    {
+                        if (ops.size() > 2 && is_matrix_chain(ops))
+                        {
+                            return this_->chain(std::move(ops));
+                        }
+                        return this_->left_to_right(std::move(ops));
+                    }),
+                    detail::map_operands(operands, numeric_operand, args)
+                );
+            }
+        };
+    }
+
+    hpx::future<primitive_result_type> multi_dot_operation::eval(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        if (operands_.empty())
+        {
+            return std::make_shared<detail::multi_dot>()->eval(args, noargs);
+        }
+
+        return std::make_shared<detail::multi_dot>()->eval(operands_, args);
+    }
+}}}
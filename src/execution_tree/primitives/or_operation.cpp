@@ -50,10 +50,25 @@ namespace phylanx { namespace execution_tree { namespace primitives
         private:
             using operands_type = std::vector<std::uint8_t>;
 
-        public:
-            hpx::future<primitive_result_type> eval(
-                std::vector<primitive_argument_type> const& operands,
-                std::vector<primitive_argument_type> const& args) const
+            primitive_result_type or_all(operands_type && ops) const
+            {
+                if (ops.size() == 2)
+                {
+                    return primitive_result_type(
+                        ops[0] != 0 || ops[1] != 0);
+                }
+
+                return primitive_result_type(
+                    std::any_of(
+                        ops.begin(), ops.end(),
+                        [](std::uint8_t curr)
+                        {
+                            return curr != 0;
+                        }));
+            }
+
+            void verify_operands(
+                std::vector<primitive_argument_type> const& operands) const
             {
                 if (operands.size() < 2)
                 {
@@ -79,27 +94,32 @@ namespace phylanx { namespace execution_tree { namespace primitives
                         "the or_operation primitive requires that the "
                             "arguments given by the operands array are valid");
                 }
+            }
+
+        public:
+            hpx::future<primitive_result_type> eval(
+                std::vector<primitive_argument_type> const& operands,
+                std::vector<primitive_argument_type> const& args) const
+            {
+                verify_operands(operands);
 
                 auto this_ = this->shared_from_this();
-                return hpx::dataflow(hpx::util::unwrapping(
-                    [this_](operands_type && ops)
+                return detail::invoke_when_ready(
+                    [this_](operands_type && ops) -> primitive_result_type
                     {
-                        if (ops.size() == 2)
-                        {
-                            return primitive_result_type(
-                                ops[0] != 0 || ops[1] != 0);
-                        }
-
-                        return primitive_result_type(
-                            std::any_of(
-                                ops.begin(), ops.end(),
-                                [](std::uint8_t curr)
-                                {
-                                    return curr != 0;
-                                }));
-                    }),
-                    detail::map_operands(operands, boolean_operand, args)
-                );
+                        return this_->or_all(std::move(ops));
+                    },
+                    detail::map_operands(operands, boolean_operand, args));
+            }
+
+            primitive_result_type eval_direct(
+                std::vector<primitive_argument_type> const& operands,
+                std::vector<primitive_argument_type> const& args) const
+            {
+                verify_operands(operands);
+
+                return or_all(detail::map_operands_concurrently(
+                    operands, boolean_operand_sync, args));
             }
         };
     }
@@ -115,4 +135,15 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         return std::make_shared<detail::or_>()->eval(operands_, args);
     }
+
+    primitive_result_type or_operation::eval_direct(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        if (operands_.empty())
+        {
+            return detail::or_{}.eval_direct(args, noargs);
+        }
+
+        return detail::or_{}.eval_direct(operands_, args);
+    }
 }}}
@@ -0,0 +1,160 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/outer_operation.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/serialization/blaze.hpp>
+
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/util.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+typedef hpx::components::component<
+    phylanx::execution_tree::primitives::outer_operation>
+    outer_operation_type;
+HPX_REGISTER_DERIVED_COMPONENT_FACTORY(outer_operation_type,
+    phylanx_outer_operation_component, "phylanx_primitive_component",
+    hpx::components::factory_enabled)
+HPX_DEFINE_GET_COMPONENT_TYPE(outer_operation_type::wrapped_type)
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<match_pattern_type> const outer_operation::match_data =
+    {
+        hpx::util::make_tuple("outer", "outer(_1, _2)", &create<outer_operation>)
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    outer_operation::outer_operation(
+            std::vector<primitive_argument_type>&& operands)
+      : base_primitive(std::move(operands))
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        struct outer : std::enable_shared_from_this<outer>
+        {
+            outer() = default;
+
+        protected:
+            using operand_type = ir::node_data<double>;
+            using operands_type = std::vector<operand_type>;
+
+            primitive_result_type outer0d(operands_type && ops) const
+            {
+                operand_type& lhs = ops[0];
+                operand_type& rhs = ops[1];
+
+                switch (rhs.num_dimensions())
+                {
+                case 0:
+                    lhs.scalar() *= rhs.scalar();
+                    return std::move(lhs);
+
+                case 1:
+                    rhs.vector() *= lhs.scalar();
+                    return std::move(rhs);
+
+                default:
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "outer_operation::outer0d",
+                        "the outer_operation primitive requires its "
+                            "operands to be scalars or vectors");
+                }
+            }
+
+            primitive_result_type outer1d(operands_type && ops) const
+            {
+                operand_type& lhs = ops[0];
+                operand_type& rhs = ops[1];
+
+                switch (rhs.num_dimensions())
+                {
+                case 0:
+                    lhs.vector() *= rhs.scalar();
+                    return std::move(lhs);
+
+                case 1:
+                    // the outer product of two column vectors
+                    return operand_type{blaze::DynamicMatrix<double>(
+                        lhs.vector() * blaze::trans(rhs.vector()))};
+
+                default:
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "outer_operation::outer1d",
+                        "the outer_operation primitive requires its "
+                            "operands to be scalars or vectors");
+                }
+            }
+
+        public:
+            hpx::future<primitive_result_type> eval(
+                std::vector<primitive_argument_type> const& operands,
+                std::vector<primitive_argument_type> const& args)
+            {
+                if (operands.size() != 2)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "outer_operation::eval",
+                        "the outer_operation primitive requires exactly two "
+                            "operands");
+                }
+
+                if (!valid(operands[0]) || !valid(operands[1]))
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "outer_operation::eval",
+                        "the outer_operation primitive requires that the "
+                            "arguments given by the operands array are valid");
+                }
+
+                auto this_ = this->shared_from_this();
+                return hpx::dataflow(hpx::util::unwrapping(
+                    [this_](operands_type&& ops) -> primitive_result_type
+                    {
+                        switch (ops[0].num_dimensions())
+                        {
+                        case 0:
+                            return this_->outer0d(std::move(ops));
+
+                        case 1:
+                            return this_->outer1d(std::move(ops));
+
+                        default:
+                            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                                "outer_operation::eval",
+                                "left hand side operand has unsupported "
+                                    "number of dimensions");
+                        }
+                    }),
+                    detail::map_operands(operands, numeric_operand, args)
+                );
+            }
+        };
+    }
+
+    hpx::future<primitive_result_type> outer_operation::eval(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        if (operands_.empty())
+        {
+            return std::make_shared<detail::outer>()->eval(args, noargs);
+        }
+
+        return std::make_shared<detail::outer>()->eval(operands_, args);
+    }
+}}}
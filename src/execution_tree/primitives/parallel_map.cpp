@@ -0,0 +1,237 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/parallel_map.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/parallel_executor_parameters.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/include/util.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+typedef hpx::components::component<
+    phylanx::execution_tree::primitives::parallel_for_operation>
+    parallel_for_operation_type;
+HPX_REGISTER_DERIVED_COMPONENT_FACTORY(parallel_for_operation_type,
+    phylanx_parallel_for_operation_component, "phylanx_primitive_component",
+    hpx::components::factory_enabled)
+HPX_DEFINE_GET_COMPONENT_TYPE(parallel_for_operation_type::wrapped_type)
+
+typedef hpx::components::component<
+    phylanx::execution_tree::primitives::map_operation>
+    map_operation_type;
+HPX_REGISTER_DERIVED_COMPONENT_FACTORY(map_operation_type,
+    phylanx_map_operation_component, "phylanx_primitive_component",
+    hpx::components::factory_enabled)
+HPX_DEFINE_GET_COMPONENT_TYPE(map_operation_type::wrapped_type)
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<match_pattern_type> const parallel_for_operation::match_data =
+    {
+        hpx::util::make_tuple("parallel_for", "parallel_for(_1, _2, _3, _4)",
+            &create<parallel_for_operation>)
+    };
+
+    std::vector<match_pattern_type> const map_operation::match_data =
+    {
+        hpx::util::make_tuple("map", "map(_1, _2)", &create<map_operation>)
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    parallel_for_operation::parallel_for_operation(
+            std::vector<primitive_argument_type>&& operands)
+      : base_primitive(std::move(operands))
+    {}
+
+    map_operation::map_operation(
+            std::vector<primitive_argument_type>&& operands)
+      : base_primitive(std::move(operands))
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // Evaluate the given function 'f' for the iteration space [0, size),
+        // storing the results in a list. The chunk size is determined
+        // at runtime based on the measured execution time of the first
+        // iterations.
+        struct parallel_map : std::enable_shared_from_this<parallel_map>
+        {
+            parallel_map(primitive_argument_type const& f, char const* name)
+              : f_(f)
+              , name_(name)
+            {
+                if (!valid(f_))
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter, name_,
+                        "the function to apply is not valid");
+                }
+            }
+
+            // invoke f(args..., first + i) for all i in [0, size)
+            hpx::future<primitive_result_type> iota(
+                std::int64_t first, std::int64_t last,
+                std::vector<primitive_argument_type> args)
+            {
+                std::size_t size =
+                    last > first ? std::size_t(last - first) : 0;
+
+                return apply(size,
+                    [first, args](std::size_t i)
+                    -> std::vector<primitive_argument_type>
+                    {
+                        std::vector<primitive_argument_type> result(args);
+                        result.push_back(
+                            primitive_argument_type{first + std::int64_t(i)});
+                        return result;
+                    });
+            }
+
+            // invoke f(elements[i]) for all i
+            hpx::future<primitive_result_type> map(
+                std::vector<primitive_argument_type>&& elements)
+            {
+                auto elems = std::make_shared<
+                    std::vector<primitive_argument_type>>(std::move(elements));
+
+                return apply(elems->size(),
+                    [elems](std::size_t i)
+                    -> std::vector<primitive_argument_type>
+                    {
+                        return std::vector<primitive_argument_type>{
+                            (*elems)[i]};
+                    });
+            }
+
+        private:
+            template <typename F>
+            hpx::future<primitive_result_type> apply(std::size_t size, F && f)
+            {
+                result_.resize(size);
+
+                using namespace hpx::parallel::execution;
+                auto policy = par(task).with(auto_chunk_size());
+
+                auto this_ = this->shared_from_this();
+                return hpx::parallel::for_loop(policy, std::size_t(0), size,
+                    [this_, f](std::size_t i)
+                    {
+                        this_->result_[i] = value_operand_sync(this_->f_, f(i));
+                    })
+                    .then(
+                        [this_](hpx::future<void> && f)
+                        {
+                            f.get();    // propagate exceptions
+                            return primitive_result_type{
+                                std::move(this_->result_)};
+                        });
+            }
+
+            primitive_argument_type f_;
+            std::vector<primitive_argument_type> result_;
+            char const* name_;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_result_type> parallel_for_operation::eval(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        std::vector<primitive_argument_type> const& operands =
+            operands_.empty() ? args : operands_;
+        std::vector<primitive_argument_type> const& params =
+            operands_.empty() ? noargs : args;
+
+        if (operands.size() != 3 && operands.size() != 4)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "parallel_for_operation::eval",
+                "the parallel_for primitive requires three or four operands "
+                    "(start, stop, the loop body, and the index of the loop "
+                    "variable)");
+        }
+
+        if (!valid(operands[0]) || !valid(operands[1]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "parallel_for_operation::eval",
+                "the parallel_for primitive requires that the arguments "
+                    "given by the operands array are valid");
+        }
+
+        // the loop variable is passed to the body after the arguments of
+        // the enclosing function
+        std::size_t index = 0;
+        if (operands.size() == 4)
+        {
+            index = std::size_t(extract_integer_value(operands[3]));
+        }
+
+        std::vector<primitive_argument_type> body_args;
+        body_args.reserve(index);
+        body_args.insert(body_args.end(), params.begin(),
+            params.begin() + (std::min)(index, params.size()));
+        body_args.resize(index);
+
+        auto f = std::make_shared<detail::parallel_map>(
+            operands[2], "parallel_for_operation::eval");
+
+        return hpx::dataflow(hpx::util::unwrapping(
+            [f, body_args](primitive_argument_type&& start,
+                primitive_argument_type&& stop)
+            {
+                return f->iota(extract_integer_value(std::move(start)),
+                    extract_integer_value(std::move(stop)), body_args);
+            }),
+            literal_operand(operands[0], params),
+            literal_operand(operands[1], params));
+    }
+
+    hpx::future<primitive_result_type> map_operation::eval(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        std::vector<primitive_argument_type> const& operands =
+            operands_.empty() ? args : operands_;
+        std::vector<primitive_argument_type> const& params =
+            operands_.empty() ? noargs : args;
+
+        if (operands.size() != 2)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "map_operation::eval",
+                "the map primitive requires exactly two operands");
+        }
+
+        if (!valid(operands[1]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "map_operation::eval",
+                "the map primitive requires that the arguments given by the "
+                    "operands array are valid");
+        }
+
+        // the function is not evaluated here, it is invoked for each of the
+        // list elements instead
+        auto f = std::make_shared<detail::parallel_map>(
+            operands[0], "map_operation::eval");
+
+        return list_operand(operands[1], params).then(hpx::util::unwrapping(
+            [f](std::vector<primitive_argument_type>&& elements)
+            {
+                return f->map(std::move(elements));
+            }));
+    }
+}}}
@@ -11,11 +11,15 @@
 
 #include <hpx/include/components.hpp>
 #include <hpx/include/lcos.hpp>
+#include <hpx/include/local_lcos.hpp>
 #include <hpx/include/util.hpp>
 
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <random>
 #include <utility>
 #include <vector>
 
@@ -44,6 +48,81 @@ namespace phylanx { namespace execution_tree { namespace primitives
       : base_primitive(std::move(operands))
     {}
 
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        using mutex_type = hpx::lcos::local::spinlock;
+
+        // all values of a request are drawn while holding the lock, which
+        // keeps them independent of concurrent requests
+        struct random_generator
+        {
+            mutex_type mtx_;
+            std::mt19937 engine_;
+        };
+
+        random_generator& get_random_generator()
+        {
+            static random_generator gen;
+            return gen;
+        }
+
+        // the lock of the generator has to be held by the caller
+        template <typename Iterator>
+        void generate_random(random_generator& gen, Iterator first,
+            Iterator last, double min, double max)
+        {
+            std::uniform_real_distribution<double> dist(min, max);
+            for (/**/; first != last; ++first)
+            {
+                *first = dist(gen.engine_);
+            }
+        }
+    }
+
+    void set_random_seed(std::uint32_t seed)
+    {
+        detail::random_generator& gen = detail::get_random_generator();
+        std::lock_guard<detail::mutex_type> l(gen.mtx_);
+        gen.engine_.seed(seed);
+    }
+
+    double random_scalar(double min, double max)
+    {
+        double result = 0.0;
+
+        detail::random_generator& gen = detail::get_random_generator();
+        std::lock_guard<detail::mutex_type> l(gen.mtx_);
+        detail::generate_random(gen, &result, &result + 1, min, max);
+        return result;
+    }
+
+    blaze::DynamicVector<double> random_vector(
+        std::size_t size, double min, double max)
+    {
+        blaze::DynamicVector<double> result(size);
+
+        detail::random_generator& gen = detail::get_random_generator();
+        std::lock_guard<detail::mutex_type> l(gen.mtx_);
+        detail::generate_random(gen, result.begin(), result.end(), min, max);
+        return result;
+    }
+
+    blaze::DynamicMatrix<double> random_matrix(
+        std::size_t rows, std::size_t columns, double min, double max)
+    {
+        blaze::DynamicMatrix<double> result(rows, columns);
+
+        detail::random_generator& gen = detail::get_random_generator();
+        std::lock_guard<detail::mutex_type> l(gen.mtx_);
+        for (std::size_t i = 0; i != rows; ++i)
+        {
+            detail::generate_random(
+                gen, result.begin(i), result.end(i), min, max);
+        }
+        return result;
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     namespace detail
     {
@@ -109,26 +188,19 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
             primitive_result_type random0d(operands_type && ops) const
             {
-                blaze::Rand<double> gen{};
-                return operand_type{gen.generate()};
+                return operand_type{random_scalar()};
             }
 
             primitive_result_type random1d(operands_type && ops) const
             {
                 std::size_t dim = ops[0].dimension(0);
-
-                blaze::Rand<blaze::DynamicVector<double>> gen{};
-
-                return operand_type{gen.generate(dim)};
+                return operand_type{random_vector(dim)};
             }
 
             primitive_result_type random2d(operands_type && ops) const
             {
                 auto dim = ops[0].dimensions();
-
-                blaze::Rand<blaze::DynamicMatrix<double>> gen{};
-
-                return operand_type{gen.generate(dim[0], dim[1])};
+                return operand_type{random_matrix(dim[0], dim[1])};
             }
         };
     }
@@ -0,0 +1,330 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/random.hpp>
+#include <phylanx/execution_tree/primitives/randomized_svd.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/serialization/blaze.hpp>
+
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/util.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+typedef hpx::components::component<
+    phylanx::execution_tree::primitives::randomized_svd>
+    randomized_svd_type;
+HPX_REGISTER_DERIVED_COMPONENT_FACTORY(randomized_svd_type,
+    phylanx_randomized_svd_component, "phylanx_primitive_component",
+    hpx::components::factory_enabled)
+HPX_DEFINE_GET_COMPONENT_TYPE(randomized_svd_type::wrapped_type)
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<match_pattern_type> const randomized_svd::match_data =
+    {
+        hpx::util::make_tuple("randomized_svd4",
+            "randomized_svd(_1, _2, _3, _4)", &create<randomized_svd>),
+        hpx::util::make_tuple("randomized_svd3",
+            "randomized_svd(_1, _2, _3)", &create<randomized_svd>),
+        hpx::util::make_tuple("randomized_svd2",
+            "randomized_svd(_1, _2)", &create<randomized_svd>)
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    randomized_svd::randomized_svd(
+            std::vector<primitive_argument_type>&& operands)
+      : base_primitive(std::move(operands))
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        struct randomized_svd : std::enable_shared_from_this<randomized_svd>
+        {
+            randomized_svd() = default;
+
+        protected:
+            using operand_type = ir::node_data<double>;
+
+            using vector_type = blaze::DynamicVector<double>;
+            using matrix_type = blaze::DynamicMatrix<double>;
+
+            static constexpr std::int64_t default_oversample = 10;
+            static constexpr std::int64_t default_power_iters = 2;
+            static constexpr std::size_t max_jacobi_sweeps = 60;
+
+            // Orthonormalize the rows of 'q' in place (modified Gram-Schmidt,
+            // applied twice for numerical stability). The basis vectors are
+            // kept as rows to have them stored contiguously. Rows which turn
+            // out to be linearly dependent are set to zero.
+            static void orthonormalize_rows(matrix_type& q)
+            {
+                for (std::size_t pass = 0; pass != 2; ++pass)
+                {
+                    for (std::size_t i = 0; i != q.rows(); ++i)
+                    {
+                        auto qi = blaze::row(q, i);
+                        for (std::size_t j = 0; j != i; ++j)
+                        {
+                            auto qj = blaze::row(q, j);
+                            qi -= blaze::dot(qi, qj) * qj;
+                        }
+
+                        double norm = std::sqrt(blaze::dot(qi, qi));
+                        if (norm > std::numeric_limits<double>::epsilon())
+                        {
+                            qi /= norm;
+                        }
+                        else
+                        {
+                            qi = 0.0;
+                        }
+                    }
+                }
+            }
+
+            // One-sided Jacobi SVD of the small (l x n) matrix b: the rows of
+            // b are rotated until they are mutually orthogonal. On return the
+            // rows of b hold sigma_i * v_i and the rows of ut hold the left
+            // singular vectors u_i.
+            static void jacobi_svd(matrix_type& b, matrix_type& ut)
+            {
+                std::size_t const l = b.rows();
+                ut = matrix_type(l, l, 0.0);
+                for (std::size_t i = 0; i != l; ++i)
+                {
+                    ut(i, i) = 1.0;
+                }
+
+                double const tolerance =
+                    std::numeric_limits<double>::epsilon() * b.columns();
+
+                for (std::size_t sweep = 0; sweep != max_jacobi_sweeps; ++sweep)
+                {
+                    bool rotated = false;
+                    for (std::size_t p = 0; p + 1 < l; ++p)
+                    {
+                        for (std::size_t q = p + 1; q != l; ++q)
+                        {
+                            auto bp = blaze::row(b, p);
+                            auto bq = blaze::row(b, q);
+
+                            double alpha = blaze::dot(bp, bp);
+                            double beta = blaze::dot(bq, bq);
+                            double gamma = blaze::dot(bp, bq);
+
+                            if (std::abs(gamma) <=
+                                tolerance * std::sqrt(alpha * beta))
+                            {
+                                continue;
+                            }
+                            rotated = true;
+
+                            double zeta = (beta - alpha) / (2.0 * gamma);
+                            double t = (zeta >= 0.0 ? 1.0 : -1.0) /
+                                (std::abs(zeta) + std::sqrt(1.0 + zeta * zeta));
+                            double c = 1.0 / std::sqrt(1.0 + t * t);
+                            double s = c * t;
+
+                            vector_type tmp = blaze::trans(bp);
+                            bp = c * bp - s * bq;
+                            bq = s * blaze::trans(tmp) + c * bq;
+
+                            auto up = blaze::row(ut, p);
+                            auto uq = blaze::row(ut, q);
+                            tmp = blaze::trans(up);
+                            up = c * up - s * uq;
+                            uq = s * blaze::trans(tmp) + c * uq;
+                        }
+                    }
+
+                    if (!rotated)
+                    {
+                        break;
+                    }
+                }
+            }
+
+            static primitive_result_type approximate(matrix_type const& a,
+                std::size_t k, std::size_t oversample, std::size_t power_iters)
+            {
+                std::size_t const l =
+                    (std::min)(k + oversample, (std::min)(a.rows(), a.columns()));
+
+                // sample the range of a: Yt = (A * Omega)^T = Omega^T * A^T
+                matrix_type qt = random_matrix(l, a.columns(), -1.0, 1.0);
+                qt = qt * blaze::trans(a);
+                orthonormalize_rows(qt);
+
+                // power iterations sharpen the spectrum of the sampled range
+                for (std::size_t i = 0; i != power_iters; ++i)
+                {
+                    matrix_type zt = qt * a;
+                    orthonormalize_rows(zt);
+                    qt = zt * blaze::trans(a);
+                    orthonormalize_rows(qt);
+                }
+
+                // project a onto the sampled range and decompose the small
+                // (l x n) matrix B = Q^T * A
+                matrix_type b = qt * a;
+                matrix_type ut;
+                jacobi_svd(b, ut);
+
+                // sort the singular triplets by descending singular values
+                vector_type sigma(l);
+                for (std::size_t i = 0; i != l; ++i)
+                {
+                    auto bi = blaze::row(b, i);
+                    sigma[i] = std::sqrt(blaze::dot(bi, bi));
+                }
+
+                std::vector<std::size_t> order(l);
+                std::iota(order.begin(), order.end(), std::size_t(0));
+                std::sort(order.begin(), order.end(),
+                    [&](std::size_t lhs, std::size_t rhs)
+                    {
+                        return sigma[lhs] > sigma[rhs];
+                    });
+
+                vector_type s(k);
+                matrix_type vt(k, a.columns());
+                matrix_type u_small(k, l);
+                for (std::size_t i = 0; i != k; ++i)
+                {
+                    std::size_t idx = order[i];
+                    s[i] = sigma[idx];
+                    blaze::row(u_small, i) = blaze::row(ut, idx);
+                    if (s[i] > 0.0)
+                    {
+                        blaze::row(vt, i) = blaze::row(b, idx) / s[i];
+                    }
+                    else
+                    {
+                        blaze::row(vt, i) = 0.0;
+                    }
+                }
+
+                // U = Q * U_small
+                matrix_type u = blaze::trans(qt) * blaze::trans(u_small);
+
+                return primitive_result_type{
+                    std::vector<primitive_argument_type>{
+                        operand_type{std::move(u)},
+                        operand_type{std::move(s)},
+                        operand_type{std::move(vt)}
+                    }};
+            }
+
+            static std::size_t extract_count(primitive_argument_type const& op,
+                std::int64_t min_value, char const* name)
+            {
+                std::int64_t value = extract_integer_value(op);
+                if (value < min_value)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "randomized_svd::eval", name);
+                }
+                return static_cast<std::size_t>(value);
+            }
+
+        public:
+            hpx::future<primitive_result_type> eval(
+                std::vector<primitive_argument_type> const& operands,
+                std::vector<primitive_argument_type> const& args)
+            {
+                if (operands.size() < 2 || operands.size() > 4)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "randomized_svd::eval",
+                        "the randomized_svd primitive requires between two "
+                            "and four operands");
+                }
+
+                for (auto const& op : operands)
+                {
+                    if (!valid(op))
+                    {
+                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "randomized_svd::eval",
+                            "the randomized_svd primitive requires that the "
+                                "arguments given by the operands array are "
+                                "valid");
+                    }
+                }
+
+                return hpx::dataflow(hpx::util::unwrapping(
+                    [](std::vector<primitive_argument_type>&& ops)
+                    -> primitive_result_type
+                    {
+                        operand_type a = extract_numeric_value(ops[0]);
+                        if (a.num_dimensions() != 2)
+                        {
+                            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                                "randomized_svd::eval",
+                                "the first operand of randomized_svd must be "
+                                    "a matrix");
+                        }
+
+                        std::size_t k = extract_count(ops[1], 1,
+                            "the number of requested components must be "
+                                "positive");
+                        if (k > (std::min)(a.dimension(0), a.dimension(1)))
+                        {
+                            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                                "randomized_svd::eval",
+                                "the number of requested components exceeds "
+                                    "the rank of the matrix");
+                        }
+
+                        std::size_t oversample = ops.size() > 2 ?
+                            extract_count(ops[2], 0,
+                                "the oversampling must not be negative") :
+                            std::size_t(default_oversample);
+
+                        std::size_t power_iters = ops.size() > 3 ?
+                            extract_count(ops[3], 0,
+                                "the number of power iterations must not be "
+                                    "negative") :
+                            std::size_t(default_power_iters);
+
+                        return approximate(
+                            a.matrix(), k, oversample, power_iters);
+                    }),
+                    detail::map_operands(operands, literal_operand, args)
+                );
+            }
+        };
+    }
+
+    hpx::future<primitive_result_type> randomized_svd::eval(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        if (operands_.empty())
+        {
+            return std::make_shared<detail::randomized_svd>()->eval(
+                args, noargs);
+        }
+
+        return std::make_shared<detail::randomized_svd>()->eval(
+            operands_, args);
+    }
+}}}
@@ -0,0 +1,430 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/ranked_operation.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/serialization/blaze.hpp>
+
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+typedef hpx::components::component<
+    phylanx::execution_tree::primitives::ranked_operation>
+    ranked_operation_type;
+HPX_REGISTER_DERIVED_COMPONENT_FACTORY(
+    ranked_operation_type, phylanx_ranked_operation_component,
+    "phylanx_primitive_component", hpx::components::factory_enabled)
+HPX_DEFINE_GET_COMPONENT_TYPE(ranked_operation_type::wrapped_type)
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    namespace detail
+    {
+        using operand_type = ir::node_data<double>;
+        using kernel_type =
+            primitive_result_type (*)(operand_type&&, operand_type&&);
+
+        struct ranked_kernel_entry
+        {
+            char const* name;
+            std::size_t lhs_rank;
+            std::size_t rhs_rank;
+            kernel_type kernel;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        struct add_op
+        {
+            double operator()(double lhs, double rhs) const
+            {
+                return lhs + rhs;
+            }
+        };
+
+        struct sub_op
+        {
+            double operator()(double lhs, double rhs) const
+            {
+                return lhs - rhs;
+            }
+        };
+
+        struct mul_op
+        {
+            double operator()(double lhs, double rhs) const
+            {
+                return lhs * rhs;
+            }
+        };
+
+        struct div_op
+        {
+            double operator()(double lhs, double rhs) const
+            {
+                return lhs / rhs;
+            }
+        };
+
+        // dot() of two scalars multiplies those
+        struct dot_op : mul_op {};
+
+        [[noreturn]] void throw_dimensions_mismatch(char const* name)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                std::string("ranked_operation::") + name,
+                "the dimensions of the operands do not match");
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // The kernels are specialized on the operation and on the number of
+        // dimensions of both operands. The primary template is left
+        // undefined, only the combinations listed in ranked_kernels below
+        // are instantiated.
+        template <typename Op, std::size_t Lhs, std::size_t Rhs>
+        struct ranked_kernel;
+
+        // element-wise operations
+        template <typename Op>
+        struct ranked_kernel<Op, 0, 0>
+        {
+            static primitive_result_type call(
+                operand_type&& lhs, operand_type&& rhs)
+            {
+                lhs.scalar() = Op{}(lhs.scalar(), rhs.scalar());
+                return primitive_result_type(std::move(lhs));
+            }
+        };
+
+        template <typename Op>
+        struct ranked_kernel<Op, 0, 1>
+        {
+            static primitive_result_type call(
+                operand_type&& lhs, operand_type&& rhs)
+            {
+                double value = lhs.scalar();
+                rhs.vector() = blaze::map(rhs.vector(),
+                    [value](double x) { return Op{}(value, x); });
+                return primitive_result_type(std::move(rhs));
+            }
+        };
+
+        template <typename Op>
+        struct ranked_kernel<Op, 0, 2>
+        {
+            static primitive_result_type call(
+                operand_type&& lhs, operand_type&& rhs)
+            {
+                double value = lhs.scalar();
+                rhs.matrix() = blaze::map(rhs.matrix(),
+                    [value](double x) { return Op{}(value, x); });
+                return primitive_result_type(std::move(rhs));
+            }
+        };
+
+        template <typename Op>
+        struct ranked_kernel<Op, 1, 0>
+        {
+            static primitive_result_type call(
+                operand_type&& lhs, operand_type&& rhs)
+            {
+                double value = rhs.scalar();
+                lhs.vector() = blaze::map(lhs.vector(),
+                    [value](double x) { return Op{}(x, value); });
+                return primitive_result_type(std::move(lhs));
+            }
+        };
+
+        template <typename Op>
+        struct ranked_kernel<Op, 2, 0>
+        {
+            static primitive_result_type call(
+                operand_type&& lhs, operand_type&& rhs)
+            {
+                double value = rhs.scalar();
+                lhs.matrix() = blaze::map(lhs.matrix(),
+                    [value](double x) { return Op{}(x, value); });
+                return primitive_result_type(std::move(lhs));
+            }
+        };
+
+        template <typename Op>
+        struct ranked_kernel<Op, 1, 1>
+        {
+            static primitive_result_type call(
+                operand_type&& lhs, operand_type&& rhs)
+            {
+                if (lhs.size() != rhs.size())
+                {
+                    throw_dimensions_mismatch("ranked_kernel<1, 1>");
+                }
+
+                lhs.vector() = blaze::map(lhs.vector(), rhs.vector(), Op{});
+                return primitive_result_type(std::move(lhs));
+            }
+        };
+
+        template <typename Op>
+        struct ranked_kernel<Op, 2, 2>
+        {
+            static primitive_result_type call(
+                operand_type&& lhs, operand_type&& rhs)
+            {
+                if (lhs.dimensions() != rhs.dimensions())
+                {
+                    throw_dimensions_mismatch("ranked_kernel<2, 2>");
+                }
+
+                lhs.matrix() = blaze::map(lhs.matrix(), rhs.matrix(), Op{});
+                return primitive_result_type(std::move(lhs));
+            }
+        };
+
+        // vector/matrix products (mul and dot)
+        template <>
+        struct ranked_kernel<dot_op, 1, 1>
+        {
+            static primitive_result_type call(
+                operand_type&& lhs, operand_type&& rhs)
+            {
+                if (lhs.size() != rhs.size())
+                {
+                    throw_dimensions_mismatch("ranked_kernel<dot, 1, 1>");
+                }
+
+                lhs.scalar(blaze::dot(lhs.vector(), rhs.vector()));
+                return primitive_result_type(std::move(lhs));
+            }
+        };
+
+        template <typename Op>
+        struct ranked_kernel<Op, 1, 2>
+        {
+            static primitive_result_type call(
+                operand_type&& lhs, operand_type&& rhs)
+            {
+                if (lhs.size() != rhs.dimension(0))
+                {
+                    throw_dimensions_mismatch("ranked_kernel<1, 2>");
+                }
+
+                lhs.vector() =
+                    blaze::trans(blaze::trans(lhs.vector()) * rhs.matrix());
+                return primitive_result_type(std::move(lhs));
+            }
+        };
+
+        template <typename Op>
+        struct ranked_kernel<Op, 2, 1>
+        {
+            static primitive_result_type call(
+                operand_type&& lhs, operand_type&& rhs)
+            {
+                if (lhs.dimension(1) != rhs.size())
+                {
+                    throw_dimensions_mismatch("ranked_kernel<2, 1>");
+                }
+
+                rhs.vector() = lhs.matrix() * rhs.vector();
+                return primitive_result_type(std::move(rhs));
+            }
+        };
+
+        template <>
+        struct ranked_kernel<mul_op, 2, 2>
+        {
+            static primitive_result_type call(
+                operand_type&& lhs, operand_type&& rhs)
+            {
+                if (lhs.dimension(1) != rhs.dimension(0))
+                {
+                    throw_dimensions_mismatch("ranked_kernel<mul, 2, 2>");
+                }
+
+                lhs.matrix() *= rhs.matrix();
+                return primitive_result_type(std::move(lhs));
+            }
+        };
+
+        template <>
+        struct ranked_kernel<dot_op, 2, 2>
+          : ranked_kernel<mul_op, 2, 2>
+        {};
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Op, std::size_t Lhs, std::size_t Rhs>
+        ranked_kernel_entry kernel(char const* name)
+        {
+            return ranked_kernel_entry{
+                name, Lhs, Rhs, &ranked_kernel<Op, Lhs, Rhs>::call};
+        }
+
+        // all combinations of operand ranks supported by the generic
+        // primitives for two operands
+        ranked_kernel_entry const ranked_kernels[] =
+        {
+            kernel<add_op, 0, 0>("add"), kernel<add_op, 0, 1>("add"),
+            kernel<add_op, 0, 2>("add"), kernel<add_op, 1, 0>("add"),
+            kernel<add_op, 1, 1>("add"), kernel<add_op, 2, 0>("add"),
+            kernel<add_op, 2, 2>("add"),
+
+            kernel<sub_op, 0, 0>("sub"), kernel<sub_op, 0, 1>("sub"),
+            kernel<sub_op, 0, 2>("sub"), kernel<sub_op, 1, 0>("sub"),
+            kernel<sub_op, 1, 1>("sub"), kernel<sub_op, 2, 0>("sub"),
+            kernel<sub_op, 2, 2>("sub"),
+
+            kernel<mul_op, 0, 0>("mul"), kernel<mul_op, 0, 1>("mul"),
+            kernel<mul_op, 0, 2>("mul"), kernel<mul_op, 1, 0>("mul"),
+            kernel<mul_op, 1, 1>("mul"), kernel<mul_op, 1, 2>("mul"),
+            kernel<mul_op, 2, 0>("mul"), kernel<mul_op, 2, 1>("mul"),
+            kernel<mul_op, 2, 2>("mul"),
+
+            kernel<div_op, 0, 0>("div"), kernel<div_op, 0, 1>("div"),
+            kernel<div_op, 0, 2>("div"), kernel<div_op, 1, 0>("div"),
+            kernel<div_op, 1, 1>("div"), kernel<div_op, 2, 0>("div"),
+            kernel<div_op, 2, 2>("div"),
+
+            kernel<dot_op, 0, 0>("dot"), kernel<dot_op, 1, 1>("dot"),
+            kernel<dot_op, 1, 2>("dot"), kernel<dot_op, 2, 1>("dot"),
+            kernel<dot_op, 2, 2>("dot")
+        };
+
+        ranked_kernel_entry const* find_ranked_kernel(char const* name,
+            std::size_t lhs_rank, std::size_t rhs_rank)
+        {
+            for (auto const& entry : ranked_kernels)
+            {
+                if (entry.lhs_rank == lhs_rank && entry.rhs_rank == rhs_rank &&
+                    std::strcmp(entry.name, name) == 0)
+                {
+                    return &entry;
+                }
+            }
+            return nullptr;
+        }
+
+        // Invoke the kernel selected at compile time. Operands of other
+        // ranks (e.g. variables which were modified by later compilations
+        // sharing the same environment) are handled by looking up the
+        // matching kernel.
+        primitive_result_type invoke_ranked_kernel(
+            ranked_kernel_entry const& entry,
+            operand_type&& lhs, operand_type&& rhs)
+        {
+            if (lhs.num_dimensions() == entry.lhs_rank &&
+                rhs.num_dimensions() == entry.rhs_rank)
+            {
+                return entry.kernel(std::move(lhs), std::move(rhs));
+            }
+
+            ranked_kernel_entry const* other = find_ranked_kernel(
+                entry.name, lhs.num_dimensions(), rhs.num_dimensions());
+            if (other == nullptr)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "ranked_operation::eval",
+                    std::string("the operands of '") + entry.name +
+                        "' have incompatible number of dimensions");
+            }
+            return other->kernel(std::move(lhs), std::move(rhs));
+        }
+
+        void verify_ranked_operands(
+            std::vector<primitive_argument_type> const& operands)
+        {
+            if (operands.size() != 2)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "ranked_operation::eval",
+                    "the ranked_operation primitive requires exactly two "
+                        "operands");
+            }
+
+            if (!valid(operands[0]) || !valid(operands[1]))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "ranked_operation::eval",
+                    "the ranked_operation primitive requires that the "
+                        "arguments given by the operands array are valid");
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    ranked_operation::ranked_operation(
+            std::vector<primitive_argument_type>&& operands,
+            std::string const& name, std::size_t lhs_rank,
+            std::size_t rhs_rank)
+      : base_primitive(std::move(operands))
+      , kernel_(detail::find_ranked_kernel(name.c_str(), lhs_rank, rhs_rank))
+    {
+        if (kernel_ == nullptr)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "ranked_operation::ranked_operation",
+                "there is no kernel for '" + name + "' with operands of "
+                    "the given number of dimensions");
+        }
+    }
+
+    bool ranked_operation::is_supported(std::string const& name,
+        std::size_t lhs_rank, std::size_t rhs_rank)
+    {
+        return detail::find_ranked_kernel(
+            name.c_str(), lhs_rank, rhs_rank) != nullptr;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_result_type> ranked_operation::eval(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        std::vector<primitive_argument_type> const& operands =
+            operands_.empty() ? args : operands_;
+        std::vector<primitive_argument_type> const& params =
+            operands_.empty() ? noargs : args;
+
+        detail::verify_ranked_operands(operands);
+
+        detail::ranked_kernel_entry const* kernel = kernel_;
+        return detail::invoke_when_ready(
+            [kernel](std::vector<detail::operand_type>&& ops)
+            ->  primitive_result_type
+            {
+                return detail::invoke_ranked_kernel(
+                    *kernel, std::move(ops[0]), std::move(ops[1]));
+            },
+            detail::map_operands(operands, numeric_operand, params));
+    }
+
+    primitive_result_type ranked_operation::eval_direct(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        std::vector<primitive_argument_type> const& operands =
+            operands_.empty() ? args : operands_;
+        std::vector<primitive_argument_type> const& params =
+            operands_.empty() ? noargs : args;
+
+        detail::verify_ranked_operands(operands);
+
+        std::vector<detail::operand_type> ops =
+            detail::map_operands_concurrently(
+                operands, numeric_operand_sync, params);
+
+        return detail::invoke_ranked_kernel(
+            *kernel_, std::move(ops[0]), std::move(ops[1]));
+    }
+}}}
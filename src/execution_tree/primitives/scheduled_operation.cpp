@@ -0,0 +1,197 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/scheduled_operation.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/thread_executors.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+typedef hpx::components::component<
+    phylanx::execution_tree::primitives::scheduled_operation>
+    scheduled_operation_type;
+HPX_REGISTER_DERIVED_COMPONENT_FACTORY(scheduled_operation_type,
+    phylanx_scheduled_operation_component, "phylanx_primitive_component",
+    hpx::components::factory_enabled)
+HPX_DEFINE_GET_COMPONENT_TYPE(scheduled_operation_type::wrapped_type)
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<match_pattern_type> const scheduled_operation::match_data =
+    {
+        hpx::util::make_tuple("schedule", "schedule(__1)",
+            &create<scheduled_operation>)
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // the scheduling hints have to be given as string literals, an
+        // empty string selects the default
+        std::string const& scheduling_hint(
+            primitive_argument_type const& operand, char const* hint)
+        {
+            std::string const* value = util::get_if<std::string>(&operand);
+            if (value == nullptr)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::primitives::"
+                        "scheduled_operation::scheduled_operation",
+                    std::string("the ") + hint + " given to the schedule "
+                        "primitive must be a string literal");
+            }
+            return *value;
+        }
+
+        hpx::threads::thread_priority priority_hint(
+            primitive_argument_type const& operand)
+        {
+            std::string const& hint = scheduling_hint(operand, "priority");
+            if (hint.empty() || hint == "default")
+            {
+                return hpx::threads::thread_priority_default;
+            }
+            if (hint == "low")
+            {
+                return hpx::threads::thread_priority_low;
+            }
+            if (hint == "normal")
+            {
+                return hpx::threads::thread_priority_normal;
+            }
+            if (hint == "high")
+            {
+                return hpx::threads::thread_priority_high;
+            }
+            if (hint == "boost")
+            {
+                return hpx::threads::thread_priority_boost;
+            }
+
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "phylanx::execution_tree::primitives::"
+                    "scheduled_operation::scheduled_operation",
+                "unknown thread priority: " + hint);
+        }
+
+        std::string pool_hint(primitive_argument_type const& operand)
+        {
+            std::string const& hint = scheduling_hint(operand, "thread pool");
+            return hint.empty() ? std::string("default") : hint;
+        }
+
+        hpx::threads::thread_stacksize stacksize_hint(
+            primitive_argument_type const& operand)
+        {
+            std::string const& hint = scheduling_hint(operand, "stack size");
+            if (hint.empty() || hint == "default")
+            {
+                return hpx::threads::thread_stacksize_default;
+            }
+            if (hint == "small")
+            {
+                return hpx::threads::thread_stacksize_small;
+            }
+            if (hint == "medium")
+            {
+                return hpx::threads::thread_stacksize_medium;
+            }
+            if (hint == "large")
+            {
+                return hpx::threads::thread_stacksize_large;
+            }
+            if (hint == "huge")
+            {
+                return hpx::threads::thread_stacksize_huge;
+            }
+
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "phylanx::execution_tree::primitives::"
+                    "scheduled_operation::scheduled_operation",
+                "unknown thread stack size: " + hint);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    scheduled_operation::scheduled_operation(
+            std::vector<primitive_argument_type>&& operands)
+      : base_primitive(std::move(operands))
+    {
+        if (operands_.empty() || operands_.size() > 4)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "phylanx::execution_tree::primitives::"
+                    "scheduled_operation::scheduled_operation",
+                "the schedule primitive requires between one and four "
+                    "operands");
+        }
+
+        if (!valid(operands_[0]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "phylanx::execution_tree::primitives::"
+                    "scheduled_operation::scheduled_operation",
+                "the schedule primitive requires that the expression to "
+                    "evaluate is valid");
+        }
+
+        if (operands_.size() > 1)
+        {
+            priority_ = detail::priority_hint(operands_[1]);
+        }
+        if (operands_.size() > 2)
+        {
+            pool_ = detail::pool_hint(operands_[2]);
+        }
+        if (operands_.size() > 3)
+        {
+            stacksize_ = detail::stacksize_hint(operands_[3]);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // the expression is evaluated directly on a new thread created with the
+    // given hints (evaluating it asynchronously would create yet another
+    // thread using the default hints), nested asynchronous operations are
+    // scheduled from there
+    hpx::future<primitive_result_type> scheduled_operation::eval(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        hpx::threads::executors::pool_executor exec(
+            pool_, priority_, stacksize_);
+
+        primitive_argument_type const& expr = operands_[0];
+        return hpx::async(exec,
+            [expr, args]() -> primitive_result_type
+            {
+                return value_operand_sync(expr, args);
+            });
+    }
+
+    primitive_result_type scheduled_operation::eval_direct(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        hpx::threads::executors::pool_executor exec(
+            pool_, priority_, stacksize_);
+
+        return hpx::async(exec,
+            [&]() -> primitive_result_type
+            {
+                return value_operand_sync(operands_[0], args);
+            }).get();
+    }
+}}}
@@ -45,6 +45,36 @@ namespace phylanx { namespace execution_tree { namespace primitives
     ///////////////////////////////////////////////////////////////////////////
     namespace detail
     {
+        void verify_store_operands(
+            std::vector<primitive_argument_type> const& operands)
+        {
+            if (operands.size() != 2)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "store_operation::eval",
+                    "the store_operation primitive requires exactly two "
+                        "operands");
+
+                if (!valid(operands[0]) || !valid(operands[1]))
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "store_operation::store_operation",
+                        "the store_operation primitive requires that the "
+                            "arguments given by the operands array is "
+                            "valid");
+                }
+
+                if (!is_primitive_operand(operands[0]))
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "store_operation::store_operation",
+                        "the first argument of the store primitive must "
+                            "refer to a another primitive and can't be a "
+                            "literal value");
+                }
+            }
+        }
+
         struct store : std::enable_shared_from_this<store>
         {
             store(std::vector<primitive_argument_type> const& operands,
@@ -52,31 +82,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
               : operands_(operands)
               , args_(args)
             {
-                if (operands_.size() != 2)
-                {
-                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                        "store_operation::eval",
-                        "the store_operation primitive requires exactly two "
-                            "operands");
-
-                    if (!valid(operands_[0]) || !valid(operands_[1]))
-                    {
-                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                            "store_operation::store_operation",
-                            "the store_operation primitive requires that the "
-                                "arguments given by the operands array is "
-                                "valid");
-                    }
-
-                    if (!is_primitive_operand(operands_[0]))
-                    {
-                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                            "store_operation::store_operation",
-                            "the first argument of the store primitive must "
-                                "refer to a another primitive and can't be a "
-                                "literal value");
-                    }
-                }
+                verify_store_operands(operands_);
             }
 
             hpx::future<primitive_result_type> eval()
@@ -108,5 +114,19 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         return std::make_shared<detail::store>(operands_, args)->eval();
     }
-}}}
 
+    primitive_result_type store_operation::eval_direct(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        std::vector<primitive_argument_type> const& operands =
+            operands_.empty() ? args : operands_;
+        std::vector<primitive_argument_type> const& params =
+            operands_.empty() ? noargs : args;
+
+        detail::verify_store_operands(operands);
+
+        primitive_result_type val = literal_operand_sync(operands[1], params);
+        primitive_operand(operands[0]).store(hpx::launch::sync, val);
+        return val;
+    }
+}}}
@@ -74,10 +74,29 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 return primitive_result_type(std::move(ops[0]));
             }
 
-        public:
-            hpx::future<primitive_result_type> eval(
-                std::vector<primitive_argument_type> const& operands,
-                std::vector<primitive_argument_type> const& args) const
+            primitive_result_type neg_all(operands_type && ops) const
+            {
+                std::size_t lhs_dims = ops[0].num_dimensions();
+                switch (lhs_dims)
+                {
+                case 0:
+                    return neg0d(std::move(ops));
+
+                case 1:
+                    return neg1d(std::move(ops));
+
+                case 2:
+                    return neg2d(std::move(ops));
+
+                default:
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "unary_minus_operation::eval",
+                        "operand has unsupported number of dimensions");
+                }
+            }
+
+            void verify_operands(
+                std::vector<primitive_argument_type> const& operands) const
             {
                 if (operands.size() != 1)
                 {
@@ -94,31 +113,32 @@ namespace phylanx { namespace execution_tree { namespace primitives
                         "the unary_minus_operation primitive requires that the "
                             "argument given by the operands array is valid");
                 }
+            }
+
+        public:
+            hpx::future<primitive_result_type> eval(
+                std::vector<primitive_argument_type> const& operands,
+                std::vector<primitive_argument_type> const& args) const
+            {
+                verify_operands(operands);
 
                 auto this_ = this->shared_from_this();
-                return hpx::dataflow(hpx::util::unwrapping(
+                return detail::invoke_when_ready(
                     [this_](operands_type && ops) -> primitive_result_type
                     {
-                        std::size_t lhs_dims = ops[0].num_dimensions();
-                        switch (lhs_dims)
-                        {
-                        case 0:
-                            return this_->neg0d(std::move(ops));
-
-                        case 1:
-                            return this_->neg1d(std::move(ops));
-
-                        case 2:
-                            return this_->neg2d(std::move(ops));
-
-                        default:
-                            HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                                "unary_minus_operation::eval",
-                                "operand has unsupported number of dimensions");
-                        }
-                    }),
-                    detail::map_operands(operands, numeric_operand, args)
-                );
+                        return this_->neg_all(std::move(ops));
+                    },
+                    detail::map_operands(operands, numeric_operand, args));
+            }
+
+            primitive_result_type eval_direct(
+                std::vector<primitive_argument_type> const& operands,
+                std::vector<primitive_argument_type> const& args) const
+            {
+                verify_operands(operands);
+
+                return neg_all(detail::map_operands(
+                    operands, numeric_operand_sync, args));
             }
         };
     }
@@ -134,4 +154,15 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         return std::make_shared<detail::unary_minus>()->eval(operands_, args);
     }
+
+    primitive_result_type unary_minus_operation::eval_direct(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        if (operands_.empty())
+        {
+            return detail::unary_minus{}.eval_direct(args, noargs);
+        }
+
+        return detail::unary_minus{}.eval_direct(operands_, args);
+    }
 }}}
@@ -52,10 +52,13 @@ namespace phylanx { namespace execution_tree { namespace primitives
         private:
             using operands_type = std::vector<std::uint8_t>;
 
-        public:
-            hpx::future<primitive_result_type> eval(
-                std::vector<primitive_argument_type> const& operands,
-                std::vector<primitive_argument_type> const& args) const
+            primitive_result_type invert(operands_type && ops) const
+            {
+                return primitive_result_type(ops[0] == 0);
+            }
+
+            void verify_operands(
+                std::vector<primitive_argument_type> const& operands) const
             {
                 if (operands.size() != 1)
                 {
@@ -72,15 +75,32 @@ namespace phylanx { namespace execution_tree { namespace primitives
                         "the unary_not_operation primitive requires that the "
                             "argument given by the operands array is valid");
                 }
+            }
+
+        public:
+            hpx::future<primitive_result_type> eval(
+                std::vector<primitive_argument_type> const& operands,
+                std::vector<primitive_argument_type> const& args) const
+            {
+                verify_operands(operands);
 
                 auto this_ = this->shared_from_this();
-                return hpx::dataflow(hpx::util::unwrapping(
+                return detail::invoke_when_ready(
                     [this_](operands_type && ops) -> primitive_result_type
                     {
-                        return primitive_result_type(ops[0] == 0);
-                    }),
-                    detail::map_operands(operands, boolean_operand, args)
-                );
+                        return this_->invert(std::move(ops));
+                    },
+                    detail::map_operands(operands, boolean_operand, args));
+            }
+
+            primitive_result_type eval_direct(
+                std::vector<primitive_argument_type> const& operands,
+                std::vector<primitive_argument_type> const& args) const
+            {
+                verify_operands(operands);
+
+                return invert(detail::map_operands(
+                    operands, boolean_operand_sync, args));
             }
         };
     }
@@ -96,4 +116,15 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         return std::make_shared<detail::unary_not>()->eval(operands_, args);
     }
+
+    primitive_result_type unary_not_operation::eval_direct(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        if (operands_.empty())
+        {
+            return detail::unary_not{}.eval_direct(args, noargs);
+        }
+
+        return detail::unary_not{}.eval_direct(operands_, args);
+    }
 }}}
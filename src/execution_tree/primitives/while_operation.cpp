@@ -43,6 +43,28 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
     namespace detail
     {
+        void verify_while_operands(
+            std::vector<primitive_argument_type> const& operands)
+        {
+            if (operands.size() != 2)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::primitives::while_operation::"
+                        "while_operation",
+                    "the while_operation primitive requires exactly two "
+                        "arguments");
+            }
+
+            if (!valid(operands[0]) || !valid(operands[1]))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::primitives::while_operation::"
+                        "while_operation",
+                    "the while_operation primitive requires that the "
+                        "arguments  by the operands array are valid");
+            }
+        }
+
         struct iteration : std::enable_shared_from_this<iteration>
         {
             iteration(std::vector<primitive_argument_type> const& operands,
@@ -50,62 +72,78 @@ namespace phylanx { namespace execution_tree { namespace primitives
               : operands_(operands)
               , args_(args)
             {
-                if (operands_.size() != 2)
-                {
-                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                        "phylanx::execution_tree::primitives::while_operation::"
-                            "while_operation",
-                        "the while_operation primitive requires exactly two "
-                            "arguments");
-                }
+                verify_while_operands(operands_);
+            }
 
-                if (!valid(operands_[0]) || !valid(operands_[1]))
+            // Run as many iterations as possible in place. Only if either the
+            // condition or the body is not available yet do we attach a
+            // continuation and resume the loop once the value has been
+            // computed.
+            hpx::future<primitive_result_type> loop()
+            {
+                while (true)
                 {
-                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                        "phylanx::execution_tree::primitives::while_operation::"
-                            "while_operation",
-                        "the while_operation primitive requires that the "
-                            "arguments  by the operands array are valid");
+                    // evaluate condition of while statement
+                    hpx::future<primitive_result_type> cond =
+                        literal_operand(operands_[0], args_);
+                    if (!cond.is_ready())
+                    {
+                        auto this_ = this->shared_from_this();
+                        return cond.then(
+                            [this_](hpx::future<primitive_result_type> && cond)
+                            {
+                                return this_->body(std::move(cond));
+                            });
+                    }
+
+                    if (!extract_boolean_value(cond.get()))
+                    {
+                        return hpx::make_ready_future(std::move(result_));
+                    }
+
+                    // evaluate body of while statement
+                    hpx::future<primitive_result_type> body =
+                        literal_operand(operands_[1], args_);
+                    if (!body.is_ready())
+                    {
+                        return resume(std::move(body));
+                    }
+                    result_ = body.get();
                 }
             }
 
+        private:
             hpx::future<primitive_result_type> body(
                 hpx::future<primitive_result_type>&& cond)
             {
                 if (extract_boolean_value(cond.get()))
                 {
-                    // evaluate body of while statement
-                    auto this_ = this->shared_from_this();
-                    return literal_operand(operands_[1], args_).then(
-                        [this_](
-                            hpx::future<primitive_result_type> && result
-                        ) mutable
-                        {
-                            this_->result_ = result.get();
-                            return this_->loop();
-                        });
+                    hpx::future<primitive_result_type> body =
+                        literal_operand(operands_[1], args_);
+                    if (!body.is_ready())
+                    {
+                        return resume(std::move(body));
+                    }
+                    result_ = body.get();
+                    return loop();
                 }
-
-                hpx::future<primitive_result_type> f = p_.get_future();
-                p_.set_value(std::move(result_));
-                return f;
+                return hpx::make_ready_future(std::move(result_));
             }
 
-            hpx::future<primitive_result_type> loop()
+            hpx::future<primitive_result_type> resume(
+                hpx::future<primitive_result_type>&& body)
             {
-                // evaluate condition of while statement
                 auto this_ = this->shared_from_this();
-                return literal_operand(operands_[0], args_).then(
-                    [this_](hpx::future<primitive_result_type> && cond)
+                return body.then(
+                    [this_](hpx::future<primitive_result_type> && result)
                     {
-                        return this_->body(std::move(cond));
+                        this_->result_ = result.get();
+                        return this_->loop();
                     });
             }
 
-        private:
             std::vector<primitive_argument_type> operands_;
             std::vector<primitive_argument_type> args_;
-            hpx::promise<primitive_result_type> p_;
             primitive_result_type result_;
         };
     }
@@ -121,4 +159,22 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         return std::make_shared<detail::iteration>(operands_, args)->loop();
     }
+
+    primitive_result_type while_operation::eval_direct(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        std::vector<primitive_argument_type> const& operands =
+            operands_.empty() ? args : operands_;
+        std::vector<primitive_argument_type> const& params =
+            operands_.empty() ? noargs : args;
+
+        detail::verify_while_operands(operands);
+
+        primitive_result_type result;
+        while (extract_boolean_value(literal_operand_sync(operands[0], params)))
+        {
+            result = literal_operand_sync(operands[1], params);
+        }
+        return result;
+    }
 }}}
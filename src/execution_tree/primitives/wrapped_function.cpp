@@ -9,6 +9,7 @@
 #include <hpx/include/components.hpp>
 #include <hpx/include/lcos.hpp>
 
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -74,6 +75,23 @@ namespace phylanx { namespace execution_tree { namespace primitives
         return value_operand(target_, params);
     }
 
+    primitive_result_type wrapped_function::eval_direct(
+        std::vector<primitive_argument_type> const& params) const
+    {
+        if (!args_.empty())
+        {
+            std::vector<primitive_result_type> fargs;
+            fargs.reserve(args_.size());
+            for (auto const& arg : args_)
+            {
+                fargs.push_back(value_operand_sync(arg, params));
+            }
+            return value_operand_sync(target_, std::move(fargs));
+        }
+
+        return value_operand_sync(target_, params);
+    }
+
     void wrapped_function::set_target(primitive_argument_type target)
     {
         target_ = std::move(target);
@@ -114,6 +132,13 @@ namespace phylanx { namespace execution_tree
     hpx::future<void> wrapped_function::set_target(
         primitive_argument_type&& target)
     {
+        if (is_local())
+        {
+            std::static_pointer_cast<primitives::wrapped_function>(local())
+                ->set_target(std::move(target));
+            return hpx::make_ready_future();
+        }
+
         using action_type =
             primitives::wrapped_function::set_target_direct_action;
         return hpx::async(
@@ -123,6 +148,13 @@ namespace phylanx { namespace execution_tree
     void wrapped_function::set_target(hpx::launch::sync_policy,
         primitive_argument_type&& target)
     {
+        if (is_local())
+        {
+            std::static_pointer_cast<primitives::wrapped_function>(local())
+                ->set_target(std::move(target));
+            return;
+        }
+
         using action_type =
             primitives::wrapped_function::set_target_direct_action;
         action_type()(this->primitive::get_id(), std::move(target));
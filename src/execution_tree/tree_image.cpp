@@ -0,0 +1,727 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/generate_ast.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/execution_tree/compile.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/define_function.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/arena.hpp>
+
+#include <hpx/include/local_lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/serialization.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Remembers all primitives created while compiling an expression
+        class tree_recorder
+        {
+        public:
+            struct node
+            {
+                std::size_t sequence;
+                primitive p;
+                std::unique_ptr<primitive_recipe> recipe;
+                std::vector<primitive_argument_type> bodies;
+            };
+
+            void record(primitive const& p,
+                std::unique_ptr<primitive_recipe> && recipe)
+            {
+                node& n = nodes_[identity(p)];
+                n.sequence = sequence_++;
+                n.p = p;
+                n.recipe = std::move(recipe);
+            }
+
+            void record_body(primitive const& p,
+                primitive_argument_type const& body)
+            {
+                find(p).bodies.push_back(body);
+            }
+
+            node& find(primitive const& p)
+            {
+                auto it = nodes_.find(identity(p));
+                if (it == nodes_.end())
+                {
+                    HPX_THROW_EXCEPTION(hpx::invalid_status,
+                        "phylanx::execution_tree::detail::tree_recorder",
+                        "the given primitive was not created while compiling "
+                        "the expression to store");
+                }
+                return it->second;
+            }
+
+            static primitives::base_primitive const* identity(
+                primitive const& p)
+            {
+                if (!p.is_local())
+                {
+                    HPX_THROW_EXCEPTION(hpx::invalid_status,
+                        "phylanx::execution_tree::detail::tree_recorder",
+                        "only execution trees consisting of local primitives "
+                        "can be stored");
+                }
+                return p.local().get();
+            }
+
+        private:
+            std::size_t sequence_ = 0;
+            std::map<primitives::base_primitive const*, node> nodes_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // The active recorders are bound to the HPX thread running the
+        // compilation. That thread may be suspended (e.g. while evaluating
+        // constant expressions) and resumed on a different OS thread, an OS
+        // thread local variable would therefore refer to the wrong recorder.
+        // Code which is not run on an HPX thread can't be migrated and uses
+        // an OS thread local variable instead.
+        class tree_recorder_registry
+        {
+        public:
+            tree_recorder* current()
+            {
+                if (num_active_.load() == 0)
+                {
+                    return nullptr;
+                }
+
+                if (hpx::threads::get_self_ptr() == nullptr)
+                {
+                    return os_thread_recorder();
+                }
+
+                std::lock_guard<mutex_type> l(mtx_);
+                auto it = recorders_.find(hpx::threads::get_self_id());
+                return it != recorders_.end() ? it->second : nullptr;
+            }
+
+            // install the given recorder for the current thread, return the
+            // previously installed one
+            tree_recorder* exchange(tree_recorder* recorder)
+            {
+                tree_recorder* previous = nullptr;
+                if (hpx::threads::get_self_ptr() == nullptr)
+                {
+                    previous = os_thread_recorder();
+                    os_thread_recorder() = recorder;
+                }
+                else
+                {
+                    std::lock_guard<mutex_type> l(mtx_);
+                    auto id = hpx::threads::get_self_id();
+                    auto it = recorders_.find(id);
+                    if (it != recorders_.end())
+                    {
+                        previous = it->second;
+                        recorders_.erase(it);
+                    }
+                    if (recorder != nullptr)
+                    {
+                        recorders_.emplace(id, recorder);
+                    }
+                }
+
+                if (previous == nullptr && recorder != nullptr)
+                {
+                    ++num_active_;
+                }
+                else if (previous != nullptr && recorder == nullptr)
+                {
+                    --num_active_;
+                }
+                return previous;
+            }
+
+        private:
+            using mutex_type = hpx::lcos::local::spinlock;
+
+            static tree_recorder*& os_thread_recorder()
+            {
+                static thread_local tree_recorder* recorder = nullptr;
+                return recorder;
+            }
+
+            std::atomic<std::size_t> num_active_{0};
+            mutex_type mtx_;
+            std::map<hpx::threads::thread_id_type, tree_recorder*> recorders_;
+        };
+
+        tree_recorder_registry& get_tree_recorder_registry()
+        {
+            static tree_recorder_registry registry;
+            return registry;
+        }
+
+        tree_recorder* current_recorder()
+        {
+            return get_tree_recorder_registry().current();
+        }
+
+        tree_recorder* current_tree_recorder()
+        {
+            return current_recorder();
+        }
+
+        void record_primitive(tree_recorder& recorder, primitive const& p,
+            std::unique_ptr<primitive_recipe> && recipe)
+        {
+            recorder.record(p, std::move(recipe));
+        }
+
+        void record_function_body(
+            primitive const& p, primitive_argument_type const& body)
+        {
+            if (tree_recorder* recorder = current_recorder())
+            {
+                recorder->record_body(p, body);
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        std::unordered_map<std::string, primitive_loader>& primitive_loaders()
+        {
+            static std::unordered_map<std::string, primitive_loader> loaders;
+            return loaders;
+        }
+
+        bool register_primitive_loader(char const* key, primitive_loader loader)
+        {
+            primitive_loaders().emplace(key, loader);
+            return true;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        class tree_image_writer
+        {
+        public:
+            tree_image_writer(hpx::serialization::output_archive& ar,
+                    std::map<primitives::base_primitive const*,
+                        std::size_t> const& ids)
+              : ar_(ar)
+              , ids_(ids)
+            {}
+
+            template <typename T>
+            void write(T const& val)
+            {
+                ar_ << val;
+            }
+
+            std::size_t id(primitive const& p) const
+            {
+                auto it = ids_.find(tree_recorder::identity(p));
+                HPX_ASSERT(it != ids_.end());
+                return it->second;
+            }
+
+        private:
+            hpx::serialization::output_archive& ar_;
+            std::map<primitives::base_primitive const*, std::size_t> const&
+                ids_;
+        };
+
+        class tree_image_reader
+        {
+        public:
+            tree_image_reader(hpx::serialization::input_archive& ar,
+                    hpx::id_type const& locality)
+              : ar_(ar)
+              , locality_(locality)
+            {}
+
+            template <typename T>
+            void read(T& val)
+            {
+                ar_ >> val;
+            }
+
+            primitive const& node(std::size_t id) const
+            {
+                if (id >= nodes_.size())
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "phylanx::execution_tree::detail::tree_image_reader",
+                        "malformed image: reference to an unknown primitive");
+                }
+                return nodes_[id];
+            }
+
+            void add_node(primitive && p)
+            {
+                nodes_.push_back(std::move(p));
+            }
+
+            hpx::id_type const& locality() const
+            {
+                return locality_;
+            }
+
+        private:
+            hpx::serialization::input_archive& ar_;
+            hpx::id_type const& locality_;
+            std::vector<primitive> nodes_;
+        };
+
+        hpx::id_type const& image_locality(tree_image_reader& reader)
+        {
+            return reader.locality();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void save_argument(
+            tree_image_writer& writer, primitive_argument_type const& arg)
+        {
+            std::size_t index = arg.index();
+            writer.write(index);
+
+            switch (index)
+            {
+            case 0:     // ast::nil
+                break;
+
+            case 1:
+                writer.write(util::get<bool>(arg));
+                break;
+
+            case 2:
+                writer.write(util::get<std::int64_t>(arg));
+                break;
+
+            case 3:
+                writer.write(util::get<std::string>(arg));
+                break;
+
+            case 4:
+                writer.write(util::get<ir::node_data<double>>(arg));
+                break;
+
+            case 5:
+                writer.write(writer.id(util::get<primitive>(arg)));
+                break;
+
+            case 6:
+                writer.write(util::get<std::vector<ast::expression>>(arg));
+                break;
+
+            case 7:
+                save_argument(writer, util::get<7>(arg).get());
+                break;
+
+            case 8:
+                writer.write(util::get<ir::node_data<float>>(arg));
+                break;
+
+            default:
+                HPX_THROW_EXCEPTION(hpx::invalid_status,
+                    "phylanx::execution_tree::detail::save_argument",
+                    "unexpected type of primitive argument");
+            }
+        }
+
+        void save_argument(tree_image_writer& writer,
+            std::vector<primitive_argument_type> const& args)
+        {
+            writer.write(args.size());
+            for (auto const& arg : args)
+            {
+                save_argument(writer, arg);
+            }
+        }
+
+        void save_argument(tree_image_writer& writer, std::string const& arg)
+        {
+            writer.write(arg);
+        }
+
+        void save_argument(tree_image_writer& writer, std::size_t arg)
+        {
+            writer.write(arg);
+        }
+
+        // localities are chosen when loading an image
+        void save_argument(tree_image_writer&, hpx::id_type const&)
+        {
+        }
+
+        void save_argument(tree_image_writer& writer,
+            std::vector<std::vector<std::size_t>> const& arg)
+        {
+            writer.write(arg);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T>
+        primitive_argument_type read_value(tree_image_reader& reader)
+        {
+            T val;
+            reader.read(val);
+            return primitive_argument_type{std::move(val)};
+        }
+
+        void load_argument(
+            tree_image_reader& reader, primitive_argument_type& arg)
+        {
+            std::size_t index = 0;
+            reader.read(index);
+
+            switch (index)
+            {
+            case 0:
+                arg = primitive_argument_type{ast::nil{}};
+                break;
+
+            case 1:
+                arg = read_value<bool>(reader);
+                break;
+
+            case 2:
+                arg = read_value<std::int64_t>(reader);
+                break;
+
+            case 3:
+                arg = read_value<std::string>(reader);
+                break;
+
+            case 4:
+                arg = read_value<ir::node_data<double>>(reader);
+                break;
+
+            case 5:
+                {
+                    std::size_t id = 0;
+                    reader.read(id);
+                    arg = primitive_argument_type{reader.node(id)};
+                }
+                break;
+
+            case 6:
+                arg = read_value<std::vector<ast::expression>>(reader);
+                break;
+
+            case 7:
+                {
+                    std::vector<primitive_argument_type> list;
+                    load_argument(reader, list);
+                    arg = primitive_argument_type{std::move(list)};
+                }
+                break;
+
+            case 8:
+                arg = read_value<ir::node_data<float>>(reader);
+                break;
+
+            default:
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::detail::load_argument",
+                    "malformed image: unexpected type of primitive argument");
+            }
+        }
+
+        void load_argument(tree_image_reader& reader,
+            std::vector<primitive_argument_type>& args)
+        {
+            std::size_t size = 0;
+            reader.read(size);
+
+            args.clear();
+            args.reserve(size);
+            for (std::size_t i = 0; i != size; ++i)
+            {
+                primitive_argument_type arg;
+                load_argument(reader, arg);
+                args.push_back(std::move(arg));
+            }
+        }
+
+        void load_argument(tree_image_reader& reader, std::string& arg)
+        {
+            reader.read(arg);
+        }
+
+        void load_argument(tree_image_reader& reader, std::size_t& arg)
+        {
+            reader.read(arg);
+        }
+
+        void load_argument(tree_image_reader& reader, hpx::id_type& arg)
+        {
+            arg = reader.locality();
+        }
+
+        void load_argument(tree_image_reader& reader,
+            std::vector<std::vector<std::size_t>>& arg)
+        {
+            reader.read(arg);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void collect_references(
+            primitive_argument_type const& arg, std::vector<primitive>& result)
+        {
+            if (primitive const* p = util::get_if<primitive>(&arg))
+            {
+                result.push_back(*p);
+            }
+            else if (arg.index() == 7)
+            {
+                collect_references(util::get<7>(arg).get(), result);
+            }
+        }
+
+        void collect_references(
+            std::vector<primitive_argument_type> const& args,
+            std::vector<primitive>& result)
+        {
+            for (auto const& arg : args)
+            {
+                collect_references(arg, result);
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        char const* const image_magic = "phylanx execution tree image";
+        std::uint32_t const image_version = 1;
+
+        // Store all primitives reachable from the given roots, in the order
+        // they were created in (i.e. each primitive is stored after the ones
+        // referred to by its constructor arguments).
+        std::vector<char> save_image(tree_recorder& recorder,
+            std::vector<primitive_argument_type> const& roots)
+        {
+            std::vector<tree_recorder::node*> reachable;
+            std::map<primitives::base_primitive const*, std::size_t> ids;
+
+            std::vector<primitive> pending;
+            collect_references(roots, pending);
+            while (!pending.empty())
+            {
+                primitive p = std::move(pending.back());
+                pending.pop_back();
+
+                auto const* identity = tree_recorder::identity(p);
+                if (!ids.emplace(identity, 0).second)
+                {
+                    continue;
+                }
+
+                tree_recorder::node& n = recorder.find(p);
+                if (n.recipe->key() == nullptr)
+                {
+                    HPX_THROW_EXCEPTION(hpx::invalid_status,
+                        "phylanx::execution_tree::compile_to_image",
+                        "the execution tree contains a primitive which "
+                        "can't be stored in an image");
+                }
+
+                reachable.push_back(&n);
+                n.recipe->references(pending);
+                collect_references(n.bodies, pending);
+            }
+
+            std::sort(reachable.begin(), reachable.end(),
+                [](tree_recorder::node const* lhs,
+                    tree_recorder::node const* rhs)
+                {
+                    return lhs->sequence < rhs->sequence;
+                });
+
+            for (std::size_t i = 0; i != reachable.size(); ++i)
+            {
+                ids[tree_recorder::identity(reachable[i]->p)] = i;
+            }
+
+            std::vector<char> data;
+            std::size_t archive_size = 0;
+            {
+                hpx::serialization::output_archive archive(data);
+                tree_image_writer writer(archive, ids);
+
+                writer.write(std::string(image_magic));
+                writer.write(image_version);
+
+                writer.write(reachable.size());
+                for (tree_recorder::node const* n : reachable)
+                {
+                    writer.write(std::string(n->recipe->key()));
+                    n->recipe->save(writer);
+                }
+
+                // function bodies are set after all primitives were created
+                for (std::size_t i = 0; i != reachable.size(); ++i)
+                {
+                    for (auto const& body : reachable[i]->bodies)
+                    {
+                        writer.write(true);
+                        writer.write(i);
+                        save_argument(writer, body);
+                    }
+                }
+                writer.write(false);
+
+                save_argument(writer, roots);
+
+                archive_size = archive.bytes_written();
+            }
+
+            data.resize(archive_size);
+            return data;
+        }
+
+        std::vector<primitive_argument_type> load_image(
+            std::vector<char> const& image, hpx::id_type const& locality)
+        {
+            hpx::serialization::input_archive archive(image, image.size());
+            tree_image_reader reader(archive, locality);
+
+            std::string magic;
+            std::uint32_t version = 0;
+            reader.read(magic);
+            reader.read(version);
+            if (magic != image_magic || version != image_version)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::load_compiled",
+                    "the given data is not a (supported) execution tree image");
+            }
+
+            std::size_t size = 0;
+            reader.read(size);
+            for (std::size_t i = 0; i != size; ++i)
+            {
+                std::string key;
+                reader.read(key);
+
+                auto it = primitive_loaders().find(key);
+                if (it == primitive_loaders().end())
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "phylanx::execution_tree::load_compiled",
+                        "the image refers to an unknown primitive type, it "
+                        "was probably created by a different build of "
+                        "Phylanx");
+                }
+                reader.add_node(it->second(reader));
+            }
+
+            bool has_body = false;
+            reader.read(has_body);
+            while (has_body)
+            {
+                std::size_t id = 0;
+                reader.read(id);
+
+                primitive_argument_type body;
+                load_argument(reader, body);
+
+                execution_tree::define_function(reader.node(id)).set_body(
+                    hpx::launch::sync, std::move(body));
+
+                reader.read(has_body);
+            }
+
+            std::vector<primitive_argument_type> roots;
+            load_argument(reader, roots);
+            return roots;
+        }
+
+        // Install a recorder for the current (HPX) thread
+        struct tree_recorder_scope
+        {
+            explicit tree_recorder_scope(tree_recorder& recorder)
+              : previous_(get_tree_recorder_registry().exchange(&recorder))
+            {
+            }
+
+            ~tree_recorder_scope()
+            {
+                get_tree_recorder_registry().exchange(previous_);
+            }
+
+            tree_recorder* previous_;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<char> compile_to_image(std::string const& expr)
+    {
+        // the parsed expressions are needed during compilation only
+        util::arena arena;
+        return compile_to_image(ast::generate_asts(expr, arena));
+    }
+
+    std::vector<char> compile_to_image(
+        std::vector<ast::expression> const& exprs)
+    {
+        detail::tree_recorder recorder;
+
+        compiler::function_list snippets;
+        compiler::function f;
+        {
+            detail::tree_recorder_scope scope(recorder);
+
+            // the stored tree consists of local primitives, the locality
+            // is chosen when loading the image
+            f = compile(exprs, snippets, hpx::invalid_id);
+        }
+
+        // the first root is the expression itself, followed by all
+        // function definitions
+        std::vector<primitive_argument_type> roots;
+        roots.reserve(snippets.size() + 1);
+        roots.push_back(f.arg_);
+        for (auto const& snippet : snippets)
+        {
+            roots.push_back(snippet.arg_);
+        }
+
+        return detail::save_image(recorder, roots);
+    }
+
+    std::shared_ptr<compiled_expression> load_compiled(
+        std::vector<char> const& image, hpx::id_type const& default_locality)
+    {
+        std::vector<primitive_argument_type> roots =
+            detail::load_image(image, default_locality);
+
+        if (roots.empty())
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "phylanx::execution_tree::load_compiled",
+                "malformed image: missing expression");
+        }
+
+        auto result = std::make_shared<compiled_expression>();
+        result->f = compiler::function{std::move(roots[0]), "image"};
+        for (std::size_t i = 1; i != roots.size(); ++i)
+        {
+            result->snippets.emplace_back(
+                compiler::function{std::move(roots[i])});
+        }
+        return result;
+    }
+}}
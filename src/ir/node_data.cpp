@@ -33,62 +33,89 @@ namespace phylanx { namespace ir
         }
     }
 
-    ///////////////////////////////////////////////////////////////////////////
-    std::ostream& operator<<(std::ostream& out, node_data<double> const& nd)
+    namespace detail
     {
-        std::size_t dims = nd.num_dimensions();
-        switch (dims)
+        template <typename T>
+        std::ostream& print_node_data(
+            std::ostream& out, node_data<T> const& nd)
         {
-        case 0:
-            out << std::to_string(nd[0]);
-            break;
+            std::size_t dims = nd.num_dimensions();
+            switch (dims)
+            {
+            case 0:
+                out << std::to_string(nd[0]);
+                break;
 
-        case 1:
-            detail::print_array(out, nd.vector(), nd.size());
-            break;
+            case 1:
+                detail::print_array(out, nd.vector(), nd.size());
+                break;
 
-        case 2:
-            {
-                auto const& data = nd.matrix();
-                for (std::size_t row = 0; row != data.rows(); ++row)
+            case 2:
                 {
-                    if (row != 0)
-                        out << ", ";
-                    detail::print_array(
-                        out, blaze::row(data, row), data.columns());
+                    auto const& data = nd.matrix();
+                    for (std::size_t row = 0; row != data.rows(); ++row)
+                    {
+                        if (row != 0)
+                            out << ", ";
+                        detail::print_array(
+                            out, blaze::row(data, row), data.columns());
+                    }
                 }
+                break;
+
+            default:
+                HPX_THROW_EXCEPTION(hpx::invalid_status,
+                    "node_data<T>::operator<<",
+                    "invalid dimensionality: " + std::to_string(dims));
             }
-            break;
+            return out;
+        }
 
-        default:
-            HPX_THROW_EXCEPTION(hpx::invalid_status,
-                "node_data<double>::operator bool",
-                "invalid dimensionality: " + std::to_string(dims));
+        template <typename T>
+        bool node_data_as_bool(node_data<T> const& nd)
+        {
+            std::size_t dims = nd.num_dimensions();
+            switch (dims)
+            {
+            case 0:
+                return nd.scalar() != 0;
+
+            case 1:
+                return !blaze::isZero(nd.vector());
+
+            case 2:
+                return !blaze::isZero(nd.matrix());
+
+            default:
+                HPX_THROW_EXCEPTION(hpx::invalid_status,
+                    "node_data<T>::operator bool",
+                    "invalid dimensionality: " + std::to_string(dims));
+            }
+            return false;
         }
-        return out;
     }
 
     ///////////////////////////////////////////////////////////////////////////
-    template <>
-    node_data<double>::operator bool() const
+    std::ostream& operator<<(std::ostream& out, node_data<double> const& nd)
     {
-        std::size_t dims = num_dimensions();
-        switch (dims)
-        {
-        case 0:
-            return scalar() != 0;
+        return detail::print_node_data(out, nd);
+    }
 
-        case 1:
-            return !blaze::isZero(vector());
+    std::ostream& operator<<(std::ostream& out, node_data<float> const& nd)
+    {
+        return detail::print_node_data(out, nd);
+    }
 
-        case 2:
-            return !blaze::isZero(matrix());
+    ///////////////////////////////////////////////////////////////////////////
+    template <>
+    node_data<double>::operator bool() const
+    {
+        return detail::node_data_as_bool(*this);
+    }
 
-        default:
-            HPX_THROW_EXCEPTION(hpx::invalid_status,
-                "node_data<double>::operator bool",
-                "invalid dimensionality: " + std::to_string(dims));
-        }
-        return false;
+    template <>
+    node_data<float>::operator bool() const
+    {
+        return detail::node_data_as_bool(*this);
     }
 }}
@@ -0,0 +1,40 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/util/arena.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+
+namespace phylanx { namespace util { namespace detail
+{
+    constexpr std::size_t arena_data::header_size;
+
+    arena_data::arena_data(std::size_t block_size)
+      : count_(1)
+      , block_size_(block_size)
+      , current_(nullptr)
+      , end_(nullptr)
+    {
+    }
+
+    void arena_data::new_block(std::size_t size)
+    {
+        // operator new[] returns memory suitably aligned for max_align_t
+        std::size_t block_size = (std::max)(size, block_size_);
+        blocks_.emplace_back(new char[block_size]);
+
+        current_ = blocks_.back().get();
+        end_ = current_ + block_size;
+    }
+
+    arena_data*& current_arena()
+    {
+        static thread_local arena_data* current = nullptr;
+        return current;
+    }
+}}}
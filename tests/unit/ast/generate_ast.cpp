@@ -12,6 +12,8 @@
 #include <iomanip>
 #include <iostream>
 #include <sstream>
+#include <string>
+#include <vector>
 
 struct traverse_ast
 {
@@ -111,6 +113,71 @@ void test_expression(std::string const& expr, std::string const& expected)
     }
 }
 
+// the hand-written parser has to generate the same AST as the Spirit grammar
+void test_parsers(std::string const& expr)
+{
+    HPX_TEST(phylanx::ast::generate_asts(expr) ==
+        phylanx::ast::generate_asts_spirit(expr));
+}
+
+void test_parse_error(std::string const& expr)
+{
+    bool caught_exception = false;
+    try
+    {
+        phylanx::ast::generate_asts(expr);
+    }
+    catch (hpx::exception const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+
+    caught_exception = false;
+    try
+    {
+        phylanx::ast::generate_asts_spirit(expr);
+    }
+    catch (hpx::exception const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+void test_parsers()
+{
+    test_parsers("A");
+    test_parsers("  A  ");
+    test_parsers("A + B * -C / D - !E");
+    test_parsers("A || B && C == D != E <= F < G >= H > I");
+    test_parsers("A<=B>=C<D>E");
+    test_parsers("-1.5 + - 1.5 + +2. + .5 + 1e3 + 1.5E-3 + inf");
+    test_parsers("1 + 18446744073709551615");
+    test_parsers("true && false || true_ || falsey");
+    test_parsers("f() + g(A) + h(A, B + C, '(1, 2))");
+    test_parsers("f (A) + '  ( )");
+    test_parsers("\"some string\" + \"  leading blanks\"");
+    test_parsers("((A + B) * (C))");
+    test_parsers("A /* comment */ + // comment\n B");
+    test_parsers("define(x, 1)\ndefine(y, x + 1)\n\ny");
+    test_parsers(R"(
+        block(
+            define(fact, n,
+                if(n <= 1, 1, n * fact(n - 1))
+            ),
+            fact(10)
+        ))");
+
+    test_parse_error("");
+    test_parse_error("A +");
+    test_parse_error("f(A, )");
+    test_parse_error("(A");
+    test_parse_error("\"\"");
+    test_parse_error("A B )");
+    test_parse_error("A // trailing comment");
+}
+
 int main(int argc, char* argv[])
 {
     test_expression(
@@ -200,5 +267,7 @@ int main(int argc, char* argv[])
             "+\n"
     );
 
+    test_parsers();
+
     return hpx::util::report_errors();
 }
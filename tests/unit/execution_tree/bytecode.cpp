@@ -0,0 +1,127 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type run_bytecode(
+    std::string const& exprstr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::bytecode_program program =
+        phylanx::execution_tree::compile_bytecode(exprstr, snippets);
+    return program.run();
+}
+
+phylanx::execution_tree::primitive_argument_type run_tree(
+    std::string const& exprstr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto f = phylanx::execution_tree::compile(exprstr, snippets);
+    return f();
+}
+
+void test_bytecode(std::string const& exprstr, double expected_result)
+{
+    HPX_TEST_EQ(expected_result,
+        phylanx::execution_tree::extract_numeric_value(
+            run_bytecode(exprstr))[0]);
+    HPX_TEST_EQ(expected_result,
+        phylanx::execution_tree::extract_numeric_value(
+            run_tree(exprstr))[0]);
+}
+
+void test_bytecode(std::string const& exprstr, bool expected_result)
+{
+    HPX_TEST_EQ(expected_result,
+        phylanx::execution_tree::extract_boolean_value(
+            run_bytecode(exprstr)) != 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_scalar_operations()
+{
+    test_bytecode("1.0 + 2.0 * 3.0", 7.0);
+    test_bytecode("10.0 - 2.0 - 3.0", 5.0);
+    test_bytecode("-(2.0 / 4.0)", -0.5);
+    test_bytecode("1 + 2", 3.0);
+    test_bytecode("1.0 < 2.0", true);
+    test_bytecode("1.0 >= 2.0", false);
+    test_bytecode("true && !false", true);
+    test_bytecode("1.0 == 2.0 || 3.0 != 4.0", true);
+}
+
+void test_control_flow()
+{
+    test_bytecode(R"(
+        block(
+            define(x, 5.0),
+            if(x > 3.0, x * 2.0, x)
+        ))", 10.0);
+
+    HPX_TEST(!phylanx::execution_tree::valid(
+        run_bytecode("if(1.0 > 3.0, 42.0)")));
+
+    test_bytecode(R"(
+        block(
+            define(i, 0.0),
+            define(sum, 0.0),
+            while(i < 100.0,
+                block(
+                    store(sum, sum + i),
+                    store(i, i + 1.0)
+                )
+            ),
+            sum
+        ))", 4950.0);
+
+    test_bytecode(R"(
+        block(
+            define(sum, 0.0),
+            for(define(i, 0.0), i < 10.0, store(i, i + 1.0),
+                store(sum, sum + i * i)
+            ),
+            sum
+        ))", 285.0);
+}
+
+void test_tree_fallback()
+{
+    // all other primitives are invoked through an execution tree which
+    // receives the referenced variables as its arguments
+    test_bytecode(R"(
+        block(
+            define(x, 2.0),
+            define(y, 0.0),
+            while(x < 100.0,
+                block(
+                    store(y, y + dot(x, x)),
+                    store(x, x * 2.0)
+                )
+            ),
+            y
+        ))", 5460.0);
+
+    // function definitions are compiled into an execution tree as a whole
+    test_bytecode(R"(
+        block(
+            define(f, a, b, a * b + 1.0),
+            f(3.0, 4.0)
+        ))", 13.0);
+}
+
+int main(int argc, char* argv[])
+{
+    test_scalar_operations();
+    test_control_flow();
+    test_tree_fallback();
+
+    return hpx::util::report_errors();
+}
@@ -6,9 +6,16 @@
 #include <phylanx/phylanx.hpp>
 
 #include <hpx/hpx_main.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
 #include <hpx/runtime/find_here.hpp>
 #include <hpx/util/lightweight_test.hpp>
 
+#include <atomic>
+#include <exception>
+#include <utility>
+#include <vector>
+
 void test_builtin_environment()
 {
     hpx::id_type here = hpx::find_here();
@@ -414,6 +421,553 @@ void test_recursive_function()
         )[0]);
 }
 
+void test_local_execution()
+{
+    char const* exprstr = R"(
+        block(
+            define(fact, arg0,
+                if(arg0 <= 1,
+                    1,
+                    arg0 * fact(arg0 - 1)
+                )
+            ),
+            fact
+        )
+    )";
+
+    // an invalid locality creates the tree from plain local objects
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto fact = phylanx::execution_tree::compile(
+        exprstr, snippets, hpx::invalid_id);
+
+    phylanx::execution_tree::primitive const* p =
+        phylanx::util::get_if<phylanx::execution_tree::primitive>(&fact.arg_);
+    HPX_TEST(p != nullptr && p->is_local());
+
+    auto arg = phylanx::ir::node_data<double>{10.0};
+    HPX_TEST_EQ(3628800.0,
+        phylanx::execution_tree::extract_numeric_value(
+            fact(std::move(arg))
+        )[0]);
+}
+
+void test_common_subexpressions()
+{
+    char const* exprstr = R"(
+        block(
+            define(x, 3.0),
+            define(y, 0.0),
+            define(f, a, dot(a, a) + dot(a, a) / 3.0),
+            store(y, dot(x, x) + dot(x, x) * 2.0 + f(x)),
+            y
+        )
+    )";
+
+    // dot(x, x) and dot(a, a) are evaluated only once
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto f = phylanx::execution_tree::compile(exprstr, snippets);
+
+    HPX_TEST_EQ(39.0, phylanx::execution_tree::extract_numeric_value(f())[0]);
+    HPX_TEST_EQ(39.0,
+        phylanx::execution_tree::extract_numeric_value(
+            f.eval(phylanx::execution_tree::compiler::arguments_type{}).get()
+        )[0]);
+}
+
+void test_constant_folding()
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto f = phylanx::execution_tree::compile(
+        "1.0 / (1.0 + 3.0) + exp(0.0)", snippets);
+
+    // the whole expression was evaluated at compile time
+    HPX_TEST(phylanx::util::get_if<phylanx::execution_tree::primitive>(
+        &f.arg_) == nullptr);
+    HPX_TEST_EQ(1.25, phylanx::execution_tree::extract_numeric_value(f())[0]);
+
+    // redefined built-in functions are not evaluated at compile time
+    auto g = phylanx::execution_tree::compile(R"(
+        block(
+            define(exp, x, x + 1.0),
+            exp(1.0)
+        )
+    )", snippets);
+    HPX_TEST_EQ(2.0, phylanx::execution_tree::extract_numeric_value(g())[0]);
+}
+
+void test_redefined_dot()
+{
+    // nested calls to a redefined dot are not turned into multi_dot
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto f = phylanx::execution_tree::compile(R"(
+        block(
+            define(x, 2.0),
+            define(dot, a, b, a + b),
+            dot(dot(x, x), x)
+        )
+    )", snippets);
+    HPX_TEST_EQ(6.0, phylanx::execution_tree::extract_numeric_value(f())[0]);
+}
+
+void test_unused_definitions()
+{
+    // the definition of 'unused' refers to an undefined variable, which
+    // would make compilation fail if it wasn't removed
+    char const* exprstr = R"(
+        block(
+            define(unused, dot(y, z)),
+            define(y, 3.0),
+            define(g, a, a + z),
+            y * 2.0
+        )
+    )";
+
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto f = phylanx::execution_tree::compile(exprstr, snippets);
+
+    HPX_TEST_EQ(6.0, phylanx::execution_tree::extract_numeric_value(f())[0]);
+}
+
+void test_loop_invariants()
+{
+    // dot(x, x) and x * x don't depend on any of the variables modified by
+    // the loops and are evaluated only once
+    char const* exprstr1 = R"(
+        block(
+            define(x, 2.0),
+            define(s, 0.0),
+            define(i, 0.0),
+            while(i < 4.0,
+                block(
+                    store(s, s + dot(x, x) * i),
+                    store(i, i + 1.0)
+                )
+            ),
+            s
+        )
+    )";
+
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto f1 = phylanx::execution_tree::compile(exprstr1, snippets);
+    HPX_TEST_EQ(24.0, phylanx::execution_tree::extract_numeric_value(f1())[0]);
+
+    char const* exprstr2 = R"(
+        block(
+            define(x, 3.0),
+            define(s, 0.0),
+            for(define(i, 0.0), i < 5.0, store(i, i + 1.0),
+                store(s, s + x * x + i)
+            ),
+            s
+        )
+    )";
+
+    auto f2 = phylanx::execution_tree::compile(exprstr2, snippets);
+    HPX_TEST_EQ(55.0, phylanx::execution_tree::extract_numeric_value(f2())[0]);
+
+    // loops which are never entered don't evaluate their invariants
+    char const* exprstr3 = R"(
+        block(
+            define(x, 2.0),
+            define(s, 1.0),
+            define(i, 0.0),
+            while(i > 10.0,
+                block(
+                    store(s, s + dot(x, x)),
+                    store(i, i + 1.0)
+                )
+            ),
+            s
+        )
+    )";
+
+    auto f3 = phylanx::execution_tree::compile(exprstr3, snippets);
+    HPX_TEST_EQ(1.0, phylanx::execution_tree::extract_numeric_value(f3())[0]);
+}
+
+void test_register_patterns()
+{
+    // the parsed patterns are generated once and reused
+    auto patterns =
+        phylanx::execution_tree::get_all_known_expression_patterns();
+    HPX_TEST(patterns ==
+        phylanx::execution_tree::get_all_known_expression_patterns());
+
+    phylanx::execution_tree::register_patterns({
+        hpx::util::make_tuple("plus", "plus(_1, _2)",
+            &phylanx::execution_tree::create<
+                phylanx::execution_tree::primitives::add_operation>)
+    });
+
+    auto extended =
+        phylanx::execution_tree::get_all_known_expression_patterns();
+    HPX_TEST(patterns != extended);
+    HPX_TEST_EQ(patterns->size() + 1, extended->size());
+
+    char const* exprstr = R"(
+        block(
+            define(x, 41.0),
+            plus(x, 1.0)
+        )
+    )";
+
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto f = phylanx::execution_tree::compile(exprstr, snippets);
+    HPX_TEST_EQ(42.0, phylanx::execution_tree::extract_numeric_value(f())[0]);
+
+    // pattern names have to be unique
+    bool caught_exception = false;
+    try
+    {
+        phylanx::execution_tree::register_patterns({
+            hpx::util::make_tuple("plus", "plus(_1, _2)",
+                &phylanx::execution_tree::create<
+                    phylanx::execution_tree::primitives::add_operation>)
+        });
+    }
+    catch (hpx::exception const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+void test_compile_cache()
+{
+    char const* exprstr = R"(
+        block(
+            define(x, 1.0),
+            store(x, x + 1.0),
+            x
+        )
+    )";
+
+    auto c1 = phylanx::execution_tree::compile_cached(exprstr);
+    HPX_TEST_EQ(2.0,
+        phylanx::execution_tree::extract_numeric_value(c1->f())[0]);
+
+    // evaluating the same instance again sees the modified variable
+    HPX_TEST_EQ(3.0,
+        phylanx::execution_tree::extract_numeric_value(c1->f())[0]);
+
+    // each instance handed out by the cache starts with fresh variables
+    auto c2 = phylanx::execution_tree::compile_cached(exprstr);
+    HPX_TEST(c1 != c2);
+    HPX_TEST_EQ(2.0,
+        phylanx::execution_tree::extract_numeric_value(c2->f())[0]);
+
+    auto c3 = phylanx::execution_tree::compile_cached(exprstr, hpx::invalid_id);
+    HPX_TEST_EQ(2.0,
+        phylanx::execution_tree::extract_numeric_value(c3->f())[0]);
+
+    phylanx::execution_tree::clear_compile_cache();
+
+    auto c4 = phylanx::execution_tree::compile_cached(exprstr);
+    HPX_TEST_EQ(2.0,
+        phylanx::execution_tree::extract_numeric_value(c4->f())[0]);
+}
+
+// counts how often the compiler instantiates the 'counted_add' primitive
+std::atomic<int> num_counted_add(0);
+
+phylanx::execution_tree::primitive create_counted_add(hpx::id_type locality,
+    std::vector<phylanx::execution_tree::primitive_argument_type>&& operands)
+{
+    ++num_counted_add;
+    return phylanx::execution_tree::create<
+        phylanx::execution_tree::primitives::add_operation>(
+            locality, std::move(operands));
+}
+
+void test_compile_cache_reuse()
+{
+    phylanx::execution_tree::register_patterns({
+        hpx::util::make_tuple("counted_add", "counted_add(_1, _2)",
+            &create_counted_add)
+    });
+
+    char const* exprstr1 = R"(
+        block(
+            define(x, 1.0),
+            store(x, counted_add(x, 1.0)),
+            x
+        )
+    )";
+    char const* exprstr2 = "block(define(y, 1.0), counted_add(y, 2.0))";
+
+    phylanx::execution_tree::clear_compile_cache();
+
+    // repeated requests restore fresh instances without compiling again
+    for (int i = 0; i != 5; ++i)
+    {
+        auto c = phylanx::execution_tree::compile_cached(exprstr1);
+        HPX_TEST_EQ(2.0,
+            phylanx::execution_tree::extract_numeric_value(c->f())[0]);
+    }
+    HPX_TEST_EQ(num_counted_add.load(), 1);
+
+    // the least recently used expression is evicted
+    phylanx::execution_tree::set_compile_cache_capacity(1);
+
+    auto c2 = phylanx::execution_tree::compile_cached(exprstr2);
+    HPX_TEST_EQ(3.0,
+        phylanx::execution_tree::extract_numeric_value(c2->f())[0]);
+    HPX_TEST_EQ(num_counted_add.load(), 2);
+
+    auto c1 = phylanx::execution_tree::compile_cached(exprstr1);
+    HPX_TEST_EQ(2.0,
+        phylanx::execution_tree::extract_numeric_value(c1->f())[0]);
+    HPX_TEST_EQ(num_counted_add.load(), 3);
+
+    phylanx::execution_tree::set_compile_cache_capacity(128);
+    phylanx::execution_tree::clear_compile_cache();
+}
+
+void test_environment_scopes()
+{
+    using phylanx::execution_tree::compiler::compiled_function;
+    using phylanx::execution_tree::compiler::environment;
+    using phylanx::execution_tree::compiler::function;
+    using phylanx::execution_tree::compiler::function_list;
+
+    environment outer =
+        phylanx::execution_tree::compiler::default_environment();
+    environment inner(&outer);
+
+    // unknown names are not resolved in any scope
+    HPX_TEST(inner.find("not_defined") == nullptr);
+
+    // nested scopes share the symbols of the outermost environment
+    HPX_TEST(inner.find("block") == outer.find("block"));
+    HPX_TEST(&inner.symbols() == &outer.symbols());
+
+    auto make_literal = [](double value)
+    {
+        return [value](function_list)
+        {
+            return function{phylanx::ir::node_data<double>{value}};
+        };
+    };
+
+    outer.define("y", make_literal(1.0));
+    compiled_function* shadowed = inner.define("y", make_literal(2.0));
+
+    HPX_TEST(inner.find("y") == shadowed);
+    HPX_TEST(outer.find("y") != shadowed);
+    HPX_TEST_EQ(inner.size(), outer.size() + 1);
+
+    bool caught_exception = false;
+    try
+    {
+        inner.define("y", make_literal(3.0));
+    }
+    catch (hpx::exception const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+void test_compile_to_image()
+{
+    char const* exprstr = R"(
+        block(
+            define(fact, n,
+                if(n <= 1, 1.0, n * fact(n - 1))
+            ),
+            define(x, 2.0),
+            store(x, x + 1.0),
+            define(l, '(1, "two", x)),
+            fact(5) + x
+        )
+    )";
+
+    std::vector<char> image =
+        phylanx::execution_tree::compile_to_image(exprstr);
+    HPX_TEST(!image.empty());
+
+    auto c1 = phylanx::execution_tree::load_compiled(image);
+    HPX_TEST_EQ(123.0,
+        phylanx::execution_tree::extract_numeric_value(c1->f())[0]);
+
+    // each restored tree starts with fresh variables
+    auto c2 = phylanx::execution_tree::load_compiled(image, hpx::invalid_id);
+    HPX_TEST_EQ(123.0,
+        phylanx::execution_tree::extract_numeric_value(c2->f())[0]);
+
+    // compilations running concurrently on HPX threads (which may be
+    // suspended while folding constants, and may be resumed on a different
+    // OS thread) record their trees independently
+    std::vector<hpx::future<std::vector<char>>> images;
+    for (int i = 0; i != 16; ++i)
+    {
+        images.push_back(hpx::async(
+            [exprstr]()
+            {
+                return phylanx::execution_tree::compile_to_image(exprstr);
+            }));
+    }
+    for (auto& f : images)
+    {
+        auto c = phylanx::execution_tree::load_compiled(f.get());
+        HPX_TEST_EQ(123.0,
+            phylanx::execution_tree::extract_numeric_value(c->f())[0]);
+    }
+
+    bool caught_exception = false;
+    try
+    {
+        image.resize(image.size() / 2);
+        phylanx::execution_tree::load_compiled(image);
+    }
+    catch (std::exception const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+void test_incremental_compilation()
+{
+    phylanx::execution_tree::compiler::incremental_compiler c;
+
+    auto f =
+        c.compile("define(a, 1.0) define(b, 2.0) define(f, x, x + a) f(b)");
+    HPX_TEST_EQ(3.0, phylanx::execution_tree::extract_numeric_value(f())[0]);
+    HPX_TEST_EQ(c.num_compiled(), std::size_t(3));
+    HPX_TEST_EQ(c.num_reused(), std::size_t(0));
+
+    // only the modified definition is compiled again
+    f = c.compile("define(a, 1.0) define(b, 3.0) define(f, x, x + a) f(b)");
+    HPX_TEST_EQ(4.0, phylanx::execution_tree::extract_numeric_value(f())[0]);
+    HPX_TEST_EQ(c.num_compiled(), std::size_t(1));
+    HPX_TEST_EQ(c.num_reused(), std::size_t(2));
+
+    // definitions referring to a modified definition are compiled again
+    f = c.compile("define(a, 2.0) define(b, 3.0) define(f, x, x + a) f(b)");
+    HPX_TEST_EQ(5.0, phylanx::execution_tree::extract_numeric_value(f())[0]);
+    HPX_TEST_EQ(c.num_compiled(), std::size_t(2));
+    HPX_TEST_EQ(c.num_reused(), std::size_t(1));
+
+    // the statements of a block are all evaluated, variables modified by
+    // the program are initialized anew
+    char const* exprstr = R"(
+        block(
+            define(x, 2.0),
+            define(a, 2.0),
+            define(g, y, y * a),
+            store(x, x + 1.0),
+            g(x)
+        )
+    )";
+
+    f = c.compile(exprstr);
+    HPX_TEST_EQ(6.0, phylanx::execution_tree::extract_numeric_value(f())[0]);
+
+    f = c.compile(exprstr);
+    HPX_TEST_EQ(6.0, phylanx::execution_tree::extract_numeric_value(f())[0]);
+    HPX_TEST_EQ(c.num_compiled(), std::size_t(1));
+    HPX_TEST_EQ(c.num_reused(), std::size_t(2));
+
+    // the previous version is retained if the compilation fails
+    bool caught_exception = false;
+    try
+    {
+        c.compile("define(a, 1.0) define(a, 2.0) a");
+    }
+    catch (hpx::exception const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+    HPX_TEST(c.env().find("g") != nullptr);
+}
+
+// The incremental compiler applies the same passes to the program as a whole
+// as compile() does
+void test_incremental_whole_program()
+{
+    // the definition of 'unused' refers to an undefined variable, which
+    // would make compilation fail if it wasn't removed
+    char const* version1 = R"(
+        block(
+            define(a, constant(1.0, 3)),
+            define(b, constant(2.0, 3)),
+            define(unused, dot(a, z)),
+            define(f, x, x * a),
+            define(c, a + b),
+            dot(f(c), a)
+        )
+    )";
+    char const* version2 = R"(
+        block(
+            define(a, constant(1.0, 3)),
+            define(b, constant(2.0, 3)),
+            define(unused, dot(a, z)),
+            define(f, x, x * a),
+            define(c, a + b),
+            dot(f(c), b)
+        )
+    )";
+
+    // the shapes of the operands of 'a + b' are known only when looking at
+    // the definitions of both
+    char const* version3 = R"(
+        block(
+            define(a, constant(1.0, 3)),
+            define(b, constant(2.0, 2)),
+            define(unused, dot(a, z)),
+            define(f, x, x * a),
+            define(c, a + b),
+            dot(f(c), b)
+        )
+    )";
+
+    phylanx::execution_tree::compiler::incremental_compiler c;
+
+    auto f = c.compile(version1);
+    HPX_TEST_EQ(c.num_compiled(), std::size_t(4));
+    HPX_TEST_EQ(c.num_reused(), std::size_t(0));
+
+    phylanx::execution_tree::compiler::function_list snippets1;
+    auto expected = phylanx::execution_tree::compile(version1, snippets1);
+    HPX_TEST_EQ(phylanx::execution_tree::extract_numeric_value(expected())[0],
+        phylanx::execution_tree::extract_numeric_value(f())[0]);
+
+    f = c.compile(version2);
+    HPX_TEST_EQ(c.num_compiled(), std::size_t(0));
+    HPX_TEST_EQ(c.num_reused(), std::size_t(4));
+
+    phylanx::execution_tree::compiler::function_list snippets2;
+    expected = phylanx::execution_tree::compile(version2, snippets2);
+    HPX_TEST_EQ(phylanx::execution_tree::extract_numeric_value(expected())[0],
+        phylanx::execution_tree::extract_numeric_value(f())[0]);
+
+    bool caught_exception = false;
+    try
+    {
+        phylanx::execution_tree::compiler::function_list snippets3;
+        phylanx::execution_tree::compile(version3, snippets3);
+    }
+    catch (hpx::exception const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+
+    caught_exception = false;
+    try
+    {
+        c.compile(version3);
+    }
+    catch (hpx::exception const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+    HPX_TEST(c.env().find("b") != nullptr);
+}
+
 int main(int argc, char* argv[])
 {
     test_builtin_environment();
@@ -438,6 +992,19 @@ int main(int argc, char* argv[])
 //     test_define_curry_function();
 
     test_recursive_function();
+    test_local_execution();
+    test_common_subexpressions();
+    test_constant_folding();
+    test_redefined_dot();
+    test_unused_definitions();
+    test_loop_invariants();
+    test_register_patterns();
+    test_compile_cache();
+    test_compile_cache_reuse();
+    test_environment_scopes();
+    test_compile_to_image();
+    test_incremental_compilation();
+    test_incremental_whole_program();
 
     return hpx::util::report_errors();
 }
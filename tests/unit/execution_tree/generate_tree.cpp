@@ -217,6 +217,10 @@ void test_complex_expression()
         variables, 1.0 + std::exp(-6.0));
     test_generate_tree("1.0 / (1.0 + exp(-dot(A, B)))",
         variables, 1.0 / (1.0 + std::exp(-6.0)));
+
+    // nested dot() invocations are compiled into a single multi_dot()
+    test_generate_tree("dot(dot(A, B), A)", variables, 18.0);
+    test_generate_tree("dot(A, dot(B, dot(A, B)))", variables, 36.0);
 }
 
 void test_if_conditional()
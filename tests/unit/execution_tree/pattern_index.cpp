@@ -0,0 +1,83 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <map>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+// return the name of the first pattern matching the given expression
+std::string first_match(phylanx::ast::expression const& expr,
+    phylanx::execution_tree::compiler::expression_pattern_list const& patterns)
+{
+    for (auto const& pattern : patterns)
+    {
+        std::multimap<std::string, phylanx::ast::expression> placeholders;
+        if (phylanx::ast::match_ast(expr, hpx::util::get<2>(pattern),
+                phylanx::execution_tree::compiler::on_placeholder_match{
+                    placeholders}))
+        {
+            return hpx::util::get<0>(pattern);
+        }
+    }
+    return "";
+}
+
+std::string first_candidate(phylanx::ast::expression const& expr,
+    phylanx::execution_tree::compiler::pattern_index const& index)
+{
+    for (auto const* pattern : index.candidates(expr))
+    {
+        std::multimap<std::string, phylanx::ast::expression> placeholders;
+        if (phylanx::ast::match_ast(expr, hpx::util::get<2>(*pattern),
+                phylanx::execution_tree::compiler::on_placeholder_match{
+                    placeholders}))
+        {
+            return hpx::util::get<0>(*pattern);
+        }
+    }
+    return "";
+}
+
+void test_pattern_index()
+{
+    phylanx::execution_tree::compiler::expression_pattern_list patterns =
+        phylanx::execution_tree::compiler::generate_patterns(
+            phylanx::execution_tree::get_all_known_patterns());
+
+    phylanx::execution_tree::compiler::pattern_index index(patterns);
+
+    char const* const exprs[] =
+    {
+        "a + b", "a - b * c", "a * b + c", "(a + b) * c", "a < b && c",
+        "-a", "!a", "-(a + b)", "a", "42.0", "\"text\"",
+        "block(a, b)", "if(a, b)", "if(a, b, c)", "dot(a, b)",
+        "dot(dot(a, b), c)", "f(a, b)", "store(a, b + c)",
+        "for(define(i, 0), i < 10, store(i, i + 1), i)", "(dot(a, b))"
+    };
+
+    for (char const* exprstr : exprs)
+    {
+        auto expr = phylanx::ast::generate_ast(exprstr);
+        HPX_TEST_EQ(first_match(expr, patterns), first_candidate(expr, index));
+    }
+
+    // unknown functions don't have any candidates
+    HPX_TEST(index.candidates(phylanx::ast::generate_ast("f(a, b)")).empty());
+
+    HPX_TEST(index.find("dot") != nullptr);
+    HPX_TEST(index.find("unknown") == nullptr);
+}
+
+int main(int argc, char* argv[])
+{
+    test_pattern_index();
+
+    return hpx::util::report_errors();
+}
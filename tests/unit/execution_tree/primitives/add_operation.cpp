@@ -159,6 +159,25 @@ void test_add_operation_2d_lit()
         phylanx::execution_tree::extract_numeric_value(f.get()));
 }
 
+void test_add_operation_direct()
+{
+    phylanx::ir::node_data<double> lhs(41.0);
+
+    phylanx::execution_tree::primitive rhs =
+        hpx::new_<phylanx::execution_tree::primitives::variable>(
+            hpx::find_here(), phylanx::ir::node_data<double>(1.0));
+
+    phylanx::execution_tree::primitive add =
+        hpx::new_<phylanx::execution_tree::primitives::add_operation>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                std::move(lhs), std::move(rhs)});
+
+    // evaluate synchronously, without creating any futures
+    HPX_TEST_EQ(42.0,
+        phylanx::execution_tree::extract_numeric_value(add.eval_direct())[0]);
+}
+
 int main(int argc, char* argv[])
 {
     test_add_operation_0d();
@@ -170,5 +189,7 @@ int main(int argc, char* argv[])
     test_add_operation_2d();
     test_add_operation_2d_lit();
 
+    test_add_operation_direct();
+
     return hpx::util::report_errors();
 }
@@ -0,0 +1,177 @@
+//   Copyright (c) 2017 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<blaze::DynamicMatrix<double>> generate_matrices(
+    std::size_t count, std::size_t rows, std::size_t columns)
+{
+    blaze::Rand<blaze::DynamicMatrix<double>> gen{};
+
+    std::vector<blaze::DynamicMatrix<double>> result;
+    result.reserve(count);
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        // make sure the matrices are well conditioned
+        blaze::DynamicMatrix<double> m = gen.generate(rows, columns);
+        for (std::size_t j = 0; j != rows && j != columns; ++j)
+        {
+            m(j, j) += double(rows);
+        }
+        result.push_back(std::move(m));
+    }
+    return result;
+}
+
+phylanx::execution_tree::primitive_argument_type make_batch(
+    std::vector<blaze::DynamicMatrix<double>> const& matrices)
+{
+    std::vector<phylanx::execution_tree::primitive_argument_type> batch;
+    batch.reserve(matrices.size());
+    for (auto const& m : matrices)
+    {
+        batch.push_back(phylanx::ir::node_data<double>(m));
+    }
+    return phylanx::execution_tree::primitive_argument_type{std::move(batch)};
+}
+
+bool almost_equal(blaze::DynamicMatrix<double> const& lhs,
+    blaze::DynamicMatrix<double> const& rhs)
+{
+    return lhs.rows() == rhs.rows() && lhs.columns() == rhs.columns() &&
+        blaze::max(blaze::abs(lhs - rhs)) < 1e-10;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_batched_dot(std::size_t n)
+{
+    auto lhs = generate_matrices(10, n, n);
+    auto rhs = generate_matrices(10, n, n);
+
+    phylanx::execution_tree::primitive dot =
+        hpx::new_<phylanx::execution_tree::primitives::batched_dot>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                make_batch(lhs), make_batch(rhs)
+            });
+
+    auto result =
+        phylanx::execution_tree::extract_list_value(dot.eval().get());
+
+    HPX_TEST_EQ(result.size(), lhs.size());
+    for (std::size_t i = 0; i != result.size(); ++i)
+    {
+        blaze::DynamicMatrix<double> expected = lhs[i] * rhs[i];
+        HPX_TEST(almost_equal(expected,
+            phylanx::execution_tree::extract_numeric_value(result[i])
+                .matrix()));
+    }
+}
+
+void test_batched_dot_broadcast()
+{
+    auto lhs = generate_matrices(5, 4, 4);
+    blaze::DynamicVector<double> v{1.0, 2.0, 3.0, 4.0};
+
+    phylanx::execution_tree::primitive dot =
+        hpx::new_<phylanx::execution_tree::primitives::batched_dot>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                make_batch(lhs), phylanx::ir::node_data<double>(v)
+            });
+
+    auto result =
+        phylanx::execution_tree::extract_list_value(dot.eval().get());
+
+    HPX_TEST_EQ(result.size(), lhs.size());
+    for (std::size_t i = 0; i != result.size(); ++i)
+    {
+        blaze::DynamicVector<double> expected = lhs[i] * v;
+        blaze::DynamicVector<double> actual =
+            phylanx::execution_tree::extract_numeric_value(result[i])
+                .vector();
+        HPX_TEST_EQ(expected.size(), actual.size());
+        HPX_TEST(blaze::max(blaze::abs(expected - actual)) < 1e-10);
+    }
+}
+
+void test_batched_inverse(std::size_t n)
+{
+    auto matrices = generate_matrices(10, n, n);
+
+    phylanx::execution_tree::primitive inverse =
+        hpx::new_<phylanx::execution_tree::primitives::batched_inverse>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                make_batch(matrices)
+            });
+
+    auto result =
+        phylanx::execution_tree::extract_list_value(inverse.eval().get());
+
+    HPX_TEST_EQ(result.size(), matrices.size());
+    for (std::size_t i = 0; i != result.size(); ++i)
+    {
+        blaze::DynamicMatrix<double> expected = blaze::inv(matrices[i]);
+        HPX_TEST(almost_equal(expected,
+            phylanx::execution_tree::extract_numeric_value(result[i])
+                .matrix()));
+    }
+}
+
+void test_batched_solve(std::size_t n)
+{
+    auto matrices = generate_matrices(10, n, n);
+    auto rhs = generate_matrices(10, n, 2);
+
+    phylanx::execution_tree::primitive solve =
+        hpx::new_<phylanx::execution_tree::primitives::batched_solve>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                make_batch(matrices), make_batch(rhs)
+            });
+
+    auto result =
+        phylanx::execution_tree::extract_list_value(solve.eval().get());
+
+    HPX_TEST_EQ(result.size(), matrices.size());
+    for (std::size_t i = 0; i != result.size(); ++i)
+    {
+        blaze::DynamicMatrix<double> x =
+            phylanx::execution_tree::extract_numeric_value(result[i])
+                .matrix();
+        HPX_TEST(almost_equal(rhs[i], matrices[i] * x));
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // fixed size kernels
+    test_batched_dot(4);
+    test_batched_dot(8);
+    test_batched_inverse(3);
+    test_batched_inverse(16);
+    test_batched_solve(8);
+
+    // generic kernels
+    test_batched_dot(5);
+    test_batched_inverse(20);
+    test_batched_solve(33);
+
+    test_batched_dot_broadcast();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,102 @@
+//   Copyright (c) 2017 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+phylanx::ir::node_data<double> einsum(std::string const& subscripts,
+    std::vector<phylanx::execution_tree::primitive_argument_type>&& ops)
+{
+    ops.insert(ops.begin(),
+        phylanx::execution_tree::primitive_argument_type{subscripts});
+
+    phylanx::execution_tree::primitive einsum =
+        hpx::new_<phylanx::execution_tree::primitives::einsum_operation>(
+            hpx::find_here(), std::move(ops));
+
+    return phylanx::execution_tree::extract_numeric_value(einsum.eval().get());
+}
+
+void test_einsum_gemm()
+{
+    blaze::DynamicMatrix<double> m1{{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}};
+    blaze::DynamicMatrix<double> m2{{1.0, 2.0}, {3.0, 4.0}, {5.0, 6.0}};
+
+    blaze::DynamicMatrix<double> expected = m1 * m2;
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(expected),
+        einsum("ij,jk->ik", {phylanx::ir::node_data<double>(m1),
+                                phylanx::ir::node_data<double>(m2)}));
+
+    // the subscript labels are arbitrary
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(expected),
+        einsum("ab, bc -> ac", {phylanx::ir::node_data<double>(m1),
+                                   phylanx::ir::node_data<double>(m2)}));
+
+    blaze::DynamicMatrix<double> expected_trans = blaze::trans(m1) * m1;
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(expected_trans),
+        einsum("ji,jk->ik", {phylanx::ir::node_data<double>(m1),
+                                phylanx::ir::node_data<double>(m1)}));
+}
+
+void test_einsum_gemv()
+{
+    blaze::DynamicMatrix<double> m{{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}};
+    blaze::DynamicVector<double> v{1.0, 2.0, 3.0};
+
+    blaze::DynamicVector<double> expected = m * v;
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(expected),
+        einsum("ij,j->i", {phylanx::ir::node_data<double>(m),
+                              phylanx::ir::node_data<double>(v)}));
+}
+
+void test_einsum_1d()
+{
+    blaze::DynamicVector<double> v1{1.0, 2.0, 3.0};
+    blaze::DynamicVector<double> v2{4.0, 5.0, 6.0};
+
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(32.0),
+        einsum("i,i->", {phylanx::ir::node_data<double>(v1),
+                            phylanx::ir::node_data<double>(v2)}));
+
+    blaze::DynamicMatrix<double> expected = v1 * blaze::trans(v2);
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(expected),
+        einsum("i,j->ij", {phylanx::ir::node_data<double>(v1),
+                              phylanx::ir::node_data<double>(v2)}));
+}
+
+void test_einsum_unary()
+{
+    blaze::DynamicMatrix<double> m{{1.0, 2.0}, {3.0, 4.0}};
+
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(5.0),
+        einsum("ii->", {phylanx::ir::node_data<double>(m)}));
+
+    blaze::DynamicVector<double> row_sums{3.0, 7.0};
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(row_sums),
+        einsum("ij->i", {phylanx::ir::node_data<double>(m)}));
+
+    blaze::DynamicMatrix<double> expected = blaze::trans(m);
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(expected),
+        einsum("ij->ji", {phylanx::ir::node_data<double>(m)}));
+}
+
+int main(int argc, char* argv[])
+{
+    test_einsum_gemm();
+    test_einsum_gemv();
+    test_einsum_1d();
+    test_einsum_unary();
+
+    return hpx::util::report_errors();
+}
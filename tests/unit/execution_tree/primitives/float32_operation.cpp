@@ -0,0 +1,218 @@
+//   Copyright (c) 2017 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+phylanx::execution_tree::primitive float32(
+    phylanx::execution_tree::primitive_argument_type&& value)
+{
+    return hpx::new_<phylanx::execution_tree::primitives::float32_operation>(
+        hpx::find_here(),
+        std::vector<phylanx::execution_tree::primitive_argument_type>{
+            std::move(value)
+        });
+}
+
+phylanx::execution_tree::primitive_result_type dot(
+    phylanx::execution_tree::primitive_argument_type&& lhs,
+    phylanx::execution_tree::primitive_argument_type&& rhs)
+{
+    phylanx::execution_tree::primitive dot =
+        hpx::new_<phylanx::execution_tree::primitives::dot_operation>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                std::move(lhs), std::move(rhs)
+            });
+
+    return dot.eval().get();
+}
+
+template <typename Primitive>
+bool compare(phylanx::execution_tree::primitive_argument_type&& lhs,
+    phylanx::execution_tree::primitive_argument_type&& rhs)
+{
+    phylanx::execution_tree::primitive p =
+        hpx::new_<Primitive>(hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                std::move(lhs), std::move(rhs)
+            });
+
+    return phylanx::execution_tree::extract_boolean_value(p.eval().get());
+}
+
+void test_float32_conversion()
+{
+    blaze::DynamicMatrix<double> m{{1.0, 2.0}, {3.0, 4.0}};
+
+    phylanx::execution_tree::primitive_result_type result =
+        float32(phylanx::ir::node_data<double>(m)).eval().get();
+
+    HPX_TEST(phylanx::execution_tree::is_float32_value(result));
+
+    blaze::DynamicMatrix<float> expected{{1.0f, 2.0f}, {3.0f, 4.0f}};
+    HPX_TEST_EQ(phylanx::ir::node_data<float>(std::move(expected)),
+        phylanx::execution_tree::extract_float32_value(result));
+
+    // single precision data is transparently widened for other primitives
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(m),
+        phylanx::execution_tree::extract_numeric_value(result));
+}
+
+void test_mixed_dot_1d1d()
+{
+    blaze::DynamicVector<double> v1{1.0, 2.0, 3.0};
+    blaze::DynamicVector<double> v2{4.0, 5.0, 6.0};
+
+    phylanx::execution_tree::primitive_result_type result = dot(
+        float32(phylanx::ir::node_data<double>(v1)),
+        phylanx::ir::node_data<double>(v2));
+
+    HPX_TEST(!phylanx::execution_tree::is_float32_value(result));
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(32.0),
+        phylanx::execution_tree::extract_numeric_value(result));
+}
+
+void test_mixed_dot_2d1d()
+{
+    blaze::DynamicMatrix<double> m{{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}};
+    blaze::DynamicVector<double> v{1.0, 0.0, 2.0};
+
+    phylanx::execution_tree::primitive_result_type result = dot(
+        float32(phylanx::ir::node_data<double>(m)),
+        float32(phylanx::ir::node_data<double>(v)));
+
+    blaze::DynamicVector<double> expected = m * v;
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        phylanx::execution_tree::extract_numeric_value(result));
+}
+
+void test_mixed_dot_2d2d()
+{
+    blaze::Rand<blaze::DynamicMatrix<double>> gen{};
+    blaze::DynamicMatrix<double> m1 = gen.generate(17, 13);
+    blaze::DynamicMatrix<double> m2 = gen.generate(13, 11);
+
+    phylanx::execution_tree::primitive_result_type result = dot(
+        float32(phylanx::ir::node_data<double>(m1)),
+        float32(phylanx::ir::node_data<double>(m2)));
+
+    // compare against the product of the values rounded to single precision
+    blaze::DynamicMatrix<double> r1(blaze::DynamicMatrix<float>(m1));
+    blaze::DynamicMatrix<double> r2(blaze::DynamicMatrix<float>(m2));
+    blaze::DynamicMatrix<double> expected = r1 * r2;
+
+    phylanx::ir::node_data<double> value =
+        phylanx::execution_tree::extract_numeric_value(result);
+    blaze::DynamicMatrix<double> const& actual = value.matrix();
+
+    HPX_TEST_EQ(expected.rows(), actual.rows());
+    HPX_TEST_EQ(expected.columns(), actual.columns());
+    HPX_TEST(blaze::max(blaze::abs(expected - actual)) < 1e-10);
+}
+
+// operands spanning several tiles of the mixed precision kernels
+void test_mixed_dot_tiled()
+{
+    blaze::Rand<blaze::DynamicMatrix<double>> gen{};
+    blaze::DynamicMatrix<double> m1 = gen.generate(300, 260);
+    blaze::DynamicMatrix<double> m2 = gen.generate(260, 150);
+
+    blaze::Rand<blaze::DynamicVector<double>> vgen{};
+    blaze::DynamicVector<double> v1 = vgen.generate(300);
+    blaze::DynamicVector<double> v2 = vgen.generate(260);
+
+    // only the single precision operands are rounded
+    blaze::DynamicMatrix<double> r1(blaze::DynamicMatrix<float>(m1));
+    blaze::DynamicVector<double> r2(blaze::DynamicVector<float>(v2));
+
+    using phylanx::ir::node_data;
+
+    node_data<double> mm = phylanx::execution_tree::extract_numeric_value(
+        dot(float32(node_data<double>(m1)), node_data<double>(m2)));
+    blaze::DynamicMatrix<double> expected_mm = r1 * m2;
+    HPX_TEST(blaze::max(blaze::abs(expected_mm - mm.matrix())) < 1e-10);
+
+    node_data<double> mv = phylanx::execution_tree::extract_numeric_value(
+        dot(float32(node_data<double>(m1)), float32(node_data<double>(v2))));
+    blaze::DynamicVector<double> expected_mv = r1 * r2;
+    HPX_TEST(blaze::max(blaze::abs(expected_mv - mv.vector())) < 1e-10);
+
+    node_data<double> vm = phylanx::execution_tree::extract_numeric_value(
+        dot(node_data<double>(v1), float32(node_data<double>(m1))));
+    blaze::DynamicVector<double> expected_vm =
+        blaze::trans(blaze::trans(v1) * r1);
+    HPX_TEST(blaze::max(blaze::abs(expected_vm - vm.vector())) < 1e-10);
+
+    node_data<double> vv = phylanx::execution_tree::extract_numeric_value(
+        dot(float32(node_data<double>(v2)), node_data<double>(v2)));
+    HPX_TEST(std::abs(blaze::dot(r2, v2) - vv.scalar()) < 1e-10);
+}
+
+// comparisons of single precision data give the same results as the
+// comparisons of the widened data
+template <typename Primitive>
+void test_float32_comparison(blaze::DynamicVector<double> const& v1,
+    blaze::DynamicVector<double> const& v2)
+{
+    using phylanx::ir::node_data;
+
+    bool expected =
+        compare<Primitive>(node_data<double>(v1), node_data<double>(v2));
+
+    HPX_TEST_EQ(expected, compare<Primitive>(
+        float32(node_data<double>(v1)), float32(node_data<double>(v2))));
+    HPX_TEST_EQ(expected, compare<Primitive>(
+        float32(node_data<double>(v1)), node_data<double>(v2)));
+    HPX_TEST_EQ(expected, compare<Primitive>(
+        node_data<double>(v1), float32(node_data<double>(v2))));
+}
+
+void test_float32_comparisons()
+{
+    using namespace phylanx::execution_tree::primitives;
+
+    blaze::DynamicVector<double> v1{1.0, 2.0, 3.0};
+    blaze::DynamicVector<double> v2{1.0, 3.0, 2.0};
+
+    test_float32_comparison<equal>(v1, v1);
+    test_float32_comparison<equal>(v1, v2);
+    test_float32_comparison<not_equal>(v1, v1);
+    test_float32_comparison<not_equal>(v1, v2);
+    test_float32_comparison<less>(v1, v2);
+    test_float32_comparison<less>(v1, v1);
+    test_float32_comparison<less_equal>(v2, v1);
+    test_float32_comparison<greater>(v1, v2);
+    test_float32_comparison<greater>(v1, v1);
+    test_float32_comparison<greater_equal>(v2, v1);
+
+    // scalars can be compared with integers
+    HPX_TEST(compare<less>(
+        float32(phylanx::ir::node_data<double>(1.0)), std::int64_t(2)));
+    HPX_TEST(compare<greater>(
+        std::int64_t(2), float32(phylanx::ir::node_data<double>(1.0))));
+}
+
+int main(int argc, char* argv[])
+{
+    test_float32_conversion();
+    test_mixed_dot_1d1d();
+    test_mixed_dot_2d1d();
+    test_mixed_dot_2d2d();
+    test_mixed_dot_tiled();
+    test_float32_comparisons();
+
+    return hpx::util::report_errors();
+}
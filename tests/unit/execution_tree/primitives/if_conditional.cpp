@@ -253,6 +253,36 @@ void test_if_conditional_t6()
     HPX_TEST(!phylanx::execution_tree::valid(f.get()));
 }
 
+// Test 7
+//  test synchronous evaluation of a nested expression
+void test_if_conditional_direct()
+{
+    phylanx::execution_tree::primitive cond =
+        hpx::new_<phylanx::execution_tree::primitives::less>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                phylanx::ir::node_data<double>(1.0),
+                phylanx::ir::node_data<double>(2.0)});
+
+    phylanx::execution_tree::primitive true_case =
+        hpx::new_<phylanx::execution_tree::primitives::add_operation>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                phylanx::ir::node_data<double>(40.0),
+                phylanx::ir::node_data<double>(2.0)});
+
+    phylanx::execution_tree::primitive if_prim =
+        hpx::new_<phylanx::execution_tree::primitives::if_conditional>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                std::move(cond), std::move(true_case),
+                phylanx::ir::node_data<double>(0.0)});
+
+    HPX_TEST_EQ(42.0,
+        phylanx::execution_tree::extract_numeric_value(
+            if_prim.eval_direct())[0]);
+}
+
 int main(int argc, char* argv[])
 {
     test_if_conditional_t1();
@@ -261,6 +291,7 @@ int main(int argc, char* argv[])
     test_if_conditional_t4();
     test_if_conditional_t5();
     test_if_conditional_t6();
+    test_if_conditional_direct();
 
     return hpx::util::report_errors();
 }
@@ -0,0 +1,80 @@
+//   Copyright (c) 2017 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+phylanx::execution_tree::primitive_result_type kron(
+    phylanx::ir::node_data<double>&& lhs, phylanx::ir::node_data<double>&& rhs)
+{
+    phylanx::execution_tree::primitive kron =
+        hpx::new_<phylanx::execution_tree::primitives::kron_operation>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                std::move(lhs), std::move(rhs)
+            });
+
+    return kron.eval().get();
+}
+
+void test_kron_operation_1d()
+{
+    blaze::DynamicVector<double> v1{1.0, 2.0};
+    blaze::DynamicVector<double> v2{3.0, 4.0, 5.0};
+
+    blaze::DynamicVector<double> expected{3.0, 4.0, 5.0, 6.0, 8.0, 10.0};
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        phylanx::execution_tree::extract_numeric_value(
+            kron(phylanx::ir::node_data<double>(v1),
+                phylanx::ir::node_data<double>(v2))));
+}
+
+void test_kron_operation_2d()
+{
+    blaze::DynamicMatrix<double> m1{{1.0, 2.0}, {3.0, 4.0}};
+    blaze::DynamicMatrix<double> m2{{0.0, 5.0}, {6.0, 7.0}};
+
+    blaze::DynamicMatrix<double> expected{
+        {0.0, 5.0, 0.0, 10.0},
+        {6.0, 7.0, 12.0, 14.0},
+        {0.0, 15.0, 0.0, 20.0},
+        {18.0, 21.0, 24.0, 28.0}};
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        phylanx::execution_tree::extract_numeric_value(
+            kron(phylanx::ir::node_data<double>(m1),
+                phylanx::ir::node_data<double>(m2))));
+}
+
+void test_kron_operation_1d2d()
+{
+    blaze::DynamicVector<double> v{1.0, 2.0};
+    blaze::DynamicMatrix<double> m{{1.0, 2.0}, {3.0, 4.0}};
+
+    blaze::DynamicMatrix<double> expected{
+        {1.0, 2.0, 2.0, 4.0},
+        {3.0, 4.0, 6.0, 8.0}};
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        phylanx::execution_tree::extract_numeric_value(
+            kron(phylanx::ir::node_data<double>(v),
+                phylanx::ir::node_data<double>(m))));
+}
+
+int main(int argc, char* argv[])
+{
+    test_kron_operation_1d();
+    test_kron_operation_2d();
+    test_kron_operation_1d2d();
+
+    return hpx::util::report_errors();
+}
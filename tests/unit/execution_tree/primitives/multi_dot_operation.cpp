@@ -0,0 +1,101 @@
+//   Copyright (c) 2017 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+phylanx::execution_tree::primitive_result_type multi_dot(
+    std::vector<phylanx::execution_tree::primitive_argument_type>&& operands)
+{
+    phylanx::execution_tree::primitive multi_dot =
+        hpx::new_<phylanx::execution_tree::primitives::multi_dot_operation>(
+            hpx::find_here(), std::move(operands));
+
+    return multi_dot.eval().get();
+}
+
+bool almost_equal(blaze::DynamicMatrix<double> const& lhs,
+    blaze::DynamicMatrix<double> const& rhs)
+{
+    return lhs.rows() == rhs.rows() && lhs.columns() == rhs.columns() &&
+        blaze::max(blaze::abs(lhs - rhs)) < 1e-10;
+}
+
+void test_multi_dot_matrices()
+{
+    blaze::Rand<blaze::DynamicMatrix<double>> gen{};
+    blaze::DynamicMatrix<double> a = gen.generate(10, 30);
+    blaze::DynamicMatrix<double> b = gen.generate(30, 5);
+    blaze::DynamicMatrix<double> c = gen.generate(5, 60);
+
+    blaze::DynamicMatrix<double> expected = (a * b) * c;
+
+    auto result = multi_dot({phylanx::ir::node_data<double>(a),
+        phylanx::ir::node_data<double>(b), phylanx::ir::node_data<double>(c)});
+
+    HPX_TEST(almost_equal(expected,
+        phylanx::execution_tree::extract_numeric_value(result).matrix()));
+}
+
+void test_multi_dot_matrix_vector()
+{
+    blaze::Rand<blaze::DynamicMatrix<double>> gen{};
+    blaze::DynamicMatrix<double> a = gen.generate(20, 20);
+    blaze::DynamicMatrix<double> b = gen.generate(20, 20);
+    blaze::DynamicVector<double> v(20, 1.0);
+
+    blaze::DynamicVector<double> expected = a * (b * v);
+
+    auto result = multi_dot({phylanx::ir::node_data<double>(a),
+        phylanx::ir::node_data<double>(b), phylanx::ir::node_data<double>(v)});
+
+    blaze::DynamicVector<double> const& actual =
+        phylanx::execution_tree::extract_numeric_value(result).vector();
+
+    HPX_TEST_EQ(expected.size(), actual.size());
+    HPX_TEST(blaze::max(blaze::abs(expected - actual)) < 1e-10);
+}
+
+void test_multi_dot_vector_matrix_vector()
+{
+    blaze::DynamicVector<double> v1{1.0, 2.0};
+    blaze::DynamicMatrix<double> m{{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}};
+    blaze::DynamicVector<double> v2{1.0, 0.0, 1.0};
+
+    auto result = multi_dot({phylanx::ir::node_data<double>(v1),
+        phylanx::ir::node_data<double>(m), phylanx::ir::node_data<double>(v2)});
+
+    // v1 * m = [9, 12, 15], dot with v2 = 24
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(24.0),
+        phylanx::execution_tree::extract_numeric_value(result));
+}
+
+void test_multi_dot_scalars()
+{
+    auto result = multi_dot({phylanx::ir::node_data<double>(2.0),
+        phylanx::ir::node_data<double>(3.0),
+        phylanx::ir::node_data<double>(7.0)});
+
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(42.0),
+        phylanx::execution_tree::extract_numeric_value(result));
+}
+
+int main(int argc, char* argv[])
+{
+    test_multi_dot_matrices();
+    test_multi_dot_matrix_vector();
+    test_multi_dot_vector_matrix_vector();
+    test_multi_dot_scalars();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,69 @@
+//   Copyright (c) 2017 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+void test_outer_operation_1d()
+{
+    blaze::DynamicVector<double> v1{1.0, 2.0, 3.0};
+    blaze::DynamicVector<double> v2{4.0, 5.0};
+
+    phylanx::execution_tree::primitive lhs =
+        hpx::new_<phylanx::execution_tree::primitives::variable>(
+            hpx::find_here(), phylanx::ir::node_data<double>(v1));
+
+    phylanx::execution_tree::primitive outer =
+        hpx::new_<phylanx::execution_tree::primitives::outer_operation>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                std::move(lhs), phylanx::ir::node_data<double>(v2)
+            });
+
+    hpx::future<phylanx::execution_tree::primitive_result_type> f =
+        outer.eval();
+
+    blaze::DynamicMatrix<double> expected{
+        {4.0, 5.0}, {8.0, 10.0}, {12.0, 15.0}};
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        phylanx::execution_tree::extract_numeric_value(f.get()));
+}
+
+void test_outer_operation_0d()
+{
+    blaze::DynamicVector<double> v{1.0, 2.0, 3.0};
+
+    phylanx::execution_tree::primitive outer =
+        hpx::new_<phylanx::execution_tree::primitives::outer_operation>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                phylanx::ir::node_data<double>(2.0),
+                phylanx::ir::node_data<double>(v)
+            });
+
+    hpx::future<phylanx::execution_tree::primitive_result_type> f =
+        outer.eval();
+
+    blaze::DynamicVector<double> expected{2.0, 4.0, 6.0};
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        phylanx::execution_tree::extract_numeric_value(f.get()));
+}
+
+int main(int argc, char* argv[])
+{
+    test_outer_operation_0d();
+    test_outer_operation_1d();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,106 @@
+//   Copyright (c) 2017 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <vector>
+
+std::vector<phylanx::execution_tree::primitive_argument_type> compile_and_run(
+    char const* expr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto f = phylanx::execution_tree::compile(expr, snippets);
+
+    return phylanx::execution_tree::extract_list_value(f());
+}
+
+void test_parallel_for()
+{
+    auto result = compile_and_run(R"(
+        block(
+            define(v, 2.0),
+            parallel_for(i, 0, 100, i * v)
+        )
+    )");
+
+    HPX_TEST_EQ(result.size(), std::size_t(100));
+    for (std::size_t i = 0; i != result.size(); ++i)
+    {
+        HPX_TEST_EQ(2.0 * i,
+            phylanx::execution_tree::extract_numeric_value(result[i])[0]);
+    }
+
+    // empty iteration space
+    HPX_TEST(compile_and_run("parallel_for(i, 10, 0, i)").empty());
+}
+
+void test_parallel_for_function()
+{
+    // the loop body refers to the arguments of the enclosing function
+    auto result = compile_and_run(R"(
+        block(
+            define(scale, v, w, parallel_for(i, 0, 10, i * v + w)),
+            scale(3.0, 1.0)
+        )
+    )");
+
+    HPX_TEST_EQ(result.size(), std::size_t(10));
+    for (std::size_t i = 0; i != result.size(); ++i)
+    {
+        HPX_TEST_EQ(3.0 * i + 1.0,
+            phylanx::execution_tree::extract_numeric_value(result[i])[0]);
+    }
+
+    // nested loops see the loop variables of the enclosing loops
+    result = compile_and_run(R"(
+        block(
+            define(table, n, parallel_for(i, 0, n,
+                parallel_for(j, 0, n, i * n + j + 0.5))),
+            table(4)
+        )
+    )");
+
+    HPX_TEST_EQ(result.size(), std::size_t(4));
+    for (std::size_t i = 0; i != result.size(); ++i)
+    {
+        auto row = phylanx::execution_tree::extract_list_value(result[i]);
+        HPX_TEST_EQ(row.size(), std::size_t(4));
+        for (std::size_t j = 0; j != row.size(); ++j)
+        {
+            HPX_TEST_EQ(4.0 * i + j + 0.5,
+                phylanx::execution_tree::extract_numeric_value(row[j])[0]);
+        }
+    }
+}
+
+void test_map()
+{
+    auto result = compile_and_run(R"(
+        block(
+            define(square, x, x * x),
+            map(square, parallel_for(i, 0, 10, i + 1.0))
+        )
+    )");
+
+    HPX_TEST_EQ(result.size(), std::size_t(10));
+    for (std::size_t i = 0; i != result.size(); ++i)
+    {
+        HPX_TEST_EQ(double((i + 1) * (i + 1)),
+            phylanx::execution_tree::extract_numeric_value(result[i])[0]);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    test_parallel_for();
+    test_parallel_for_function();
+    test_map();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,135 @@
+//   Copyright (c) 2017 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+std::vector<phylanx::execution_tree::primitive_argument_type> randomized_svd(
+    std::vector<phylanx::execution_tree::primitive_argument_type>&& operands)
+{
+    phylanx::execution_tree::primitive svd =
+        hpx::new_<phylanx::execution_tree::primitives::randomized_svd>(
+            hpx::find_here(), std::move(operands));
+
+    return phylanx::execution_tree::extract_list_value(svd.eval().get());
+}
+
+void test_randomized_svd_low_rank()
+{
+    // construct a matrix of exact rank 3
+    blaze::Rand<blaze::DynamicMatrix<double>> gen{};
+    blaze::DynamicMatrix<double> x = gen.generate(40, 3);
+    blaze::DynamicMatrix<double> y = gen.generate(3, 25);
+    blaze::DynamicMatrix<double> a = x * y;
+
+    auto result = randomized_svd({
+        phylanx::ir::node_data<double>(a), std::int64_t(3),
+        std::int64_t(5), std::int64_t(1)});
+
+    HPX_TEST_EQ(result.size(), std::size_t(3));
+
+    blaze::DynamicMatrix<double> u =
+        phylanx::execution_tree::extract_numeric_value(result[0]).matrix();
+    blaze::DynamicVector<double> s =
+        phylanx::execution_tree::extract_numeric_value(result[1]).vector();
+    blaze::DynamicMatrix<double> vt =
+        phylanx::execution_tree::extract_numeric_value(result[2]).matrix();
+
+    HPX_TEST_EQ(u.rows(), std::size_t(40));
+    HPX_TEST_EQ(u.columns(), std::size_t(3));
+    HPX_TEST_EQ(s.size(), std::size_t(3));
+    HPX_TEST_EQ(vt.rows(), std::size_t(3));
+    HPX_TEST_EQ(vt.columns(), std::size_t(25));
+
+    HPX_TEST(s[0] >= s[1] && s[1] >= s[2] && s[2] > 0.0);
+
+    // the singular vectors are orthonormal
+    blaze::DynamicMatrix<double> utu = blaze::trans(u) * u;
+    blaze::DynamicMatrix<double> vvt = vt * blaze::trans(vt);
+    for (std::size_t i = 0; i != 3; ++i)
+    {
+        for (std::size_t j = 0; j != 3; ++j)
+        {
+            double expected = (i == j) ? 1.0 : 0.0;
+            HPX_TEST(std::abs(utu(i, j) - expected) < 1e-10);
+            HPX_TEST(std::abs(vvt(i, j) - expected) < 1e-10);
+        }
+    }
+
+    // the rank 3 matrix is reconstructed exactly
+    blaze::DynamicMatrix<double> us = u;
+    for (std::size_t j = 0; j != 3; ++j)
+    {
+        blaze::column(us, j) *= s[j];
+    }
+    blaze::DynamicMatrix<double> reconstructed = us * vt;
+    HPX_TEST(blaze::max(blaze::abs(reconstructed - a)) < 1e-8);
+}
+
+void test_randomized_svd_diagonal()
+{
+    blaze::DynamicMatrix<double> a(6, 5, 0.0);
+    a(0, 0) = 1.0;
+    a(1, 1) = 7.0;
+    a(2, 2) = 3.0;
+    a(3, 3) = 5.0;
+    a(4, 4) = 2.0;
+
+    // default oversampling and power iterations
+    auto result = randomized_svd({
+        phylanx::ir::node_data<double>(a), std::int64_t(2)});
+
+    blaze::DynamicVector<double> s =
+        phylanx::execution_tree::extract_numeric_value(result[1]).vector();
+
+    HPX_TEST_EQ(s.size(), std::size_t(2));
+    HPX_TEST(std::abs(s[0] - 7.0) < 1e-10);
+    HPX_TEST(std::abs(s[1] - 5.0) < 1e-10);
+}
+
+// the samples are drawn from the generator used by random(), seeding it
+// makes the results reproducible
+void test_randomized_svd_seed()
+{
+    blaze::Rand<blaze::DynamicMatrix<double>> gen{};
+    blaze::DynamicMatrix<double> a = gen.generate(30, 20);
+
+    phylanx::execution_tree::primitives::set_random_seed(42);
+    auto result1 = randomized_svd({
+        phylanx::ir::node_data<double>(a), std::int64_t(4),
+        std::int64_t(2), std::int64_t(0)});
+
+    phylanx::execution_tree::primitives::set_random_seed(42);
+    auto result2 = randomized_svd({
+        phylanx::ir::node_data<double>(a), std::int64_t(4),
+        std::int64_t(2), std::int64_t(0)});
+
+    for (std::size_t i = 0; i != 3; ++i)
+    {
+        HPX_TEST_EQ(
+            phylanx::execution_tree::extract_numeric_value(result1[i]),
+            phylanx::execution_tree::extract_numeric_value(result2[i]));
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    test_randomized_svd_low_rank();
+    test_randomized_svd_diagonal();
+    test_randomized_svd_seed();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,162 @@
+//   Copyright (c) 2017 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::ir::node_data<double> eval_ranked(std::string const& name,
+    std::size_t lhs_rank, std::size_t rhs_rank,
+    phylanx::ir::node_data<double> lhs, phylanx::ir::node_data<double> rhs)
+{
+    phylanx::execution_tree::primitive op =
+        hpx::new_<phylanx::execution_tree::primitives::ranked_operation>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                std::move(lhs), std::move(rhs)},
+            name, lhs_rank, rhs_rank);
+
+    return phylanx::execution_tree::extract_numeric_value(op.eval().get());
+}
+
+void test_elementwise()
+{
+    blaze::Rand<blaze::DynamicVector<double>> gen_vector{};
+    blaze::DynamicVector<double> v1 = gen_vector.generate(42UL);
+    blaze::DynamicVector<double> v2 = gen_vector.generate(42UL);
+
+    blaze::Rand<blaze::DynamicMatrix<double>> gen_matrix{};
+    blaze::DynamicMatrix<double> m1 = gen_matrix.generate(42UL, 42UL);
+    blaze::DynamicMatrix<double> m2 = gen_matrix.generate(42UL, 42UL);
+
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(42.0),
+        eval_ranked("add", 0, 0, phylanx::ir::node_data<double>(41.0),
+            phylanx::ir::node_data<double>(1.0)));
+
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(
+                    blaze::DynamicVector<double>(v1 + v2)),
+        eval_ranked("add", 1, 1, phylanx::ir::node_data<double>(v1),
+            phylanx::ir::node_data<double>(v2)));
+
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(
+                    blaze::DynamicVector<double>(
+                        blaze::map(v1, [](double x) { return 2.0 - x; }))),
+        eval_ranked("sub", 0, 1, phylanx::ir::node_data<double>(2.0),
+            phylanx::ir::node_data<double>(v1)));
+
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(
+                    blaze::DynamicMatrix<double>(m1 / 2.0)),
+        eval_ranked("div", 2, 0, phylanx::ir::node_data<double>(m1),
+            phylanx::ir::node_data<double>(2.0)));
+
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(
+                    blaze::DynamicVector<double>(v1 * v2)),
+        eval_ranked("mul", 1, 1, phylanx::ir::node_data<double>(v1),
+            phylanx::ir::node_data<double>(v2)));
+
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(
+                    blaze::DynamicMatrix<double>(m1 - m2)),
+        eval_ranked("sub", 2, 2, phylanx::ir::node_data<double>(m1),
+            phylanx::ir::node_data<double>(m2)));
+}
+
+void test_products()
+{
+    blaze::Rand<blaze::DynamicVector<double>> gen_vector{};
+    blaze::DynamicVector<double> v = gen_vector.generate(42UL);
+
+    blaze::Rand<blaze::DynamicMatrix<double>> gen_matrix{};
+    blaze::DynamicMatrix<double> m1 = gen_matrix.generate(42UL, 42UL);
+    blaze::DynamicMatrix<double> m2 = gen_matrix.generate(42UL, 42UL);
+
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(blaze::dot(v, v)),
+        eval_ranked("dot", 1, 1, phylanx::ir::node_data<double>(v),
+            phylanx::ir::node_data<double>(v)));
+
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(
+                    blaze::DynamicVector<double>(m1 * v)),
+        eval_ranked("dot", 2, 1, phylanx::ir::node_data<double>(m1),
+            phylanx::ir::node_data<double>(v)));
+
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(blaze::DynamicVector<double>(
+                    blaze::trans(blaze::trans(v) * m1))),
+        eval_ranked("mul", 1, 2, phylanx::ir::node_data<double>(v),
+            phylanx::ir::node_data<double>(m1)));
+
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(
+                    blaze::DynamicMatrix<double>(m1 * m2)),
+        eval_ranked("mul", 2, 2, phylanx::ir::node_data<double>(m1),
+            phylanx::ir::node_data<double>(m2)));
+}
+
+void test_other_ranks()
+{
+    // operands of ranks different from the ones given on construction
+    // are handled as well
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(42.0),
+        eval_ranked("add", 1, 1, phylanx::ir::node_data<double>(41.0),
+            phylanx::ir::node_data<double>(1.0)));
+
+    HPX_TEST(!phylanx::execution_tree::primitives::ranked_operation::
+        is_supported("dot", 0, 1));
+    HPX_TEST(!phylanx::execution_tree::primitives::ranked_operation::
+        is_supported("add", 1, 2));
+    HPX_TEST(phylanx::execution_tree::primitives::ranked_operation::
+        is_supported("mul", 2, 1));
+
+    bool caught_exception = false;
+    try
+    {
+        eval_ranked("add", 1, 1,
+            phylanx::ir::node_data<double>(blaze::DynamicVector<double>(3)),
+            phylanx::ir::node_data<double>(
+                blaze::DynamicMatrix<double>(3, 3)));
+    }
+    catch (hpx::exception const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+void test_compiled()
+{
+    // the ranks of x and y are known, x * x - y is evaluated using
+    // specialized kernels
+    char const* const exprstr = R"(
+        block(
+            define(x, constant(2.0, 3)),
+            define(y, constant(1.0, 3)),
+            x * x - y
+        )
+    )";
+
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto f = phylanx::execution_tree::compile(exprstr, snippets);
+
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(
+                    blaze::DynamicVector<double>(3, 3.0)),
+        phylanx::execution_tree::extract_numeric_value(f()));
+}
+
+int main(int argc, char* argv[])
+{
+    test_elementwise();
+    test_products();
+    test_other_ranks();
+    test_compiled();
+
+    return hpx::util::report_errors();
+}
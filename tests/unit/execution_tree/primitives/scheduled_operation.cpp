@@ -0,0 +1,188 @@
+//   Copyright (c) 2017 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+double compile_and_run(char const* expr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto f = phylanx::execution_tree::compile(expr, snippets);
+
+    return phylanx::execution_tree::extract_numeric_value(f())[0];
+}
+
+void test_scheduled_operation()
+{
+    HPX_TEST_EQ(42.0, compile_and_run(R"(
+        block(
+            define(x, 21.0),
+            schedule(x * 2.0)
+        )
+    )"));
+
+    HPX_TEST_EQ(42.0, compile_and_run(R"(
+        block(
+            define(x, 21.0),
+            schedule(x + x, "high")
+        )
+    )"));
+
+    HPX_TEST_EQ(9.0, compile_and_run(R"(
+        block(
+            define(x, 3.0),
+            schedule(dot(x, x), "low", "default", "large")
+        )
+    )"));
+
+    // empty strings select the default hints
+    HPX_TEST_EQ(1.0, compile_and_run(R"(schedule(1.0, "", "", ""))"));
+}
+
+void test_scheduled_operation_direct()
+{
+    phylanx::execution_tree::primitive lhs =
+        hpx::new_<phylanx::execution_tree::primitives::variable>(
+            hpx::find_here(), phylanx::ir::node_data<double>(41.0));
+
+    phylanx::execution_tree::primitive add =
+        hpx::new_<phylanx::execution_tree::primitives::add_operation>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                std::move(lhs), phylanx::ir::node_data<double>(1.0)});
+
+    phylanx::execution_tree::primitive scheduled =
+        hpx::new_<phylanx::execution_tree::primitives::scheduled_operation>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                std::move(add), std::string("boost"), std::string(""),
+                std::string("medium")});
+
+    HPX_TEST_EQ(42.0,
+        phylanx::execution_tree::extract_numeric_value(
+            scheduled.eval().get())[0]);
+    HPX_TEST_EQ(42.0,
+        phylanx::execution_tree::extract_numeric_value(
+            scheduled.eval_direct())[0]);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// probe(x): returns x, records the properties of the thread it was evaluated
+// on
+hpx::threads::thread_priority probed_priority =
+    hpx::threads::thread_priority_unknown;
+std::string probed_pool;
+std::size_t probed_stacksize = 0;
+
+class probe_operation
+  : public phylanx::execution_tree::primitives::base_primitive
+  , public hpx::components::component_base<probe_operation>
+{
+public:
+    probe_operation() = default;
+
+    probe_operation(
+            std::vector<phylanx::execution_tree::primitive_argument_type>&&
+                operands)
+      : base_primitive(std::move(operands))
+    {}
+
+    hpx::future<phylanx::execution_tree::primitive_result_type> eval(
+        std::vector<phylanx::execution_tree::primitive_argument_type> const&
+            args) const override
+    {
+        return hpx::make_ready_future(eval_direct(args));
+    }
+
+    phylanx::execution_tree::primitive_result_type eval_direct(
+        std::vector<phylanx::execution_tree::primitive_argument_type> const&
+            args) const override
+    {
+        probed_priority = hpx::this_thread::get_priority();
+        probed_pool = hpx::this_thread::get_pool()->get_pool_name();
+        probed_stacksize = hpx::threads::get_self_stacksize();
+
+        return phylanx::execution_tree::value_operand_sync(operands_[0], args);
+    }
+};
+
+typedef hpx::components::component<probe_operation> probe_operation_type;
+HPX_REGISTER_DERIVED_COMPONENT_FACTORY(probe_operation_type,
+    phylanx_probe_operation_component, "phylanx_primitive_component",
+    hpx::components::factory_enabled)
+HPX_DEFINE_GET_COMPONENT_TYPE(probe_operation_type::wrapped_type)
+
+void test_scheduling_hints()
+{
+    phylanx::execution_tree::register_patterns({
+        hpx::util::make_tuple("probe", "probe(_1)",
+            &phylanx::execution_tree::create<probe_operation>)
+    });
+
+    char const* exprstr = R"(
+        block(
+            define(x, 21.0),
+            schedule(probe(x) * 2.0, "high", "default", "large")
+        )
+    )";
+
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto f = phylanx::execution_tree::compile(exprstr, snippets);
+
+    // the hints apply to the thread evaluating the expression, both when
+    // invoked directly and asynchronously
+    HPX_TEST_EQ(42.0, phylanx::execution_tree::extract_numeric_value(f())[0]);
+    HPX_TEST_EQ(probed_priority, hpx::threads::thread_priority_high);
+    HPX_TEST_EQ(probed_pool, std::string("default"));
+    HPX_TEST_EQ(probed_stacksize,
+        hpx::threads::get_stack_size(hpx::threads::thread_stacksize_large));
+
+    probed_priority = hpx::threads::thread_priority_unknown;
+    probed_pool.clear();
+    probed_stacksize = 0;
+
+    HPX_TEST_EQ(42.0,
+        phylanx::execution_tree::extract_numeric_value(
+            f.eval(phylanx::execution_tree::compiler::arguments_type{}).get()
+        )[0]);
+    HPX_TEST_EQ(probed_priority, hpx::threads::thread_priority_high);
+    HPX_TEST_EQ(probed_pool, std::string("default"));
+    HPX_TEST_EQ(probed_stacksize,
+        hpx::threads::get_stack_size(hpx::threads::thread_stacksize_large));
+}
+
+void test_invalid_hints()
+{
+    bool caught_exception = false;
+    try
+    {
+        compile_and_run(R"(schedule(1.0, "urgent"))");
+    }
+    catch (hpx::exception const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+int main(int argc, char* argv[])
+{
+    test_scheduled_operation();
+    test_scheduled_operation_direct();
+    test_scheduling_hints();
+    test_invalid_hints();
+
+    return hpx::util::report_errors();
+}
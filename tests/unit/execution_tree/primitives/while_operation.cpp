@@ -93,11 +93,61 @@ void test_while_operation_true_return()
     HPX_TEST(phylanx::execution_tree::extract_boolean_value(f.get()));
 }
 
+// condition is set to false in first iteration, evaluated synchronously
+void test_while_operation_true_direct()
+{
+    phylanx::execution_tree::primitive cond =
+        hpx::new_<phylanx::execution_tree::primitives::variable>(
+            hpx::find_here(), true);
+    phylanx::execution_tree::primitive store =
+        hpx::new_<phylanx::execution_tree::primitives::store_operation>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                cond, false
+            });
+    phylanx::execution_tree::primitive body =
+        hpx::new_<phylanx::execution_tree::primitives::block_operation>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                std::move(store), true
+            });
+
+    phylanx::execution_tree::primitive while_ =
+        hpx::new_<phylanx::execution_tree::primitives::while_operation>(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                std::move(cond), std::move(body)
+            });
+
+    HPX_TEST(phylanx::execution_tree::extract_boolean_value(
+        while_.eval_direct()));
+}
+
+// many iterations, all of which are executed in place
+void test_while_operation_many_iterations()
+{
+    char const* const code = R"(
+        block(
+            define(i, 0.0),
+            while(i < 100000.0, store(i, i + 1.0)),
+            i
+        )
+    )";
+
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto f = phylanx::execution_tree::compile(code, snippets);
+
+    HPX_TEST_EQ(100000.0,
+        phylanx::execution_tree::extract_numeric_value(f())[0]);
+}
+
 int main(int argc, char* argv[])
 {
     test_while_operation_false();
     test_while_operation_true();
     test_while_operation_true_return();
+    test_while_operation_true_direct();
+    test_while_operation_many_iterations();
 
     return hpx::util::report_errors();
 }
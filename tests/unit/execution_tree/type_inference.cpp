@@ -0,0 +1,167 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <string>
+
+using phylanx::execution_tree::compiler::inferred_type;
+using phylanx::execution_tree::compiler::type_map;
+
+///////////////////////////////////////////////////////////////////////////////
+inferred_type infer(std::string const& exprstr,
+    type_map const& variables = type_map{})
+{
+    auto patterns =
+        phylanx::execution_tree::get_all_known_expression_patterns();
+    phylanx::execution_tree::compiler::pattern_index index(*patterns);
+
+    phylanx::ast::expression expr = phylanx::ast::generate_ast(exprstr);
+    type_map types =
+        phylanx::execution_tree::compiler::infer_types(expr, index, variables);
+
+    return types[phylanx::ast::to_string(expr)];
+}
+
+bool infer_fails(std::string const& exprstr,
+    type_map const& variables = type_map{})
+{
+    try
+    {
+        infer(exprstr, variables);
+    }
+    catch (hpx::exception const&)
+    {
+        return true;
+    }
+    return false;
+}
+
+inferred_type vector(std::size_t size)
+{
+    return inferred_type(inferred_type::numeric, 1, size, 1);
+}
+
+inferred_type matrix(std::size_t rows, std::size_t columns)
+{
+    return inferred_type(inferred_type::numeric, 2, rows, columns);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_literals()
+{
+    HPX_TEST(inferred_type::scalar(inferred_type::numeric) == infer("1.0"));
+    HPX_TEST(inferred_type::scalar(inferred_type::integer) == infer("42"));
+    HPX_TEST(inferred_type::scalar(inferred_type::boolean) == infer("true"));
+    HPX_TEST_EQ(inferred_type::string, infer("\"text\"").kind);
+
+    HPX_TEST(inferred_type::scalar(inferred_type::numeric) == infer("1.0 + 2"));
+    HPX_TEST(inferred_type::scalar(inferred_type::boolean) ==
+        infer("1.0 < 2.0"));
+
+    HPX_TEST(vector(3) == infer("constant(0.0, 3)"));
+    HPX_TEST(vector(3) == infer("constant(0.0, 3) * 2.0"));
+    HPX_TEST(vector(3) == infer("-exp(constant(0.0, 3))"));
+}
+
+void test_variables()
+{
+    type_map variables;
+    variables["A"] = matrix(2, 3);
+    variables["v"] = vector(3);
+
+    HPX_TEST(vector(2) == infer("dot(A, v)", variables));
+    HPX_TEST(vector(2) == infer("A * v", variables));
+    HPX_TEST(matrix(3, 2) == infer("transpose(A)", variables));
+    HPX_TEST(matrix(2, 2) == infer("A * transpose(A)", variables));
+    HPX_TEST(matrix(2, 3) == infer("A + 1.0", variables));
+    HPX_TEST(inferred_type::scalar(inferred_type::numeric) ==
+        infer("dot(v, v)", variables));
+
+    // the extents of variables can be unknown
+    variables["B"] = inferred_type(inferred_type::numeric, 2);
+    HPX_TEST(matrix(2, 3) == infer("A + B", variables));
+
+    // other variables are not known at all
+    HPX_TEST(!infer("A + C", variables).has_rank());
+}
+
+void test_definitions()
+{
+    HPX_TEST(vector(4) == infer(R"(
+        block(
+            define(x, constant(1.0, 4)),
+            x + x
+        ))"));
+
+    // variables modified by store() are not known
+    HPX_TEST(!infer(R"(
+        block(
+            define(x, 1.0),
+            store(x, constant(1.0, 4)),
+            x
+        ))").has_rank());
+
+    // the arguments of functions shadow other variables
+    type_map variables;
+    variables["x"] = matrix(2, 2);
+    HPX_TEST(!infer_fails(R"(
+        block(
+            define(f, x, x + constant(1.0, 3)),
+            f(1.0)
+        ))", variables));
+
+    // only the properties common to all branches are known
+    HPX_TEST(vector(3) ==
+        infer("if(true, constant(1.0, 3), constant(2.0, 3))"));
+    HPX_TEST(inferred_type(inferred_type::numeric, 1, 0, 1) ==
+        infer("if(true, constant(1.0, 3), constant(2.0, 4))"));
+}
+
+void test_mismatches()
+{
+    type_map variables;
+    variables["A"] = matrix(2, 3);
+    variables["v"] = vector(3);
+
+    HPX_TEST(infer_fails("constant(1.0, 3) + constant(1.0, 4)"));
+    HPX_TEST(infer_fails("A + v", variables));
+    HPX_TEST(infer_fails("A - transpose(A)", variables));
+    HPX_TEST(infer_fails("v * A", variables));
+    HPX_TEST(infer_fails("dot(A, A)", variables));
+    HPX_TEST(infer_fails("dot(1.0, v)", variables));
+
+    // mismatches are reported by the compiler before anything is evaluated
+    bool caught_exception = false;
+    try
+    {
+        phylanx::execution_tree::compiler::function_list snippets;
+        phylanx::execution_tree::compile(R"(
+            block(
+                define(a, constant(1.0, 3)),
+                define(b, constant(1.0, 2)),
+                a + b
+            ))", snippets);
+    }
+    catch (hpx::exception const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+int main(int argc, char* argv[])
+{
+    test_literals();
+    test_variables();
+    test_definitions();
+    test_mismatches();
+
+    return hpx::util::report_errors();
+}
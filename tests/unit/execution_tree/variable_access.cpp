@@ -0,0 +1,231 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<std::vector<std::size_t>> dependencies(std::string const& exprstr)
+{
+    phylanx::execution_tree::compiler::expression_pattern_list patterns =
+        phylanx::execution_tree::compiler::generate_patterns(
+            phylanx::execution_tree::get_all_known_patterns());
+
+    return phylanx::execution_tree::compiler::statement_dependencies(
+        phylanx::ast::generate_asts(exprstr), patterns);
+}
+
+void test_statement_dependencies()
+{
+    using deps_type = std::vector<std::vector<std::size_t>>;
+
+    HPX_TEST(dependencies(R"(
+            define(a, 1.0)
+            define(b, 2.0)
+            store(a, a + 10.0)
+            store(b, b * 3.0)
+            a + b
+        )") == deps_type({{}, {}, {0}, {1}, {0, 1, 2, 3}}));
+
+    // write after read
+    HPX_TEST(dependencies(R"(
+            define(b, a)
+            store(a, 1.0)
+        )") == deps_type({{}, {0}}));
+
+    // I/O and calls to user defined functions are executed in sequence
+    HPX_TEST(dependencies(R"(
+            define(a, 1.0)
+            cout(2.0)
+            define(b, 3.0)
+            f(b)
+        )") == deps_type({{}, {0}, {1}, {0, 1, 2}}));
+
+    // randomized algorithms don't return the same value when invoked twice
+    HPX_TEST(dependencies(R"(
+            define(a, randomized_svd(m, 2))
+            define(b, randomized_svd(m, 2))
+        )") == deps_type({{}, {0}}));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_dataflow_block(char const* exprstr, double expected)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto f = phylanx::execution_tree::compile(exprstr, snippets);
+
+    HPX_TEST_EQ(expected,
+        phylanx::execution_tree::extract_numeric_value(
+            f.eval(phylanx::execution_tree::compiler::arguments_type{}).get()
+        )[0]);
+    HPX_TEST_EQ(expected,
+        phylanx::execution_tree::extract_numeric_value(f())[0]);
+}
+
+void test_dataflow_blocks()
+{
+    test_dataflow_block(R"(
+        block(
+            define(a, 1.0),
+            define(b, 2.0),
+            store(a, a + 10.0),
+            store(b, b * 3.0),
+            a + b
+        )
+    )", 17.0);
+
+    test_dataflow_block(R"(
+        block(
+            define(a, 0.0),
+            define(b, 0.0),
+            define(i, 0.0),
+            define(j, 0.0),
+            while(i < 100.0, block(store(a, a + i), store(i, i + 1.0))),
+            while(j < 10.0, block(store(b, b + j), store(j, j + 1.0))),
+            a - b
+        )
+    )", 4905.0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// overlap(x): returns x after a short delay, records the largest number of
+// evaluations which were running at the same time
+std::atomic<int> active_overlaps(0);
+std::atomic<int> max_active_overlaps(0);
+
+class overlap_operation
+  : public phylanx::execution_tree::primitives::base_primitive
+  , public hpx::components::component_base<overlap_operation>
+{
+public:
+    overlap_operation() = default;
+
+    overlap_operation(
+            std::vector<phylanx::execution_tree::primitive_argument_type>&&
+                operands)
+      : base_primitive(std::move(operands))
+    {}
+
+    hpx::future<phylanx::execution_tree::primitive_result_type> eval(
+        std::vector<phylanx::execution_tree::primitive_argument_type> const&
+            args) const override
+    {
+        return hpx::make_ready_future(eval_direct(args));
+    }
+
+    phylanx::execution_tree::primitive_result_type eval_direct(
+        std::vector<phylanx::execution_tree::primitive_argument_type> const&
+            args) const override
+    {
+        int active = ++active_overlaps;
+        int max_active = max_active_overlaps.load();
+        while (active > max_active &&
+            !max_active_overlaps.compare_exchange_weak(max_active, active))
+        {
+        }
+
+        hpx::this_thread::sleep_for(std::chrono::milliseconds(100));
+        --active_overlaps;
+
+        return phylanx::execution_tree::value_operand_sync(operands_[0], args);
+    }
+};
+
+typedef hpx::components::component<overlap_operation> overlap_operation_type;
+HPX_REGISTER_DERIVED_COMPONENT_FACTORY(overlap_operation_type,
+    phylanx_overlap_operation_component, "phylanx_primitive_component",
+    hpx::components::factory_enabled)
+HPX_DEFINE_GET_COMPONENT_TYPE(overlap_operation_type::wrapped_type)
+
+void test_dataflow_block_concurrency()
+{
+    max_active_overlaps = 0;
+
+    // the two invocations of overlap() are independent of each other
+    char const* exprstr = R"(
+        block(
+            define(x, 1.0),
+            define(a, overlap(x)),
+            define(b, overlap(x)),
+            a + b
+        )
+    )";
+
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto f = phylanx::execution_tree::compile(exprstr, snippets);
+
+    // compiled code is invoked directly
+    HPX_TEST_EQ(2.0, phylanx::execution_tree::extract_numeric_value(f())[0]);
+    HPX_TEST_EQ(max_active_overlaps.load(), 2);
+
+    max_active_overlaps = 0;
+
+    auto g = phylanx::execution_tree::compile(exprstr, snippets);
+    HPX_TEST_EQ(2.0,
+        phylanx::execution_tree::extract_numeric_value(
+            g.eval(phylanx::execution_tree::compiler::arguments_type{}).get()
+        )[0]);
+    HPX_TEST_EQ(max_active_overlaps.load(), 2);
+}
+
+// the operands of a primitive are evaluated concurrently
+void test_operand_concurrency()
+{
+    max_active_overlaps = 0;
+
+    // the operands of overlap() are variables, which prevents evaluating
+    // its invocations at compile time
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto f = phylanx::execution_tree::compile(R"(
+        block(
+            define(x, 1.0),
+            define(y, 2.0),
+            overlap(x) + overlap(y)
+        )
+    )", snippets);
+
+    HPX_TEST_EQ(3.0, phylanx::execution_tree::extract_numeric_value(f())[0]);
+    HPX_TEST_EQ(max_active_overlaps.load(), 2);
+
+    max_active_overlaps = 0;
+
+    auto g = phylanx::execution_tree::compile(R"(
+        block(
+            define(x, 1.0),
+            define(y, 2.0),
+            overlap(x) < overlap(y)
+        )
+    )", snippets);
+
+    HPX_TEST(phylanx::execution_tree::extract_boolean_value(g()));
+    HPX_TEST_EQ(max_active_overlaps.load(), 2);
+}
+
+int main(int argc, char* argv[])
+{
+    phylanx::execution_tree::register_patterns({
+        hpx::util::make_tuple("overlap", "overlap(_1)",
+            &phylanx::execution_tree::create<overlap_operation>)
+    });
+
+    test_statement_dependencies();
+    test_dataflow_blocks();
+    test_dataflow_block_concurrency();
+    test_operand_concurrency();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,78 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+#include <phylanx/util/arena.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <string>
+#include <vector>
+
+char const* const code = R"(
+    define(fact, n,
+        if(n <= 1, 1, n * fact(n - 1))
+    )
+    define(x, '(1.0, "two", 3, true))
+    fact(10) + -x
+)";
+
+///////////////////////////////////////////////////////////////////////////////
+void test_arena_ast()
+{
+    std::vector<phylanx::ast::expression> expected =
+        phylanx::ast::generate_asts(code);
+
+    std::vector<phylanx::ast::expression> asts;
+    std::vector<phylanx::ast::expression> copies;
+    {
+        phylanx::util::arena arena(1024);
+        asts = phylanx::ast::generate_asts(code, arena);
+
+        HPX_TEST(arena.num_blocks() != 0);
+        HPX_TEST(asts == expected);
+
+        // copies made outside of an arena_scope are allocated from the heap
+        copies = asts;
+    }
+
+    // the nodes outlive the arena object
+    HPX_TEST(asts == expected);
+
+    asts.clear();
+    HPX_TEST(copies == expected);
+}
+
+void test_arena_scope()
+{
+    phylanx::util::arena outer;
+    phylanx::util::arena inner;
+
+    phylanx::ast::expression first;
+    phylanx::ast::expression second;
+    {
+        phylanx::util::arena_scope outer_scope(outer);
+        first = phylanx::ast::generate_ast("A + f(B, C)");
+        {
+            phylanx::util::arena_scope inner_scope(inner);
+            second = phylanx::ast::generate_ast("A + f(B, C)");
+        }
+        HPX_TEST(phylanx::ast::generate_ast("-A") ==
+            phylanx::ast::generate_ast("-A"));
+    }
+
+    HPX_TEST(outer.num_blocks() == 1);
+    HPX_TEST(inner.num_blocks() == 1);
+    HPX_TEST(first == second);
+}
+
+int main(int argc, char* argv[])
+{
+    test_arena_ast();
+    test_arena_scope();
+
+    return hpx::util::report_errors();
+}